@@ -27,6 +27,7 @@ public class Dojo : ModuleRules
             {
                 "CoreUObject",
                 "Engine",
+                "Json",
             }
         );
 
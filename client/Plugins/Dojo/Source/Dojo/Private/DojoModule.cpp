@@ -7,6 +7,7 @@
 //
 
 #include "DojoModule.h"
+#include "ToriiStandIn.h"
 #include <cstring>
 #include <string>
 #include <iomanip>
@@ -92,6 +93,12 @@ ToriiClient *FDojoModule::CreateToriiClient(const char *torii_url, const char *w
     UE_LOG(LogTemp, Log, TEXT("Torii URL: %hs"), torii_url);
     UE_LOG(LogTemp, Log, TEXT("World: %hs"), world_str);
 
+    // Offline benchmarks: serve a fixture in-process instead of talking to Torii
+    if (FToriiStandIn::IsStandInUrl(torii_url))
+    {
+        return FToriiStandIn::Create(torii_url);
+    }
+
     FieldElement world;
     FDojoModule::string_to_bytes(world_str, world.data, 32);
 
@@ -116,6 +123,10 @@ ResultPageEntity FDojoModule::GetEntities(ToriiClient *client, int limit, const
         return array;
     }
 
+    if (FToriiStandIn* standIn = FToriiStandIn::FromClient(client)) {
+        return standIn->Entities(nullptr, limit, cursor);
+    }
+
     UE_LOG(LogTemp, Log, TEXT("GetEntities: Setting up query"));
     Query query;
     memset(&query, 0, sizeof(query));
@@ -146,6 +157,61 @@ ResultPageEntity FDojoModule::GetEntities(ToriiClient *client, int limit, const
 
     return result;
 }
+
+ResultPageEntity FDojoModule::GetEntitiesByKeys(ToriiClient *client, const TArray<std::string> &keys, int limit, const char *cursor)
+{
+    if (client == nullptr) {
+        UE_LOG(LogTemp, Warning, TEXT("GetEntitiesByKeys: Client is null, returning empty result"));
+        ResultPageEntity array;
+        array.tag = OkPageEntity;
+        array.ok.items.data_len = 0;
+        return array;
+    }
+
+    if (FToriiStandIn* standIn = FToriiStandIn::FromClient(client)) {
+        return standIn->Entities(&keys, limit, cursor);
+    }
+
+    TArray<COptionFieldElement> keyOptions;
+    keyOptions.SetNumZeroed(keys.Num());
+    for (int i = 0; i < keys.Num(); i++) {
+        if (keys[i].empty()) {
+            keyOptions[i].tag = NoneFieldElement;
+        } else {
+            keyOptions[i].tag = SomeFieldElement;
+            FDojoModule::string_to_bytes(keys[i], keyOptions[i].some.data, 32);
+        }
+    }
+
+    Query query;
+    memset(&query, 0, sizeof(query));
+
+    query.pagination.cursor.tag = cursor == nullptr ? Nonec_char : Somec_char;
+    if (cursor) {
+        query.pagination.cursor.some = cursor;
+    }
+    query.pagination.limit.tag = Someu32;
+    query.pagination.limit.some = limit;
+
+    query.clause.tag = SomeClause;
+    query.clause.some.tag = Keys;
+    query.clause.some.keys.keys.data = keyOptions.GetData();
+    query.clause.some.keys.keys.data_len = keyOptions.Num();
+    query.clause.some.keys.pattern_matching = VariableLen;
+    query.clause.some.keys.models.data = nullptr;
+    query.clause.some.keys.models.data_len = 0;
+
+    // Latest state only, this is used to fill gaps, not to replay history
+    query.historical = false;
+
+    ResultPageEntity result = client_entities(client, query);
+    if (result.tag == OkPageEntity) {
+        UE_LOG(LogTemp, Log, TEXT("GetEntitiesByKeys: Query successful, returned %d entities"), result.ok.items.data_len);
+    } else {
+        UE_LOG(LogTemp, Error, TEXT("GetEntitiesByKeys: Query failed: %hs"), result.err.message);
+    }
+    return result;
+}
 //
 //void FDojoModule::ControllerGetAccountOrConnectMobile(const char* rpc_url, const char* chain_id, const struct Policy *policies, size_t nb_policies, ControllerAccountCallback callback, ControllerUrlCallback url_callback)
 //{
@@ -238,13 +304,8 @@ Account *FDojoModule::CreateBurner(const char* rpc_url, Account *master_account)
     return account;
 }
 
-void FDojoModule::ExecuteRaw(Account *account, const char *to, const char *selector, const TArray<std::string>& feltsStr)
+bool FDojoModule::ExecuteRaw(Account *account, const char *to, const char *selector, const TArray<std::string>& feltsStr, FieldElement *outTransactionHash)
 {
-    if (!account) {
-        UE_LOG(LogTemp, Error, TEXT("FDojoModule::ExecuteRaw - Account is null!"));
-        return;
-    }
-
     struct FieldElement actions;
     FDojoModule::string_to_bytes(to, actions.data, 32);
 
@@ -257,17 +318,93 @@ void FDojoModule::ExecuteRaw(Account *account, const char *to, const char *selec
         FDojoModule::string_to_bytes(feltsStr[i].c_str(), feltsWrapper[i].data, 32);
     }
 
+    return ExecuteRaw(account, actions, selector, feltsWrapper.Get(), nbFelts, outTransactionHash);
+}
+
+bool FDojoModule::ExecuteRaw(Account *account, const FieldElement &to, const char *selector, const FieldElement *calldata, int32 calldataLen, FieldElement *outTransactionHash)
+{
+    // account_execute_raw only reads the calldata
     struct Call call = {
-        .to = actions,
+        .to = to,
         .selector = selector,
         .calldata = {
-            .data_len = nbFelts,
-            .data = feltsWrapper.Get()
+            .data = const_cast<FieldElement*>(calldata),
+            .data_len = static_cast<uintptr_t>(calldataLen)
         }
     };
 
-    account_execute_raw(account, &call, 1);
-    // No manual cleanup needed - RAII wrapper handles it
+    return ExecuteRaw(account, &call, 1, outTransactionHash);
+}
+
+bool FDojoModule::ExecuteRaw(Account *account, const Call *calls, int32 numCalls, FieldElement *outTransactionHash)
+{
+    if (!account) {
+        UE_LOG(LogTemp, Error, TEXT("FDojoModule::ExecuteRaw - Account is null!"));
+        return false;
+    }
+    if (!calls || numCalls <= 0) {
+        UE_LOG(LogTemp, Error, TEXT("FDojoModule::ExecuteRaw - No calls to send"));
+        return false;
+    }
+
+    ResultFieldElement result = account_execute_raw(account, calls, static_cast<uintptr_t>(numCalls));
+    if (result.tag == ErrFieldElement) {
+        UE_LOG(LogTemp, Warning, TEXT("FDojoModule::ExecuteRaw - %hs (%d calls) rejected: %hs"),
+            calls[0].selector, numCalls, result.err.message);
+        StringFree(result.err.message);
+        return false;
+    }
+    if (outTransactionHash) {
+        *outTransactionHash = result.ok;
+    }
+    return true;
+}
+
+bool FDojoModule::WaitForTransaction(Provider *provider, const FieldElement &transactionHash, bool &bOutSucceeded)
+{
+    bOutSucceeded = false;
+    if (!provider) return false;
+
+    Resultbool result = wait_for_transaction(provider, transactionHash);
+    if (result.tag == Errbool) {
+        // dojo.c 1.7.0 hands out no receipt status: a reverted or rejected receipt and an RPC error
+        // all come back as a message, which is no contract. The outcome is unknown to the caller.
+        UE_LOG(LogTemp, Warning, TEXT("FDojoModule::WaitForTransaction - %hs"), result.err.message);
+        StringFree(result.err.message);
+        return false;
+    }
+    // Ok carries the receipt's execution status
+    bOutSucceeded = result.ok;
+    return true;
+}
+
+bool FDojoModule::AccountNonce(Account *account, uint64 &outNonce)
+{
+    if (!account) return false;
+
+    ResultFieldElement result = account_nonce(account);
+    if (result.tag == ErrFieldElement) {
+        UE_LOG(LogTemp, Warning, TEXT("FDojoModule::AccountNonce - %hs"), result.err.message);
+        StringFree(result.err.message);
+        return false;
+    }
+
+    // Nonces are small, the low 8 bytes of the big-endian felt are enough
+    outNonce = 0;
+    for (int i = 24; i < 32; i++) {
+        outNonce = (outNonce << 8) | result.ok.data[i];
+    }
+    return true;
+}
+
+void FDojoModule::UsePreConfirmedBlock(Account *account)
+{
+    if (!account) return;
+
+    BlockId blockId;
+    blockId.tag = BlockTag_;
+    blockId.block_tag = PreConfirmed;
+    account_set_block_id(account, blockId);
 }
 
 void FDojoModule::ExecuteFromOutside(ControllerAccount *account, const char *to, const char *selector, const TArray<std::string>& feltsStr)
@@ -314,6 +451,10 @@ struct ResultSubscription FDojoModule::OnEntityUpdate(ToriiClient *client, const
     UE_LOG(LogTemp, Log, TEXT("  Query: %hs"), query_str ? query_str : "null");
     UE_LOG(LogTemp, Log, TEXT("  Callback pointer: %p"), callback);
 
+    if (FToriiStandIn* standIn = FToriiStandIn::FromClient(client)) {
+        return standIn->Subscribe(nullptr, nullptr, callback);
+    }
+
     COptionClause clause = {
         .tag = NoneClause
     };
@@ -331,11 +472,141 @@ struct ResultSubscription FDojoModule::OnEntityUpdate(ToriiClient *client, const
     return result;
 }
 
+bool FDojoModule::PingEntitySubscription(ToriiClient *client, struct Subscription *subscription)
+{
+    if (!client || !subscription) return false;
+
+    if (FToriiStandIn::FromClient(client)) {
+        return FToriiStandIn::HasSubscription(subscription);
+    }
+
+    COptionClause clause = {
+        .tag = NoneClause
+    };
+    Resultbool result = client_update_entity_subscription(client, subscription, clause);
+    if (result.tag == Errbool) {
+        UE_LOG(LogTemp, Warning, TEXT("FDojoModule::PingEntitySubscription - %hs"), result.err.message);
+        StringFree(result.err.message);
+        return false;
+    }
+    return true;
+}
+
+struct ResultSubscription FDojoModule::OnTransaction(ToriiClient *client, const char *senderAddress, TransactionUpdateCallback callback)
+{
+    if (FToriiStandIn::FromClient(client)) {
+        // The stand-in serves entities only
+        ResultSubscription result;
+        result.tag = ErrSubscription;
+        result.err.message = const_cast<char*>("transactions are not served by the Torii stand-in");
+        return result;
+    }
+
+    FieldElement sender;
+    FDojoModule::string_to_bytes(senderAddress, sender.data, 32);
+
+    COptionTransactionFilter filter;
+    memset(&filter, 0, sizeof(filter));
+    filter.tag = SomeTransactionFilter;
+    filter.some.caller_addresses.data = &sender;
+    filter.some.caller_addresses.data_len = 1;
+    filter.some.from_block.tag = Noneu64;
+    filter.some.to_block.tag = Noneu64;
+
+    struct ResultSubscription result = client_on_transaction(client, filter, callback);
+    if (result.tag == ErrSubscription) {
+        UE_LOG(LogTemp, Error, TEXT("FDojoModule::OnTransaction - Error: %hs"), result.err.message);
+    }
+    return result;
+}
+
+// Keys clause over keys (empty string = wildcard) for the given models; keyOptions and modelNames
+// back the clause's arrays and must outlive it
+static COptionClause MakeKeysClause(const TArray<std::string> &keys, const TArray<std::string> &models,
+    TArray<COptionFieldElement> &keyOptions, TArray<const char*> &modelNames)
+{
+    keyOptions.SetNumZeroed(keys.Num());
+    for (int i = 0; i < keys.Num(); i++) {
+        if (keys[i].empty()) {
+            keyOptions[i].tag = NoneFieldElement;
+        } else {
+            keyOptions[i].tag = SomeFieldElement;
+            FDojoModule::string_to_bytes(keys[i], keyOptions[i].some.data, 32);
+        }
+    }
+
+    for (const std::string &model : models) {
+        modelNames.Add(model.c_str());
+    }
+
+    COptionClause clause;
+    memset(&clause, 0, sizeof(clause));
+    clause.tag = SomeClause;
+    clause.some.tag = Keys;
+    clause.some.keys.keys.data = keyOptions.GetData();
+    clause.some.keys.keys.data_len = keyOptions.Num();
+    clause.some.keys.pattern_matching = VariableLen;
+    clause.some.keys.models.data = modelNames.Num() > 0 ? modelNames.GetData() : nullptr;
+    clause.some.keys.models.data_len = modelNames.Num();
+    return clause;
+}
+
+struct ResultSubscription FDojoModule::OnEntityUpdateByKeys(ToriiClient *client, const TArray<std::string> &keys, const TArray<std::string> &models, EntityUpdateCallback callback)
+{
+    if (FToriiStandIn* standIn = FToriiStandIn::FromClient(client)) {
+        return standIn->Subscribe(&keys, &models, callback);
+    }
+
+    TArray<COptionFieldElement> keyOptions;
+    TArray<const char*> modelNames;
+    COptionClause clause = MakeKeysClause(keys, models, keyOptions, modelNames);
+
+    struct ResultSubscription result = client_on_entity_state_update(client, clause, callback);
+    if (result.tag == ErrSubscription) {
+        UE_LOG(LogTemp, Error, TEXT("FDojoModule::OnEntityUpdateByKeys - Error: %hs"), result.err.message);
+    } else {
+        UE_LOG(LogTemp, Log, TEXT("FDojoModule::OnEntityUpdateByKeys - Success, subscription pointer: %p"), result.ok);
+    }
+    return result;
+}
+
+struct ResultSubscription FDojoModule::OnEventMessageByKeys(ToriiClient *client, const TArray<std::string> &keys, const TArray<std::string> &models, EntityUpdateCallback callback)
+{
+    if (FToriiStandIn::FromClient(client)) {
+        // The stand-in serves entities only
+        ResultSubscription result;
+        result.tag = ErrSubscription;
+        result.err.message = const_cast<char*>("event messages are not served by the Torii stand-in");
+        return result;
+    }
+
+    TArray<COptionFieldElement> keyOptions;
+    TArray<const char*> modelNames;
+    COptionClause clause = MakeKeysClause(keys, models, keyOptions, modelNames);
+
+    struct ResultSubscription result = client_on_event_message_update(client, clause, callback);
+    if (result.tag == ErrSubscription) {
+        UE_LOG(LogTemp, Error, TEXT("FDojoModule::OnEventMessageByKeys - Error: %hs"), result.err.message);
+    }
+    return result;
+}
+
 void FDojoModule::SubscriptionCancel(struct Subscription *subscription)
 {
+    if (FToriiStandIn::CancelSubscription(subscription)) {
+        return;
+    }
     subscription_cancel(subscription);
 }
 
+void FDojoModule::ClientFree(ToriiClient *client)
+{
+    if (FToriiStandIn::DestroyClient(client)) {
+        return;
+    }
+    client_free(client);
+}
+
 void FDojoModule::AccountFree(struct Account *account)
 {
     account_free(account);
@@ -358,9 +629,20 @@ void FDojoModule::TyFree(struct Ty *ty)
 
 void FDojoModule::CArrayFree(void *data, int len)
 {
+    if (FToriiStandIn::ReleaseArray(data)) {
+        return;
+    }
     carray_free(data, len);
 }
 
+void FDojoModule::StringFree(char *string)
+{
+    // Error messages and other strings handed out by dojo.c are owned by the caller
+    if (string) {
+        string_free(string);
+    }
+}
+
 struct ResultCArrayFieldElement FDojoModule::SerializeByteArray(const FString& str)
 {
     // Convert FString to const char*
@@ -0,0 +1,688 @@
+//
+//  ToriiStandIn.cpp
+//  dojo_starter_ue5 (Mac)
+//
+//  In-process stand-in for a Torii server, used for offline ingest benchmarks.
+//
+
+#include "ToriiStandIn.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformProcess.h"
+#include <cstring>
+
+static const char* STANDIN_SCHEME = "standin://";
+
+// Everything the stand-in hands out goes through these, so FDojoModule can tell our pointers from dojo.c's
+static FCriticalSection RegistryMutex;
+static TSet<FToriiStandIn*> LiveClients;
+static TMap<struct Subscription*, FToriiStandIn*> LiveSubscriptions;
+static TMap<void*, void*> ArenaBlockOwners;
+static TMap<void*, TArray<void*>> ArenaOwnedBlocks;
+static TMap<int32, TUniquePtr<std::string>> InternedCursors;
+
+static int32 IntWidthBits(const FString& Type)
+{
+    if (Type == TEXT("u8") || Type == TEXT("i8") || Type == TEXT("bool")) return 8;
+    if (Type == TEXT("u16") || Type == TEXT("i16")) return 16;
+    if (Type == TEXT("u32") || Type == TEXT("i32")) return 32;
+    if (Type == TEXT("u64") || Type == TEXT("i64") || Type == TEXT("usize")) return 64;
+    return 0;
+}
+
+static bool IsWideType(const FString& Type)
+{
+    return Type == TEXT("felt252") || Type == TEXT("ContractAddress") || Type == TEXT("ClassHash")
+        || Type == TEXT("u128") || Type == TEXT("i128");
+}
+
+static uint64 MaskToWidth(uint64 Value, int32 Bits)
+{
+    return Bits >= 64 ? Value : (Value & ((1ull << Bits) - 1));
+}
+
+static bool ParseHexBytes(const FString& Hex, uint8 Out[32])
+{
+    FMemory::Memzero(Out, 32);
+    FString Digits = Hex.StartsWith(TEXT("0x")) ? Hex.RightChop(2) : Hex;
+    if (Digits.Len() > 64) return false;
+
+    int32 OutIndex = 31;
+    for (int32 i = Digits.Len() - 1; i >= 0; i -= 2)
+    {
+        const TCHAR Lo = Digits[i];
+        const TCHAR Hi = i > 0 ? Digits[i - 1] : TEXT('0');
+        if (!FChar::IsHexDigit(Lo) || !FChar::IsHexDigit(Hi)) return false;
+        Out[OutIndex--] = static_cast<uint8>((FParse::HexDigit(Hi) << 4) | FParse::HexDigit(Lo));
+    }
+    return true;
+}
+
+static void AddToBigEndian(uint8 Bytes[32], uint64 Amount)
+{
+    for (int32 i = 31; i >= 0 && Amount; i--)
+    {
+        const uint64 Sum = Bytes[i] + (Amount & 0xFF);
+        Bytes[i] = static_cast<uint8>(Sum);
+        Amount = (Amount >> 8) + (Sum >> 8);
+    }
+}
+
+void* FToriiStandIn::FArena::Alloc(SIZE_T Size)
+{
+    void* Block = FMemory::Malloc(FMath::Max<SIZE_T>(Size, 1));
+    FMemory::Memzero(Block, Size);
+    Blocks.Add(Block);
+    return Block;
+}
+
+bool FToriiStandIn::IsStandInUrl(const char* url)
+{
+    return url && strncmp(url, STANDIN_SCHEME, strlen(STANDIN_SCHEME)) == 0;
+}
+
+ToriiClient* FToriiStandIn::Create(const char* url)
+{
+    if (!IsStandInUrl(url)) return nullptr;
+
+    FString Rest = UTF8_TO_TCHAR(url + strlen(STANDIN_SCHEME));
+    FString Path = Rest, Params;
+    Rest.Split(TEXT("?"), &Path, &Params);
+
+    FConfig Config;
+    Config.FixturePath = Path;
+
+    TArray<FString> Pairs;
+    Params.ParseIntoArray(Pairs, TEXT("&"));
+    for (const FString& Pair : Pairs)
+    {
+        FString Key, Value;
+        if (!Pair.Split(TEXT("="), &Key, &Value)) continue;
+        if (Key == TEXT("entities")) Config.EntityCount = FCString::Atoi(*Value);
+        else if (Key == TEXT("rate")) Config.UpdatesPerSecond = FCString::Atof(*Value);
+        else if (Key == TEXT("batch")) Config.UpdatesPerBatch = FMath::Max(1, FCString::Atoi(*Value));
+        else if (Key == TEXT("latency_ms")) Config.LatencyMs = FCString::Atof(*Value);
+        else if (Key == TEXT("jitter_ms")) Config.JitterMs = FCString::Atof(*Value);
+        else if (Key == TEXT("seed")) Config.Seed = FCString::Atoi(*Value);
+        else UE_LOG(LogTemp, Warning, TEXT("ToriiStandIn: unknown parameter '%s'"), *Key);
+    }
+
+    FToriiStandIn* StandIn = new FToriiStandIn(Config);
+    if (!StandIn->LoadFixture())
+    {
+        delete StandIn;
+        return nullptr;
+    }
+    StandIn->CloneToEntityCount();
+
+    UE_LOG(LogTemp, Log, TEXT("ToriiStandIn: serving %d entities from %s (rate %.0f/s, batch %d, latency %.0f+%.0fms)"),
+        StandIn->WorldEntities.Num(), *Config.FixturePath, Config.UpdatesPerSecond, Config.UpdatesPerBatch,
+        Config.LatencyMs, Config.JitterMs);
+
+    FScopeLock Lock(&RegistryMutex);
+    LiveClients.Add(StandIn);
+    return reinterpret_cast<ToriiClient*>(StandIn);
+}
+
+FToriiStandIn* FToriiStandIn::FromClient(ToriiClient* client)
+{
+    FToriiStandIn* StandIn = reinterpret_cast<FToriiStandIn*>(client);
+    FScopeLock Lock(&RegistryMutex);
+    return LiveClients.Contains(StandIn) ? StandIn : nullptr;
+}
+
+bool FToriiStandIn::DestroyClient(ToriiClient* client)
+{
+    FToriiStandIn* StandIn = reinterpret_cast<FToriiStandIn*>(client);
+    {
+        FScopeLock Lock(&RegistryMutex);
+        if (LiveClients.Remove(StandIn) == 0) return false;
+    }
+    delete StandIn;
+    return true;
+}
+
+bool FToriiStandIn::HasSubscription(struct Subscription* subscription)
+{
+    FScopeLock Lock(&RegistryMutex);
+    return LiveSubscriptions.Contains(subscription);
+}
+
+bool FToriiStandIn::CancelSubscription(struct Subscription* subscription)
+{
+    FToriiStandIn* StandIn = nullptr;
+    {
+        FScopeLock Lock(&RegistryMutex);
+        if (!LiveSubscriptions.RemoveAndCopyValue(subscription, StandIn)) return false;
+    }
+
+    FSubscriptionEntry* Entry = nullptr;
+    {
+        FScopeLock Lock(&StandIn->SubscriptionsMutex);
+        if (!StandIn->Subscriptions.RemoveAndCopyValue(subscription, Entry)) return true;
+    }
+
+    // Out of the map, so no new delivery picks it up. Waits for the ones already running:
+    // no callback runs after cancel returns (don't cancel a subscription from its own callback).
+    while (Entry->Deliveries.load(std::memory_order_acquire) > 0)
+    {
+        FPlatformProcess::Sleep(0.0005f);
+    }
+    delete Entry;
+    return true;
+}
+
+bool FToriiStandIn::ReleaseArray(void* data)
+{
+    if (data == nullptr) return false;
+
+    TArray<void*> ToFree;
+    {
+        FScopeLock Lock(&RegistryMutex);
+        void** Owner = ArenaBlockOwners.Find(data);
+        if (!Owner) return false;
+
+        // Inner arrays are released before their parent; only the outermost one frees the arena
+        if (*Owner != data) return true;
+
+        ArenaOwnedBlocks.RemoveAndCopyValue(data, ToFree);
+        for (void* Block : ToFree)
+        {
+            ArenaBlockOwners.Remove(Block);
+        }
+    }
+    for (void* Block : ToFree)
+    {
+        FMemory::Free(Block);
+    }
+    return true;
+}
+
+void FToriiStandIn::RegisterArena(FArena* Arena)
+{
+    FScopeLock Lock(&RegistryMutex);
+    for (void* Block : Arena->Blocks)
+    {
+        ArenaBlockOwners.Add(Block, Arena->Owner);
+    }
+    ArenaOwnedBlocks.Add(Arena->Owner, MoveTemp(Arena->Blocks));
+}
+
+const char* FToriiStandIn::InternCursor(int32 Offset)
+{
+    FScopeLock Lock(&RegistryMutex);
+    TUniquePtr<std::string>& Cursor = InternedCursors.FindOrAdd(Offset);
+    if (!Cursor.IsValid())
+    {
+        Cursor = MakeUnique<std::string>(std::to_string(Offset));
+    }
+    return Cursor->c_str();
+}
+
+FToriiStandIn::FToriiStandIn(const FConfig& InConfig)
+    : Config(InConfig)
+    , Random(InConfig.Seed)
+    , JitterRandom(InConfig.Seed ^ 0x5EED)
+{
+}
+
+FToriiStandIn::~FToriiStandIn()
+{
+    bStopping = true;
+    if (GeneratorThread)
+    {
+        GeneratorThread->WaitForCompletion();
+        delete GeneratorThread;
+        GeneratorThread = nullptr;
+    }
+
+    FScopeLock Lock(&RegistryMutex);
+    for (TPair<struct Subscription*, FSubscriptionEntry*>& Pair : Subscriptions)
+    {
+        LiveSubscriptions.Remove(Pair.Key);
+        delete Pair.Value;
+    }
+    Subscriptions.Empty();
+}
+
+bool FToriiStandIn::LoadFixture()
+{
+    FString Json;
+    if (!FFileHelper::LoadFileToString(Json, *Config.FixturePath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("ToriiStandIn: can't read fixture %s"), *Config.FixturePath);
+        return false;
+    }
+
+    TSharedPtr<FJsonObject> Root;
+    if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), Root) || !Root.IsValid())
+    {
+        UE_LOG(LogTemp, Error, TEXT("ToriiStandIn: fixture %s is not valid JSON"), *Config.FixturePath);
+        return false;
+    }
+
+    TMap<FString, int32> ModelIndex;
+    const TSharedPtr<FJsonObject>* Models;
+    if (Root->TryGetObjectField(TEXT("models"), Models))
+    {
+        for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*Models)->Values)
+        {
+            FModelSchema Schema;
+            Schema.Name = TCHAR_TO_UTF8(*Pair.Key);
+            for (const TSharedPtr<FJsonValue>& MemberValue : Pair.Value->AsArray())
+            {
+                const TSharedPtr<FJsonObject> MemberObject = MemberValue->AsObject();
+                FMemberSchema Member;
+                Member.Name = TCHAR_TO_UTF8(*MemberObject->GetStringField(TEXT("name")));
+                Member.Type = MemberObject->GetStringField(TEXT("type"));
+                MemberObject->TryGetBoolField(TEXT("key"), Member.bKey);
+                Schema.Members.Add(MoveTemp(Member));
+            }
+            ModelIndex.Add(Pair.Key, Schemas.Add(MoveTemp(Schema)));
+        }
+    }
+
+    const TArray<TSharedPtr<FJsonValue>>* Entities;
+    if (Root->TryGetArrayField(TEXT("entities"), Entities))
+    {
+        for (const TSharedPtr<FJsonValue>& EntityValue : *Entities)
+        {
+            const TSharedPtr<FJsonObject> EntityObject = EntityValue->AsObject();
+            const int32* Model = ModelIndex.Find(EntityObject->GetStringField(TEXT("model")));
+            if (!Model)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("ToriiStandIn: entity with unknown model skipped"));
+                continue;
+            }
+
+            FEntity Entity;
+            Entity.Model = *Model;
+            Entity.Values.SetNum(Schemas[*Model].Members.Num());
+
+            const TSharedPtr<FJsonObject>* Values;
+            if (EntityObject->TryGetObjectField(TEXT("values"), Values))
+            {
+                for (int32 i = 0; i < Schemas[*Model].Members.Num(); i++)
+                {
+                    const FMemberSchema& Member = Schemas[*Model].Members[i];
+                    const TSharedPtr<FJsonValue> Json = (*Values)->TryGetField(UTF8_TO_TCHAR(Member.Name.c_str()));
+                    if (!Json.IsValid()) continue;
+
+                    FValue& Value = Entity.Values[i];
+                    if (Json->Type == EJson::Boolean)
+                    {
+                        Value.Int = Json->AsBool() ? 1 : 0;
+                    }
+                    else if (Json->Type == EJson::Number)
+                    {
+                        Value.Int = static_cast<uint64>(Json->AsNumber());
+                        AddToBigEndian(Value.Bytes, Value.Int);
+                    }
+                    else if (Member.Type == TEXT("ByteArray"))
+                    {
+                        Value.Text = TCHAR_TO_UTF8(*Json->AsString());
+                    }
+                    else if (ParseHexBytes(Json->AsString(), Value.Bytes))
+                    {
+                        for (int32 b = 24; b < 32; b++) Value.Int = (Value.Int << 8) | Value.Bytes[b];
+                    }
+                }
+            }
+            ComputeHashedKeys(Entity);
+            WorldEntities.Add(MoveTemp(Entity));
+        }
+    }
+
+    if (WorldEntities.Num() == 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("ToriiStandIn: fixture %s has no entities"), *Config.FixturePath);
+        return false;
+    }
+    return true;
+}
+
+void FToriiStandIn::CloneToEntityCount()
+{
+    const int32 NumTemplates = WorldEntities.Num();
+    for (int32 i = NumTemplates; i < Config.EntityCount; i++)
+    {
+        FEntity Clone = WorldEntities[i % NumTemplates];
+        const uint64 Generation = static_cast<uint64>(i / NumTemplates);
+
+        // Shift the owner (first key): clones belong to other players, the fixture's own player stays as is
+        const int32 Shifted = Schemas[Clone.Model].Members.IndexOfByPredicate([](const FMemberSchema& Member) { return Member.bKey; });
+        if (Shifted == INDEX_NONE) continue;
+
+        const FString& Type = Schemas[Clone.Model].Members[Shifted].Type;
+        FValue& Value = Clone.Values[Shifted];
+        if (IsWideType(Type))
+        {
+            AddToBigEndian(Value.Bytes, Generation);
+        }
+        else
+        {
+            Value.Int = MaskToWidth(Value.Int + Generation, IntWidthBits(Type));
+        }
+
+        ComputeHashedKeys(Clone);
+        WorldEntities.Add(MoveTemp(Clone));
+    }
+}
+
+void FToriiStandIn::ComputeHashedKeys(FEntity& Entity) const
+{
+    // Not Poseidon, only needs to be stable and distinct per key set
+    uint64 Hash = 0xcbf29ce484222325ull;
+    const FModelSchema& Schema = Schemas[Entity.Model];
+    for (int32 m = 0; m < Schema.Members.Num(); m++)
+    {
+        if (!Schema.Members[m].bKey) continue;
+        const FValue& Value = Entity.Values[m];
+        for (int32 b = 0; b < 32; b++) Hash = (Hash ^ Value.Bytes[b]) * 0x100000001b3ull;
+        for (int32 b = 0; b < 8; b++) Hash = (Hash ^ ((Value.Int >> (b * 8)) & 0xFF)) * 0x100000001b3ull;
+    }
+
+    FMemory::Memzero(Entity.HashedKeys.data, 32);
+    for (int32 b = 0; b < 8; b++)
+    {
+        Entity.HashedKeys.data[31 - b] = static_cast<uint8>(Hash >> (b * 8));
+    }
+}
+
+bool FToriiStandIn::MakeFilter(const TArray<std::string>* keys, const TArray<std::string>* models, FFilter& OutFilter) const
+{
+    if (keys)
+    {
+        for (const std::string& Key : *keys)
+        {
+            FieldElement Felt;
+            const bool bWildcard = Key.empty();
+            if (!bWildcard && !ParseHexBytes(UTF8_TO_TCHAR(Key.c_str()), Felt.data)) return false;
+            OutFilter.Keys.Add(Felt);
+            OutFilter.Wildcard.Add(bWildcard);
+        }
+    }
+    if (models)
+    {
+        for (const std::string& Name : *models)
+        {
+            for (int32 i = 0; i < Schemas.Num(); i++)
+            {
+                if (Schemas[i].Name == Name) OutFilter.Models.Add(i);
+            }
+        }
+    }
+    return true;
+}
+
+bool FToriiStandIn::Matches(const FEntity& Entity, const FFilter& Filter) const
+{
+    if (Filter.Models.Num() > 0 && !Filter.Models.Contains(Entity.Model)) return false;
+
+    // VariableLen: the filter's keys must prefix the entity's keys
+    const FModelSchema& Schema = Schemas[Entity.Model];
+    int32 KeyIndex = 0;
+    for (int32 m = 0; m < Schema.Members.Num() && KeyIndex < Filter.Keys.Num(); m++)
+    {
+        if (!Schema.Members[m].bKey) continue;
+        if (!Filter.Wildcard[KeyIndex])
+        {
+            uint8 Bytes[32];
+            const FValue& Value = Entity.Values[m];
+            if (IsWideType(Schema.Members[m].Type))
+            {
+                FMemory::Memcpy(Bytes, Value.Bytes, 32);
+            }
+            else
+            {
+                FMemory::Memzero(Bytes, 32);
+                AddToBigEndian(Bytes, Value.Int);
+            }
+            if (FMemory::Memcmp(Bytes, Filter.Keys[KeyIndex].data, 32) != 0) return false;
+        }
+        KeyIndex++;
+    }
+    return KeyIndex == Filter.Keys.Num();
+}
+
+void FToriiStandIn::MutateEntity(FEntity& Entity)
+{
+    const FModelSchema& Schema = Schemas[Entity.Model];
+    TArray<int32, TInlineAllocator<16>> Candidates;
+    for (int32 m = 0; m < Schema.Members.Num(); m++)
+    {
+        // Keys identify the entity, bools would mostly destroy things
+        if (!Schema.Members[m].bKey && Schema.Members[m].Type != TEXT("bool") && Schema.Members[m].Type != TEXT("ByteArray"))
+        {
+            Candidates.Add(m);
+        }
+    }
+    if (Candidates.Num() == 0) return;
+
+    const int32 m = Candidates[Random.RandRange(0, Candidates.Num() - 1)];
+    FValue& Value = Entity.Values[m];
+    if (IsWideType(Schema.Members[m].Type))
+    {
+        Value.Bytes[Random.RandRange(16, 31)] ^= static_cast<uint8>(Random.RandRange(1, 255));
+    }
+    else
+    {
+        Value.Int = MaskToWidth(Value.Int + 1, IntWidthBits(Schema.Members[m].Type));
+    }
+}
+
+void FToriiStandIn::InjectLatency()
+{
+    float Ms = Config.LatencyMs;
+    if (Config.JitterMs > 0.0f)
+    {
+        FScopeLock Lock(&JitterMutex);
+        Ms += JitterRandom.FRandRange(0.0f, Config.JitterMs);
+    }
+    if (Ms > 0.0f)
+    {
+        FPlatformProcess::Sleep(Ms / 1000.0f);
+    }
+}
+
+void FToriiStandIn::BuildStruct(const FEntity& Entity, FArena& Arena, Struct& OutStruct) const
+{
+    const FModelSchema& Schema = Schemas[Entity.Model];
+    const int32 NumMembers = Schema.Members.Num();
+
+    Member* Members = static_cast<Member*>(Arena.Alloc(sizeof(Member) * NumMembers));
+    Ty* Tys = static_cast<Ty*>(Arena.Alloc(sizeof(Ty) * NumMembers));
+
+    for (int32 m = 0; m < NumMembers; m++)
+    {
+        const FMemberSchema& MemberSchema = Schema.Members[m];
+        const FValue& Value = Entity.Values[m];
+        Ty& Type = Tys[m];
+
+        Members[m].name = MemberSchema.Name.c_str();
+        Members[m].key = MemberSchema.bKey;
+        Members[m].ty = &Type;
+
+        const FString& Name = MemberSchema.Type;
+        if (Name == TEXT("ByteArray"))
+        {
+            char* Text = static_cast<char*>(Arena.Alloc(Value.Text.size() + 1));
+            FMemory::Memcpy(Text, Value.Text.c_str(), Value.Text.size() + 1);
+            Type.tag = ByteArray;
+            Type.byte_array = Text;
+            continue;
+        }
+
+        Type.tag = Primitive_;
+        Primitive& Prim = Type.primitive;
+        if (Name == TEXT("felt252")) { Prim.tag = Felt252; FMemory::Memcpy(Prim.felt252.data, Value.Bytes, 32); }
+        else if (Name == TEXT("ContractAddress")) { Prim.tag = ContractAddress; FMemory::Memcpy(Prim.contract_address.data, Value.Bytes, 32); }
+        else if (Name == TEXT("ClassHash")) { Prim.tag = ClassHash; FMemory::Memcpy(Prim.class_hash.data, Value.Bytes, 32); }
+        else if (Name == TEXT("u128")) { Prim.tag = U128; FMemory::Memcpy(Prim.u128, Value.Bytes + 16, 16); }
+        else if (Name == TEXT("i128")) { Prim.tag = I128; FMemory::Memcpy(Prim.i128, Value.Bytes + 16, 16); }
+        else if (Name == TEXT("u8")) { Prim.tag = U8; Prim.u8 = static_cast<uint8_t>(Value.Int); }
+        else if (Name == TEXT("u16")) { Prim.tag = U16; Prim.u16 = static_cast<uint16_t>(Value.Int); }
+        else if (Name == TEXT("u32")) { Prim.tag = U32; Prim.u32 = static_cast<uint32_t>(Value.Int); }
+        else if (Name == TEXT("u64") || Name == TEXT("usize")) { Prim.tag = U64; Prim.u64 = Value.Int; }
+        else if (Name == TEXT("i8")) { Prim.tag = I8; Prim.i8 = static_cast<int8_t>(Value.Int); }
+        else if (Name == TEXT("i16")) { Prim.tag = I16; Prim.i16 = static_cast<int16_t>(Value.Int); }
+        else if (Name == TEXT("i32")) { Prim.tag = I32; Prim.i32 = static_cast<int32_t>(Value.Int); }
+        else if (Name == TEXT("i64")) { Prim.tag = I64; Prim.i64 = static_cast<int64_t>(Value.Int); }
+        else if (Name == TEXT("bool")) { Prim.tag = Bool; Prim.bool_ = Value.Int != 0; }
+    }
+
+    OutStruct.name = Schema.Name.c_str();
+    OutStruct.children.data = Members;
+    OutStruct.children.data_len = NumMembers;
+}
+
+ResultPageEntity FToriiStandIn::Entities(const TArray<std::string>* keys, int limit, const char* cursor)
+{
+    ResultPageEntity Result;
+    FMemory::Memzero(Result);
+
+    FFilter Filter;
+    if (!MakeFilter(keys, nullptr, Filter))
+    {
+        Result.tag = ErrPageEntity;
+        Result.err.message = const_cast<char*>("stand-in: invalid key");
+        return Result;
+    }
+
+    InjectLatency();
+
+    // The cursor is the index into the world where the previous page stopped scanning
+    int32 Index = cursor ? FCString::Atoi(UTF8_TO_TCHAR(cursor)) : 0;
+    const int32 Limit = limit > 0 ? limit : MAX_int32;
+
+    FArena Arena;
+    TArray<const FEntity*> Page;
+    FScopeLock Lock(&WorldMutex);
+    for (; Index < WorldEntities.Num() && Page.Num() < Limit; Index++)
+    {
+        if (Matches(WorldEntities[Index], Filter))
+        {
+            Page.Add(&WorldEntities[Index]);
+        }
+    }
+
+    Result.tag = OkPageEntity;
+    Result.ok.next_cursor.tag = Index < WorldEntities.Num() ? Somec_char : Nonec_char;
+    if (Result.ok.next_cursor.tag == Somec_char)
+    {
+        Result.ok.next_cursor.some = InternCursor(Index);
+    }
+    if (Page.Num() == 0)
+    {
+        return Result;
+    }
+
+    Entity* Items = static_cast<Entity*>(Arena.Alloc(sizeof(Entity) * Page.Num()));
+    Arena.Owner = Items;
+    for (int32 i = 0; i < Page.Num(); i++)
+    {
+        Struct* Models = static_cast<Struct*>(Arena.Alloc(sizeof(Struct)));
+        BuildStruct(*Page[i], Arena, *Models);
+        Items[i].hashed_keys = Page[i]->HashedKeys;
+        Items[i].models.data = Models;
+        Items[i].models.data_len = 1;
+    }
+    RegisterArena(&Arena);
+
+    Result.ok.items.data = Items;
+    Result.ok.items.data_len = Page.Num();
+    return Result;
+}
+
+ResultSubscription FToriiStandIn::Subscribe(const TArray<std::string>* keys, const TArray<std::string>* models, EntityUpdateCallback callback)
+{
+    ResultSubscription Result;
+    FMemory::Memzero(Result);
+
+    FSubscriptionEntry* Entry = new FSubscriptionEntry();
+    Entry->Callback = callback;
+    if (!callback || !MakeFilter(keys, models, Entry->Filter))
+    {
+        delete Entry;
+        Result.tag = ErrSubscription;
+        Result.err.message = const_cast<char*>("stand-in: invalid subscription");
+        return Result;
+    }
+
+    struct Subscription* Handle = reinterpret_cast<struct Subscription*>(Entry);
+    {
+        FScopeLock Lock(&SubscriptionsMutex);
+        Subscriptions.Add(Handle, Entry);
+    }
+    {
+        FScopeLock Lock(&RegistryMutex);
+        LiveSubscriptions.Add(Handle, this);
+        if (!GeneratorThread && Config.UpdatesPerSecond > 0.0f)
+        {
+            GeneratorThread = FRunnableThread::Create(this, TEXT("ToriiStandInStream"));
+        }
+    }
+
+    Result.tag = OkSubscription;
+    Result.ok = Handle;
+    return Result;
+}
+
+uint32 FToriiStandIn::Run()
+{
+    const double Interval = Config.UpdatesPerBatch / FMath::Max(Config.UpdatesPerSecond, 0.001f);
+    double NextTick = FPlatformTime::Seconds();
+
+    while (!bStopping)
+    {
+        NextTick += Interval;
+        const double Wait = NextTick - FPlatformTime::Seconds();
+        if (Wait > 0.0)
+        {
+            FPlatformProcess::Sleep(static_cast<float>(Wait));
+        }
+        InjectLatency();
+
+        for (int32 b = 0; b < Config.UpdatesPerBatch && !bStopping; b++)
+        {
+            FEntity Updated;
+            {
+                FScopeLock Lock(&WorldMutex);
+                FEntity& Target = WorldEntities[Random.RandRange(0, WorldEntities.Num() - 1)];
+                MutateEntity(Target);
+                Updated = Target;
+            }
+
+            // Like Torii's broker, every matching subscription gets its own copy. Callbacks may block
+            // (a full ingest ring), so they run outside the lock; Deliveries keeps their entry alive.
+            TArray<FSubscriptionEntry*, TInlineAllocator<4>> Targets;
+            {
+                FScopeLock Lock(&SubscriptionsMutex);
+                for (TPair<struct Subscription*, FSubscriptionEntry*>& Pair : Subscriptions)
+                {
+                    if (!Matches(Updated, Pair.Value->Filter)) continue;
+                    Pair.Value->Deliveries.fetch_add(1, std::memory_order_relaxed);
+                    Targets.Add(Pair.Value);
+                }
+            }
+
+            for (FSubscriptionEntry* Entry : Targets)
+            {
+                FArena Arena;
+                Struct* Models = static_cast<Struct*>(Arena.Alloc(sizeof(Struct)));
+                Arena.Owner = Models;
+                BuildStruct(Updated, Arena, *Models);
+                RegisterArena(&Arena);
+
+                CArrayStruct Array;
+                Array.data = Models;
+                Array.data_len = 1;
+                Entry->Callback(Updated.HashedKeys, Array);
+                Entry->Deliveries.fetch_sub(1, std::memory_order_release);
+            }
+        }
+    }
+    return 0;
+}
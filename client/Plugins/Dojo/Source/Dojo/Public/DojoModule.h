@@ -71,6 +71,7 @@ public:
 typedef void (*ControllerAccountCallback)(struct ControllerAccount*);
 //typedef void (*ControllerUrlCallback)(const char *);
 typedef void (*EntityUpdateCallback)(struct FieldElement, struct CArrayStruct);
+typedef void (*TransactionUpdateCallback)(struct Transaction);
 
 class DOJO_API FDojoModule : public IModuleInterface
 {
@@ -82,9 +83,44 @@ public:
     
     static ResultPageEntity GetEntities(ToriiClient *client, int limit, const char *cursor);
 
+    // Entities whose leading keys match `keys` (VariableLen). An empty string in `keys` is a wildcard.
+    static ResultPageEntity GetEntitiesByKeys(ToriiClient *client, const TArray<std::string> &keys, int limit, const char *cursor);
+
     static struct ResultSubscription OnEntityUpdate(ToriiClient *client, const char *query_str, void *user_data, EntityUpdateCallback callback);
+
+    // Round trip on the subscription itself: re-sends the clause OnEntityUpdate opened it with.
+    // False once Torii no longer knows the subscription, which a query answered by Torii can't tell.
+    static bool PingEntitySubscription(ToriiClient *client, struct Subscription *subscription);
+
+    // Subscription restricted to a key prefix (VariableLen) and an optional list of "namespace-Model" names
+    static struct ResultSubscription OnEntityUpdateByKeys(ToriiClient *client, const TArray<std::string> &keys, const TArray<std::string> &models, EntityUpdateCallback callback);
+
+    // Same clause as OnEntityUpdateByKeys, for models emitted as events (world.emit_event)
+    static struct ResultSubscription OnEventMessageByKeys(ToriiClient *client, const TArray<std::string> &keys, const TArray<std::string> &models, EntityUpdateCallback callback);
     
-    static void ExecuteRaw(Account *account, const char *to, const char *selector, const TArray<std::string> &feltsStr);
+    // Signs and sends the call. Returns false if the account or the node rejected it,
+    // otherwise the transaction hash is written to outTransactionHash (if given).
+    static bool ExecuteRaw(Account *account, const char *to, const char *selector, const TArray<std::string> &feltsStr, FieldElement *outTransactionHash = nullptr);
+
+    // Same, with the target and calldata already in binary form: nothing is parsed or copied
+    static bool ExecuteRaw(Account *account, const FieldElement &to, const char *selector, const FieldElement *calldata, int32 calldataLen, FieldElement *outTransactionHash = nullptr);
+
+    // Multicall: the calls run in order in one signed transaction, which reverts as a whole if any of them fails
+    static bool ExecuteRaw(Account *account, const Call *calls, int32 numCalls, FieldElement *outTransactionHash = nullptr);
+
+    // Blocks until the transaction is in a block; bOutSucceeded is its execution status. Returns false when
+    // the outcome is unknown: dojo.c reports reverted, rejected and RPC failures alike, as an error message.
+    static bool WaitForTransaction(Provider *provider, const FieldElement &transactionHash, bool &bOutSucceeded);
+
+    // Transactions Torii indexes from senderAddress (hex felt)
+    static struct ResultSubscription OnTransaction(ToriiClient *client, const char *senderAddress, TransactionUpdateCallback callback);
+
+    // Nonce of the account at its current block id (see UsePreConfirmedBlock)
+    static bool AccountNonce(Account *account, uint64 &outNonce);
+
+    // Nonce lookups, and so the nonce ExecuteRaw signs with, include transactions not yet in a block.
+    // Required to send several transactions back to back without waiting for each one.
+    static void UsePreConfirmedBlock(Account *account);
 
     static void ExecuteFromOutside(ControllerAccount *account, const char *to, const char *selector, const TArray<std::string> &feltsStr);
 
@@ -105,6 +141,8 @@ public:
 //    static void ControllerConnectMobile(const char* rpc_url, const struct Policy *policies, size_t nb_policies, ControllerAccountCallback callback, ControllerUrlCallback url_callback);
 //    
     static void SubscriptionCancel(struct Subscription *subscription);
+
+    static void ClientFree(ToriiClient *client);
     
     static void AccountFree(struct Account *account);
     
@@ -115,6 +153,8 @@ public:
     static void TyFree(struct Ty *ty);
 
     static void CArrayFree(void *data, int len);
+
+    static void StringFree(char *string);
     
     static FString bytes_to_fstring(const uint8_t* data, size_t length, bool addPrefix = true);
     
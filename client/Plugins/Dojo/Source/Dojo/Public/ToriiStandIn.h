@@ -0,0 +1,163 @@
+//
+//  ToriiStandIn.h
+//  dojo_starter_ue5 (Mac)
+//
+//  In-process stand-in for a Torii server, used for offline ingest benchmarks.
+//
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "Math/RandomStream.h"
+#include "dojo.h"
+#include <atomic>
+#include <string>
+
+using namespace dojo_bindings;
+
+typedef void (*EntityUpdateCallback)(struct FieldElement, struct CArrayStruct);
+
+/**
+ * Serves entity pages and subscription streams from a JSON fixture through the same C structures
+ * dojo.c hands out, so FDojoModule callers (fetch, gap-fill, subscriptions) run unchanged.
+ *
+ * Selected by connecting to a "standin://" URL:
+ *   standin:///path/to/fixture.json?entities=20000&rate=500&batch=16&latency_ms=30&jitter_ms=10&seed=1
+ *
+ *   entities    total entities served; fixture entities are cloned under other owners to reach it (0 = as is)
+ *   rate        entity updates per second pushed to subscriptions (0 = no stream)
+ *   batch       updates generated per stream tick
+ *   latency_ms  added before every page and every stream tick
+ *   jitter_ms   random extra latency in [0, jitter_ms]
+ *   seed        seed for cloning and update generation, runs are reproducible
+ *
+ * Fixture layout:
+ *   { "models":   { "<ns-Model>": [ { "name": "...", "type": "felt252|ContractAddress|u8|...|ByteArray", "key": true }, ... ] },
+ *     "entities": [ { "model": "<ns-Model>", "values": { "<member>": "0x..." | 12 | true | "text" } }, ... ] }
+ *   scripts/make_torii_fixture.py generates one for a player and their home island.
+ *
+ * Arrays handed out are owned by the stand-in and must be released through FDojoModule::CArrayFree.
+ */
+class DOJO_API FToriiStandIn : public FRunnable
+{
+public:
+    struct FConfig
+    {
+        FString FixturePath;
+        int32 EntityCount = 0;
+        float UpdatesPerSecond = 0.0f;
+        int32 UpdatesPerBatch = 1;
+        float LatencyMs = 0.0f;
+        float JitterMs = 0.0f;
+        int32 Seed = 1;
+    };
+
+    static bool IsStandInUrl(const char* url);
+
+    // Returns nullptr if the URL or fixture is invalid
+    static ToriiClient* Create(const char* url);
+
+    // nullptr if the client is a real Torii client
+    static FToriiStandIn* FromClient(ToriiClient* client);
+
+    // Returns false if the pointer doesn't belong to the stand-in
+    static bool DestroyClient(ToriiClient* client);
+    static bool CancelSubscription(struct Subscription* subscription);
+    // True while the subscription is open on a live stand-in
+    static bool HasSubscription(struct Subscription* subscription);
+    static bool ReleaseArray(void* data);
+
+    ResultPageEntity Entities(const TArray<std::string>* keys, int limit, const char* cursor);
+    ResultSubscription Subscribe(const TArray<std::string>* keys, const TArray<std::string>* models, EntityUpdateCallback callback);
+
+    virtual ~FToriiStandIn();
+
+    // FRunnable: the update generator
+    virtual uint32 Run() override;
+    virtual void Stop() override { bStopping = true; }
+
+private:
+    struct FMemberSchema
+    {
+        std::string Name;
+        FString Type;
+        bool bKey = false;
+    };
+
+    struct FModelSchema
+    {
+        std::string Name;
+        TArray<FMemberSchema> Members;
+    };
+
+    struct FValue
+    {
+        uint8 Bytes[32] = {};   // felts, u128 (big-endian)
+        uint64 Int = 0;         // integers, bool
+        std::string Text;       // ByteArray
+    };
+
+    struct FEntity
+    {
+        int32 Model = 0;
+        TArray<FValue> Values;
+        FieldElement HashedKeys;
+    };
+
+    struct FFilter
+    {
+        TArray<FieldElement> Keys;
+        TArray<bool> Wildcard;
+        TArray<int32> Models;
+    };
+
+    struct FSubscriptionEntry
+    {
+        FFilter Filter;
+        EntityUpdateCallback Callback = nullptr;
+
+        // Deliveries picked up under SubscriptionsMutex and still running their callback (outside the lock)
+        std::atomic<int32> Deliveries{0};
+    };
+
+    // Arrays allocated for one response; freed together when the outermost array is released
+    struct FArena
+    {
+        void* Owner = nullptr;
+        TArray<void*> Blocks;
+        void* Alloc(SIZE_T Size);
+    };
+
+    explicit FToriiStandIn(const FConfig& InConfig);
+
+    bool LoadFixture();
+    void CloneToEntityCount();
+    void ComputeHashedKeys(FEntity& Entity) const;
+    bool MakeFilter(const TArray<std::string>* keys, const TArray<std::string>* models, FFilter& OutFilter) const;
+    bool Matches(const FEntity& Entity, const FFilter& Filter) const;
+    void MutateEntity(FEntity& Entity);
+    void InjectLatency();
+
+    // Fills one Struct (members + Ty) for the entity inside the arena
+    void BuildStruct(const FEntity& Entity, FArena& Arena, Struct& OutStruct) const;
+
+    static void RegisterArena(FArena* Arena);
+    static const char* InternCursor(int32 Offset);
+
+    FConfig Config;
+    TArray<FModelSchema> Schemas;
+    TArray<FEntity> WorldEntities;
+    FCriticalSection WorldMutex;
+    FRandomStream Random;
+
+    // Latency jitter, seeded from the config like Random; drawn from any thread that serves a request
+    FRandomStream JitterRandom;
+    FCriticalSection JitterMutex;
+
+    TMap<struct Subscription*, FSubscriptionEntry*> Subscriptions;
+    FCriticalSection SubscriptionsMutex;
+    FRunnableThread* GeneratorThread = nullptr;
+    std::atomic<bool> bStopping{false};
+};
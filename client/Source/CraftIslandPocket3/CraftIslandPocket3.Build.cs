@@ -8,5 +8,6 @@ public class CraftIslandPocket3 : ModuleRules
 	{
 		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
 		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "EnhancedInput", "Dojo", "UMG", "Paper2D" });
+		PrivateDependencyModuleNames.AddRange(new string[] { "Json" });
 	}
 }
@@ -6,6 +6,9 @@
 #include <sstream>
 #include <memory>
 #include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "DojoModelKey.h"
+#include "WorldSnapshot.h"
 
 using namespace dojo_bindings;
 
@@ -27,6 +30,9 @@ ADojoHelpers::ADojoHelpers()
     subscribed = false;
     toriiClient = nullptr;
     subscription = nullptr;
+    IngestRing = MakeUnique<TDojoMpscRing<UDojoModel*>>(INGEST_RING_CAPACITY);
+    PlayerRing = MakeUnique<TDojoMpscRing<UDojoModel*>>(PLAYER_RING_CAPACITY);
+    SessionRecorder = MakeUnique<FDojoSessionRecorder>();
 }
 
 ADojoHelpers::~ADojoHelpers()
@@ -62,15 +68,70 @@ void ADojoHelpers::CleanupResources()
         UE_LOG(LogTemp, Log, TEXT("DojoHelpers: Subscription cancelled"));
     }
 
+    if (playerSubscription)
+    {
+        bPlayerLaneSubscribed = false;
+        FDojoModule::SubscriptionCancel(playerSubscription);
+        playerSubscription = nullptr;
+        GlobalActiveSubscriptions--;
+        UE_LOG(LogTemp, Log, TEXT("DojoHelpers: Player subscription cancelled"));
+    }
+
+    if (transactionSubscription)
+    {
+        FDojoModule::SubscriptionCancel(transactionSubscription);
+        transactionSubscription = nullptr;
+        GlobalActiveSubscriptions--;
+        UE_LOG(LogTemp, Log, TEXT("DojoHelpers: Transaction subscription cancelled"));
+    }
+
+    if (resultSubscription)
+    {
+        bPackedActionsResultsLive = false;
+        FDojoModule::SubscriptionCancel(resultSubscription);
+        resultSubscription = nullptr;
+        GlobalActiveSubscriptions--;
+    }
+
+    if (SessionRecorder)
+    {
+        SessionRecorder->Stop();
+    }
+
+    // Models still queued will never be broadcast: drop their GC protection
+    UDojoModel* Undelivered = nullptr;
+    while (PlayerRing->Pop(Undelivered))
+    {
+        EndHandOff(Undelivered);
+    }
+    while (IngestRing->Pop(Undelivered))
+    {
+        EndHandOff(Undelivered);
+    }
+
     // Free Torii client
     if (toriiClient)
     {
-        client_free(toriiClient);
+        FDojoModule::ClientFree(toriiClient);
         toriiClient = nullptr;
         GlobalActiveToriiClients--;
         UE_LOG(LogTemp, Log, TEXT("DojoHelpers: Torii client freed"));
     }
 
+    // Joins the submission threads before their accounts and providers go away. Receipt polls give up on
+    // teardown, a signing job or a receipt read in progress finishes first. Taken out under the lock but joined outside it.
+    {
+        TMap<Account*, TUniquePtr<FAccountSubmitState>> States;
+        TMap<ControllerAccount*, TUniquePtr<FDojoSubmitWorker>> Controllers;
+        {
+            FScopeLock Lock(&SubmitStatesMutex);
+            States = MoveTemp(SubmitStates);
+            Controllers = MoveTemp(ControllerWorkers);
+        }
+        States.Empty();
+        Controllers.Empty();
+    }
+
     // Free all allocated accounts
     {
         FScopeLock Lock(&ResourceMutex);
@@ -84,6 +145,7 @@ void ADojoHelpers::CleanupResources()
             }
         }
         AllocatedAccounts.Empty();
+        AccountProviders.Empty();
 
         // Free all allocated providers
         int32 ProviderCount = AllocatedProviders.Num();
@@ -113,6 +175,33 @@ void ADojoHelpers::LogResourceUsage() const
     UE_LOG(LogTemp, Warning, TEXT("  Torii Client: %s"), toriiClient ? TEXT("Active") : TEXT("Null"));
     UE_LOG(LogTemp, Warning, TEXT("  Subscription: %s"), subscription ? TEXT("Active") : TEXT("Null"));
     UE_LOG(LogTemp, Warning, TEXT("  Subscribed: %s"), subscribed ? TEXT("Yes") : TEXT("No"));
+    const double Now = FPlatformTime::Seconds();
+    UE_LOG(LogTemp, Warning, TEXT("  Stream silent for: %.0fs, last successful probe: %s"), Now - LastStreamActivity,
+        LastProbeSuccess > 0.0 ? *FString::Printf(TEXT("%.0fs ago"), Now - LastProbeSuccess) : TEXT("never"));
+
+    const FDojoIngestStats IngestStats = GetIngestStats();
+    UE_LOG(LogTemp, Warning, TEXT("Ingest Ring:"));
+    UE_LOG(LogTemp, Warning, TEXT("  Pushed/Popped: %llu/%llu, Dropped (refetched): %llu"),
+        IngestStats.Pushed, IngestStats.Popped, IngestStats.Dropped);
+    UE_LOG(LogTemp, Warning, TEXT("  High-water mark: %llu / %llu"), IngestStats.HighWaterMark, IngestStats.Capacity);
+
+    const FDojoIngestStats PlayerStats = GetPlayerIngestStats();
+    UE_LOG(LogTemp, Warning, TEXT("Player Lane: %s"), bPlayerLaneSubscribed ? TEXT("Subscribed") : TEXT("Off"));
+    UE_LOG(LogTemp, Warning, TEXT("  Pushed/Popped: %llu/%llu, Dropped: %llu, High-water mark: %llu / %llu"),
+        PlayerStats.Pushed, PlayerStats.Popped, PlayerStats.Dropped, PlayerStats.HighWaterMark, PlayerStats.Capacity);
+    UE_LOG(LogTemp, Warning, TEXT("  Duplicates skipped on bulk lane: %llu"), PlayerModelsDedupedFromBulk.load());
+
+    int32 PooledModels = 0;
+    {
+        FScopeLock PoolLock(const_cast<FCriticalSection*>(&ModelPoolMutex));
+        for (const TPair<UClass*, TArray<UDojoModel*>>& Pair : ModelPool)
+        {
+            PooledModels += Pair.Value.Num();
+        }
+    }
+    UE_LOG(LogTemp, Warning, TEXT("Model Pool: %s, %d pooled, %llu reused by the parsers"),
+        OnDojoModelUpdated.IsBound() && !bRecycleWithBlueprintListeners ? TEXT("off (Blueprint listeners keep models)") : TEXT("on"),
+        PooledModels, ModelsReused.load());
 
     UE_LOG(LogTemp, Warning, TEXT("Global Resources:"));
     UE_LOG(LogTemp, Warning, TEXT("  Global Torii Clients: %d"), GlobalActiveToriiClients);
@@ -159,11 +248,13 @@ void ADojoHelpers::Connect(const FString& torii_url, const FString& world)
     if (toriiClient)
     {
         UE_LOG(LogTemp, Warning, TEXT("Cleaning up existing Torii client"));
-        client_free(toriiClient);
+        FDojoModule::ClientFree(toriiClient);
         toriiClient = nullptr;
         GlobalActiveToriiClients--;
     }
 
+    WorldAddress = world;
+
     std::string torii_url_string = std::string(TCHAR_TO_UTF8(*torii_url));
     std::string world_string = std::string(TCHAR_TO_UTF8(*world));
 
@@ -181,9 +272,24 @@ void ADojoHelpers::Connect(const FString& torii_url, const FString& world)
     }
 }
 
+bool ADojoHelpers::StartSessionRecording(const FString& Path, const FString& PlayerAddress)
+{
+    return SessionRecorder->Start(Path, WorldAddress, PlayerAddress);
+}
+
+void ADojoHelpers::StopSessionRecording()
+{
+    SessionRecorder->Stop();
+}
+
 void ADojoHelpers::SetContractsAddresses(const TMap<FString,FString>& addresses)
 {
     ContractsAddresses = addresses;
+    ContractFelts.Reset();
+    for (const TPair<FString, FString>& Pair : addresses)
+    {
+        ContractFelts.Add(Pair.Key, FFelt252::FromHex(Pair.Value));
+    }
 }
 
 ADojoHelpers* ADojoHelpers::GetGlobalInstance()
@@ -207,10 +313,11 @@ FAccount ADojoHelpers::CreateAccountDeprecated(const FString& rpc_url, const FSt
     std::string private_key_string = std::string(TCHAR_TO_UTF8(*private_key));
 
     // Create provider first
+    Provider* provider = nullptr;
     ResultProvider resProvider = provider_new(rpc_url_string.c_str());
     if (resProvider.tag == OkProvider)
     {
-        Provider* provider = resProvider.ok;
+        provider = resProvider.ok;
         FScopeLock Lock(&ResourceMutex);
         AllocatedProviders.Add(provider);
         GlobalActiveProviders++;
@@ -224,6 +331,11 @@ FAccount ADojoHelpers::CreateAccountDeprecated(const FString& rpc_url, const FSt
         FScopeLock Lock(&ResourceMutex);
         AllocatedAccounts.Add(account.account);
         GlobalActiveAccounts++;
+        // Same node as the account: used to wait for its receipts
+        if (provider)
+        {
+            AccountProviders.Add(account.account, provider);
+        }
     }
 
     account.Address = address;
@@ -240,10 +352,11 @@ FAccount ADojoHelpers::CreateBurnerDeprecated(const FString& rpc_url, const FStr
     std::string private_key_string = std::string(TCHAR_TO_UTF8(*private_key));
 
     // Create provider first
+    Provider* provider = nullptr;
     ResultProvider resProvider = provider_new(rpc_url_string.c_str());
     if (resProvider.tag == OkProvider)
     {
-        Provider* provider = resProvider.ok;
+        provider = resProvider.ok;
         FScopeLock Lock(&ResourceMutex);
         AllocatedProviders.Add(provider);
         GlobalActiveProviders++;
@@ -274,6 +387,11 @@ FAccount ADojoHelpers::CreateBurnerDeprecated(const FString& rpc_url, const FStr
         FScopeLock Lock(&ResourceMutex);
         AllocatedAccounts.Add(account.account);
         GlobalActiveAccounts++;
+        // Receipts are what finish a transaction, burners need them as much as plain accounts
+        if (provider)
+        {
+            AccountProviders.Add(account.account, provider);
+        }
     }
 
     account.Address = FDojoModule::AccountAddress(account.account);
@@ -348,129 +466,927 @@ void ADojoHelpers::ControllerCallbackProxy(ControllerAccount *account)
 void ADojoHelpers::ControllerAccountCallback(ControllerAccount *account)
 {
     // Going back to Blueprint thread to broadcast the account
-    Async(EAsyncExecution::TaskGraphMainThread, [this, account]() {
+    TWeakObjectPtr<ADojoHelpers> WeakThis(this);
+    Async(EAsyncExecution::TaskGraphMainThread, [WeakThis, account]() {
+        ADojoHelpers* Self = WeakThis.Get();
+        if (!Self) return;
         FControllerAccount controllerAccount;
         controllerAccount.account = account;
         controllerAccount.Address = FDojoModule::ControllerAccountAddress(account);
-        FOnDojoControllerAccount.Broadcast(controllerAccount);
+        Self->FOnDojoControllerAccount.Broadcast(controllerAccount);
+    });
+}
+
+void ADojoHelpers::ExecuteRawDeprecated(const FAccount& account, const FString& to, const \
+             FString& selector, const FString& calldataParameter)
+{
+    SubmitRaw(account, to, selector, calldataParameter, FOnDojoTransactionSubmitted());
+}
+
+ADojoHelpers::FAccountSubmitState& ADojoHelpers::GetSubmitState(Account* account)
+{
+    check(IsInGameThread());
+    FScopeLock Lock(&SubmitStatesMutex);
+    TUniquePtr<FAccountSubmitState>& State = SubmitStates.FindOrAdd(account);
+    if (!State.IsValid())
+    {
+        State = MakeUnique<FAccountSubmitState>();
+        State->Signer = MakeUnique<FDojoSubmitWorker>(TEXT("DojoSigner"));
+        State->Receipts = MakeUnique<FDojoSubmitWorker>(TEXT("DojoReceipts"));
+    }
+    return *State;
+}
+
+FDojoSubmitWorker& ADojoHelpers::GetControllerWorker(ControllerAccount* account)
+{
+    FScopeLock Lock(&SubmitStatesMutex);
+    TUniquePtr<FDojoSubmitWorker>& Worker = ControllerWorkers.FindOrAdd(account);
+    if (!Worker.IsValid())
+    {
+        Worker = MakeUnique<FDojoSubmitWorker>(TEXT("DojoController"));
+    }
+    return *Worker;
+}
+
+void ADojoHelpers::SubmitRaw(const FAccount& account, const FString& to, const FString& selector, \
+             const FString& calldataParameter, FOnDojoTransactionSubmitted OnSubmitted)
+{
+    FAccountSubmitState* State = &GetSubmitState(account.account);
+    Provider* provider = GetAccountProvider(account.account);
+    TWeakObjectPtr<ADojoHelpers> WeakThis(this);
+    State->Signer->Enqueue([WeakThis, account, provider, to, selector, calldataParameter, State, OnSubmitted]()
+    {
+        TArray<FieldElement> calldata;
+        if (!calldataParameter.IsEmpty()) {
+            TArray<FString> Out;
+            calldataParameter.ParseIntoArray(Out,TEXT(","),true);
+            calldata.Reserve(Out.Num());
+            for (int i = 0; i < Out.Num(); i++) {
+                calldata.Add(ToFieldElement(FFelt252::FromHex(Out[i])));
+            }
+        }
+
+        const std::string selectorStr = TCHAR_TO_UTF8(*selector);
+        TArray<Call> calls;
+        Call& call = calls.AddZeroed_GetRef();
+        call.to = ToFieldElement(FFelt252::FromHex(to));
+        call.selector = selectorStr.c_str();
+        call.calldata.data = calldata.GetData();
+        call.calldata.data_len = calldata.Num();
+        SignAndSend(WeakThis, account, provider, *State, calls, OnSubmitted);
+    });
+}
+
+void ADojoHelpers::SubmitCalls(const FAccount& account, TArray<Call>&& calls, TArray<FieldElement>&& calldata, \
+             FOnDojoTransactionSubmitted OnSubmitted)
+{
+    FAccountSubmitState* State = &GetSubmitState(account.account);
+    Provider* provider = GetAccountProvider(account.account);
+    TWeakObjectPtr<ADojoHelpers> WeakThis(this);
+    State->Signer->Enqueue([WeakThis, account, provider, calls = MoveTemp(calls), calldata = MoveTemp(calldata), State, OnSubmitted]() mutable
+    {
+        // Each Call points at its own range of the one buffer, now that it has stopped moving
+        FieldElement* data = calldata.GetData();
+        for (Call& call : calls)
+        {
+            call.calldata.data = data;
+            data += call.calldata.data_len;
+        }
+        check(data == calldata.GetData() + calldata.Num());
+        SignAndSend(WeakThis, account, provider, *State, calls, OnSubmitted);
+    });
+}
+
+void ADojoHelpers::SignAndSend(TWeakObjectPtr<ADojoHelpers> WeakThis, const FAccount& account, Provider* provider, \
+             FAccountSubmitState& State, const TArray<Call>& calls, const FOnDojoTransactionSubmitted& OnSubmitted)
+{
+    if (!State.bNonceSynced)
+    {
+        FDojoModule::UsePreConfirmedBlock(account.account);
+        State.bNonceSynced = FDojoModule::AccountNonce(account.account, State.NextNonce);
+    }
+
+    FDojoSubmitResult Result;
+    Result.Nonce = State.NextNonce;
+    FieldElement transactionHash;
+    Result.bAccepted = FDojoModule::ExecuteRaw(account.account, calls.GetData(), calls.Num(), &transactionHash);
+    if (Result.bAccepted)
+    {
+        FMemory::Memcpy(Result.TransactionHash.Bytes, transactionHash.data, FFelt252::NumBytes);
+        State.NextNonce++;
+    }
+    else
+    {
+        // Usually a nonce clash (a transaction we didn't count, or one dropped by the node): resync
+        uint64 ChainNonce = 0;
+        if (FDojoModule::AccountNonce(account.account, ChainNonce))
+        {
+            if (ChainNonce != State.NextNonce)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("SubmitRaw: nonce resync %llu -> %llu"), State.NextNonce, ChainNonce);
+            }
+            State.NextNonce = ChainNonce;
+        }
+        else
+        {
+            State.bNonceSynced = false;
+        }
+    }
+
+    if (OnSubmitted.IsBound())
+    {
+        AsyncTask(ENamedThreads::GameThread, [OnSubmitted, Result]()
+        {
+            OnSubmitted.ExecuteIfBound(Result);
+        });
+    }
+
+    if (!Result.bAccepted || !provider) return;
+
+    // On the receipt lane: the next transaction can be signed while this one is pending
+    FDojoSubmitWorker* Lane = State.Receipts.Get();
+    Account* accountPtr = account.account;
+    const bool bNonceKnown = State.bNonceSynced;
+    State.Receipts->Enqueue([WeakThis, accountPtr, provider, transactionHash, Hash = Result.TransactionHash, Nonce = Result.Nonce, bNonceKnown, Lane]()
+    {
+        auto Post = [&WeakThis, &Hash](EDojoTransactionStatus Status)
+        {
+            if (ADojoHelpers* Self = WeakThis.Get())
+            {
+                Self->PostTransactionStatus(Hash, Status);
+            }
+        };
+
+        // wait_for_transaction has no timeout of its own, so it is only called once the account nonce has
+        // moved past this transaction's: it is in a block by then and the receipt comes back promptly.
+        // Until then the nonce is polled here, giving up at the deadline or on teardown. Signed against an
+        // unsynced nonce there is nothing to compare with: Torii's indexing settles it instead.
+        if (!bNonceKnown)
+        {
+            Post(EDojoTransactionStatus::Unknown);
+            return;
+        }
+        const double Deadline = FPlatformTime::Seconds() + RECEIPT_WAIT_SECONDS;
+        for (;;)
+        {
+            if (Lane->IsStopping()) return;
+
+            uint64 ChainNonce = 0;
+            if (FDojoModule::AccountNonce(accountPtr, ChainNonce) && ChainNonce > Nonce) break;
+
+            if (FPlatformTime::Seconds() >= Deadline)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("SubmitRaw: no receipt for %s after %.0fs"), *Hash.ToHex(), RECEIPT_WAIT_SECONDS);
+                Post(EDojoTransactionStatus::Unknown);
+                return;
+            }
+            FPlatformProcess::Sleep(RECEIPT_POLL_SECONDS);
+        }
+
+        bool bSucceeded = false;
+        const bool bKnown = FDojoModule::WaitForTransaction(provider, transactionHash, bSucceeded);
+        Post(!bKnown ? EDojoTransactionStatus::Unknown
+            : bSucceeded ? EDojoTransactionStatus::Succeeded : EDojoTransactionStatus::Reverted);
+    });
+}
+
+static_assert(sizeof(FFelt252) == sizeof(FieldElement), "FFelt252 arrays are copied as FieldElement arrays");
+
+FieldElement ADojoHelpers::ToFieldElement(const FFelt252& Felt)
+{
+    // Same layout: 32 big-endian bytes
+    FieldElement Element;
+    FMemory::Memcpy(Element.data, Felt.Bytes, FFelt252::NumBytes);
+    return Element;
+}
+
+Provider* ADojoHelpers::GetAccountProvider(Account* account)
+{
+    FScopeLock Lock(&ResourceMutex);
+    Provider** Found = AccountProviders.Find(account);
+    return Found ? *Found : nullptr;
+}
+
+void ADojoHelpers::PostTransactionStatus(const FFelt252& TransactionHash, EDojoTransactionStatus Status)
+{
+    TWeakObjectPtr<ADojoHelpers> WeakThis(this);
+    AsyncTask(ENamedThreads::GameThread, [WeakThis, TransactionHash, Status]()
+    {
+        if (ADojoHelpers* Self = WeakThis.Get())
+        {
+            Self->OnTransactionStatus.Broadcast(TransactionHash, Status);
+        }
+    });
+}
+
+void ADojoHelpers::SubscribeTransactions(const FString& SenderAddress)
+{
+    if (toriiClient == nullptr) {
+        UE_LOG(LogTemp, Error, TEXT("SubscribeTransactions: Torii Client is not initialized."));
+        return;
+    }
+    if (SenderAddress.IsEmpty() || (SenderAddress == TransactionSenderAddress && transactionSubscription)) return;
+
+    if (transactionSubscription)
+    {
+        FDojoModule::SubscriptionCancel(transactionSubscription);
+        transactionSubscription = nullptr;
+        GlobalActiveSubscriptions--;
+    }
+    if (resultSubscription)
+    {
+        bPackedActionsResultsLive = false;
+        FDojoModule::SubscriptionCancel(resultSubscription);
+        resultSubscription = nullptr;
+        GlobalActiveSubscriptions--;
+    }
+    TransactionSenderAddress = SenderAddress;
+
+    TWeakObjectPtr<ADojoHelpers> WeakThis(this);
+    ToriiClient* client = toriiClient;
+    Async(EAsyncExecution::Thread, [WeakThis, client, SenderAddress]()
+    {
+        struct ResultSubscription res = FDojoModule::OnTransaction(client, TCHAR_TO_UTF8(*SenderAddress), \
+                 TransactionCallbackProxy);
+
+        TArray<std::string> keys;
+        keys.Add(TCHAR_TO_UTF8(*SenderAddress));
+        keys.Add("");
+        TArray<std::string> models;
+        models.Add("craft_island_pocket-PackedActionsResult");
+        struct ResultSubscription resultRes = FDojoModule::OnEventMessageByKeys(client, keys, models, \
+                 PackedActionsResultCallbackProxy);
+
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, res, resultRes, SenderAddress]()
+        {
+            ADojoHelpers* Self = WeakThis.Get();
+            const bool bOk = res.tag == OkSubscription && res.ok != nullptr;
+            const bool bResultOk = resultRes.tag == OkSubscription && resultRes.ok != nullptr;
+            if (!Self || Self->TransactionSenderAddress != SenderAddress)
+            {
+                if (bOk) FDojoModule::SubscriptionCancel(res.ok);
+                if (bResultOk) FDojoModule::SubscriptionCancel(resultRes.ok);
+                return;
+            }
+
+            if (bOk)
+            {
+                Self->transactionSubscription = res.ok;
+                GlobalActiveSubscriptions++;
+                UE_LOG(LogTemp, Log, TEXT("SubscribeTransactions: following transactions of %s"), *SenderAddress);
+            }
+            else
+            {
+                UE_LOG(LogTemp, Warning, TEXT("SubscribeTransactions: failed, transactions are tracked by receipt only"));
+            }
+
+            if (bResultOk)
+            {
+                Self->resultSubscription = resultRes.ok;
+                Self->bPackedActionsResultsLive = true;
+                GlobalActiveSubscriptions++;
+            }
+            else
+            {
+                UE_LOG(LogTemp, Warning, TEXT("SubscribeTransactions: no per-action results, batches succeed or revert as a whole"));
+            }
+        });
+    });
+}
+
+void ADojoHelpers::PackedActionsResultCallbackProxy(struct FieldElement key, struct CArrayStruct models)
+{
+    ADojoHelpers* SafeInstance = GetGlobalInstance();
+    if (!SafeInstance || !IsValid(SafeInstance) || !models.data)
+    {
+        return;
+    }
+
+    for (int32 Index = 0; Index < models.data_len; ++Index)
+    {
+        Struct* model = &models.data[Index];
+        if (!model->name || strcmp(model->name, "craft_island_pocket-PackedActionsResult") != 0) continue;
+
+        FFelt252 Hash;
+        bool bHasHash = false;
+        TArray<bool> Results;
+        CArrayMember* members = &model->children;
+        for (int k = 0; k < members->data_len; k++) {
+            Member* member = &members->data[k];
+            if (strcmp(member->name, "transaction_hash") == 0 && member->ty->tag == Ty_Tag::Primitive_) {
+                FMemory::Memcpy(Hash.Bytes, member->ty->primitive.felt252.data, FFelt252::NumBytes);
+                bHasHash = true;
+            }
+            else if (strcmp(member->name, "results") == 0 && member->ty->tag == Ty_Tag::Array_) {
+                const CArrayTy& Items = member->ty->array;
+                Results.Reserve(Items.data_len);
+                for (uintptr_t i = 0; i < Items.data_len; i++) {
+                    Results.Add(Items.data[i].tag == Ty_Tag::Primitive_ && Items.data[i].primitive.bool_);
+                }
+            }
+        }
+        FDojoModule::CArrayFree(members->data, members->data_len);
+
+        if (!bHasHash) continue;
+
+        TWeakObjectPtr<ADojoHelpers> WeakThis(SafeInstance);
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, Hash, Results = MoveTemp(Results)]()
+        {
+            if (ADojoHelpers* Self = WeakThis.Get())
+            {
+                Self->OnPackedActionsResult.Broadcast(Hash, Results);
+            }
+        });
+    }
+}
+
+void ADojoHelpers::TransactionCallbackProxy(struct Transaction transaction)
+{
+    ADojoHelpers* SafeInstance = GetGlobalInstance();
+    if (!SafeInstance || !IsValid(SafeInstance))
+    {
+        return;
+    }
+
+    FFelt252 Hash;
+    FMemory::Memcpy(Hash.Bytes, transaction.transaction_hash.data, FFelt252::NumBytes);
+    SafeInstance->PostTransactionStatus(Hash, EDojoTransactionStatus::Indexed);
+}
+
+void ADojoHelpers::ExecuteFromOutside(const FControllerAccount& account, const FString& to, \
+             const FString& selector, const FString& calldataParameter)
+{
+    GetControllerWorker(account.account).Enqueue([account, to, selector, calldataParameter]()
+    {
+        TArray<std::string> felts;
+        if (strcmp(TCHAR_TO_UTF8(*calldataParameter), "") != 0) {
+            TArray<FString> Out;
+            calldataParameter.ParseIntoArray(Out,TEXT(","),true);
+            for (int i = 0; i < Out.Num(); i++) {
+                std::string felt = TCHAR_TO_UTF8(*Out[i]);
+                felts.Add(felt);
+            }
+        }
+        FDojoModule::ExecuteFromOutside(account.account, TCHAR_TO_UTF8(*to), \
+             TCHAR_TO_UTF8(*selector), felts);
+    });
+}
+
+void ADojoHelpers::FetchExistingModels()
+{
+    TWeakObjectPtr<ADojoHelpers> WeakThis(this);
+    ToriiClient* client = toriiClient;
+    Async(EAsyncExecution::Thread, [WeakThis, client]() {
+        UE_LOG(LogTemp, Log, TEXT("FetchExistingModels: Starting to fetch entities"));
+        UE_LOG(LogTemp, Log, TEXT("FetchExistingModels: ToriiClient pointer: %p"), client);
+
+        std::string cursor;
+        int32 pageCount = 0;
+        do {
+            // The actor, and the client it frees, may be torn down between pages (space change, EndPlay)
+            if (!WeakThis.IsValid()) return;
+            ResultPageEntity resEntities = FDojoModule::GetEntities(client, FETCH_PAGE_SIZE, \
+                     cursor.empty() ? nullptr : cursor.c_str());
+            if (resEntities.tag == ErrPageEntity) {
+                UE_LOG(LogTemp, Error, TEXT("FetchExistingModels: Failed to fetch entities: %hs"), \
+                resEntities.err.message);
+                return;
+            }
+
+            CArrayEntity *entities = &resEntities.ok.items;
+            UE_LOG(LogTemp, Log, TEXT("FetchExistingModels: Page %d has %d entities"), pageCount, entities->data_len);
+
+            // Keep the cursor before freeing the page
+            cursor = (resEntities.ok.next_cursor.tag == Somec_char && resEntities.ok.next_cursor.some) \
+                     ? std::string(resEntities.ok.next_cursor.some) : std::string();
+
+            // Parse the whole page across worker threads
+            ADojoHelpers* Self = WeakThis.Get();
+            if (Self)
+            {
+                Self->ParseEntitiesParallel(entities);
+            }
+
+            FDojoModule::CArrayFree(entities->data, entities->data_len);
+            if (!Self) return;
+            pageCount++;
+        } while (!cursor.empty());
+
+        UE_LOG(LogTemp, Log, TEXT("FetchExistingModels: Completed successfully (%d pages)"), pageCount);
+    });
+}
+
+void ADojoHelpers::ExportWorldSnapshot(const FString& Directory)
+{
+    if (toriiClient == nullptr) {
+        UE_LOG(LogTemp, Error, TEXT("ExportWorldSnapshot: Torii Client is not initialized."));
+        return;
+    }
+
+    const FString OutDirectory = Directory.IsEmpty()
+        ? FWorldSnapshotFormat::GetDefaultDirectory(FDateTime::UtcNow().ToString(TEXT("%Y%m%d-%H%M%S")))
+        : Directory;
+
+    TWeakObjectPtr<ADojoHelpers> WeakThis(this);
+    ToriiClient* client = toriiClient;
+    const FString World = WorldAddress;
+    Async(EAsyncExecution::Thread, [WeakThis, client, World, OutDirectory]() {
+        const double StartTime = FPlatformTime::Seconds();
+        FWorldSnapshotWriter Writer;
+
+        // Latest state only: an empty variable-length key clause matches every entity
+        const TArray<std::string> AllKeys;
+        std::string cursor;
+        int32 pageCount = 0;
+        do {
+            // The client goes with the actor: stop if it was torn down between pages
+            if (!WeakThis.IsValid()) {
+                UE_LOG(LogTemp, Warning, TEXT("ExportWorldSnapshot: DojoHelpers destroyed, export abandoned"));
+                return;
+            }
+            ResultPageEntity page = FDojoModule::GetEntitiesByKeys(client, AllKeys, FETCH_PAGE_SIZE, \
+                     cursor.empty() ? nullptr : cursor.c_str());
+            if (page.tag == ErrPageEntity) {
+                UE_LOG(LogTemp, Error, TEXT("ExportWorldSnapshot: Failed to fetch entities: %hs"), page.err.message);
+                return;
+            }
+
+            cursor = (page.ok.next_cursor.tag == Somec_char && page.ok.next_cursor.some) \
+                     ? std::string(page.ok.next_cursor.some) : std::string();
+
+            CArrayEntity *entities = &page.ok.items;
+            for (uintptr_t i = 0; i < entities->data_len; i++) {
+                CArrayStruct* models = &entities->data[i].models;
+                if (!models->data) continue;
+                for (uintptr_t m = 0; m < models->data_len; m++) {
+                    Writer.AppendModel(&models->data[m]);
+                    CArrayMember* members = &models->data[m].children;
+                    FDojoModule::CArrayFree(members->data, members->data_len);
+                }
+                FDojoModule::CArrayFree(models->data, models->data_len);
+            }
+            FDojoModule::CArrayFree(entities->data, entities->data_len);
+            pageCount++;
+        } while (!cursor.empty());
+
+        if (!Writer.Write(OutDirectory, World)) {
+            UE_LOG(LogTemp, Error, TEXT("ExportWorldSnapshot: failed to write %s"), *OutDirectory);
+            return;
+        }
+        UE_LOG(LogTemp, Log, TEXT("ExportWorldSnapshot: %lld rows from %d pages to %s in %.2fs"),
+            Writer.GetNumRows(), pageCount, *OutDirectory, FPlatformTime::Seconds() - StartTime);
+    });
+}
+
+void ADojoHelpers::SubscribeOnDojoModelUpdate()
+{
+    UE_LOG(LogTemp, Log, TEXT("SubscribeOnDojoModelUpdate called"));
+    if (subscribed) {
+        UE_LOG(LogTemp, Warning, TEXT("Warning: cancelled, already subscribed."));
+        return;
+    }
+    if (toriiClient == nullptr) {
+        UE_LOG(LogTemp, Error, TEXT("Error: Torii Client is not initialized."));
+        return;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("Starting subscription in async thread..."));
+
+    // Run subscription in a background thread to avoid blocking the game thread
+    TWeakObjectPtr<ADojoHelpers> WeakThis(this);
+    ToriiClient* client = toriiClient;
+    Async(EAsyncExecution::Thread, [WeakThis, client]() {
+        UE_LOG(LogTemp, Log, TEXT("Async thread: Starting entity subscription"));
+        UE_LOG(LogTemp, Log, TEXT("Async thread: ToriiClient pointer: %p"), client);
+
+        UE_LOG(LogTemp, Log, TEXT("Async thread: About to call FDojoModule::OnEntityUpdate..."));
+        struct ResultSubscription res =
+            FDojoModule::OnEntityUpdate(client, "{}", nullptr, CallbackProxy);
+        UE_LOG(LogTemp, Log, TEXT("Async thread: FDojoModule::OnEntityUpdate returned"));
+
+        // Process result back on game thread
+        Async(EAsyncExecution::TaskGraphMainThread, [WeakThis, res]() {
+            ADojoHelpers* Self = WeakThis.Get();
+            if (!Self)
+            {
+                if (res.tag == OkSubscription && res.ok) FDojoModule::SubscriptionCancel(res.ok);
+                return;
+            }
+
+            // Check if subscription was successful
+            if (res.tag == ErrSubscription)
+            {
+                UE_LOG(LogTemp, Error, TEXT("Failed to create subscription: %hs"), res.err.message);
+                Self->subscribed = false;
+                // A subscription error is a liveness signal too: the supervisor retries with backoff
+                Self->StartConnectionSupervisor();
+                return;
+            }
+
+            if (res.tag == OkSubscription && res.ok != nullptr)
+            {
+                Self->subscription = res.ok;
+                Self->subscribed = true;
+                GlobalActiveSubscriptions++;
+                UE_LOG(LogTemp, Log, TEXT("Entity subscription created successfully"));
+                Self->StartConnectionSupervisor();
+            }
+            else
+            {
+                UE_LOG(LogTemp, Error, TEXT("Subscription returned OK but with null subscription pointer"));
+                Self->subscribed = false;
+            }
+        });
+    });
+}
+
+void ADojoHelpers::SubscribePlayerModels(const FString& PlayerAddress)
+{
+    if (toriiClient == nullptr) {
+        UE_LOG(LogTemp, Error, TEXT("SubscribePlayerModels: Torii Client is not initialized."));
+        return;
+    }
+    if (PlayerAddress.IsEmpty()) return;
+    if (PlayerAddress == PlayerLaneAddress && playerSubscription) return;
+
+    PlayerLaneAddress = PlayerAddress;
+    PlayerLaneOwner = FFelt252::FromHex(PlayerAddress);
+    SubscribePlayerLane(playerSubscription != nullptr);
+}
+
+void ADojoHelpers::SubscribePlayerLane(bool bResubscribe)
+{
+    // Until the new subscription is live the bulk lane keeps delivering player models
+    bPlayerLaneSubscribed = false;
+    if (bResubscribe && playerSubscription)
+    {
+        FDojoModule::SubscriptionCancel(playerSubscription);
+        playerSubscription = nullptr;
+        GlobalActiveSubscriptions--;
+    }
+
+    TWeakObjectPtr<ADojoHelpers> WeakThis(this);
+    ToriiClient* client = toriiClient;
+    const FString Address = PlayerLaneAddress;
+    Async(EAsyncExecution::Thread, [WeakThis, client, Address]()
+    {
+        TArray<std::string> keys;
+        keys.Add(TCHAR_TO_UTF8(*Address));
+
+        TArray<std::string> models;
+        models.Add("craft_island_pocket-Inventory");
+        models.Add("craft_island_pocket-PlayerData");
+        models.Add("craft_island_pocket-PlayerStats");
+        models.Add("craft_island_pocket-ProcessingLock");
+
+        struct ResultSubscription res = FDojoModule::OnEntityUpdateByKeys(client, keys, models, PlayerCallbackProxy);
+
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, res, Address]()
+        {
+            ADojoHelpers* Self = WeakThis.Get();
+            const bool bOk = res.tag == OkSubscription && res.ok != nullptr;
+            if (!Self || Self->PlayerLaneAddress != Address)
+            {
+                // Destroyed or superseded by another player while subscribing
+                if (bOk) FDojoModule::SubscriptionCancel(res.ok);
+                return;
+            }
+            if (!bOk)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("SubscribePlayerModels: failed, player models stay on the bulk lane"));
+                return;
+            }
+
+            Self->playerSubscription = res.ok;
+            GlobalActiveSubscriptions++;
+            Self->bPlayerLaneSubscribed = true;
+            UE_LOG(LogTemp, Log, TEXT("SubscribePlayerModels: player lane subscribed for %s"), *Address);
+        });
+    });
+}
+
+bool ADojoHelpers::IsPlayerLaneModel(const UDojoModel* Model, EDojoModelKind Kind) const
+{
+    switch (Kind)
+    {
+    case EDojoModelKind::Inventory:
+        return FFelt252::FromHex(static_cast<const UDojoModelCraftIslandPocketInventory*>(Model)->Owner) == PlayerLaneOwner;
+    case EDojoModelKind::PlayerData:
+        return FFelt252::FromHex(static_cast<const UDojoModelCraftIslandPocketPlayerData*>(Model)->Player) == PlayerLaneOwner;
+    case EDojoModelKind::PlayerStats:
+        return FFelt252::FromHex(static_cast<const UDojoModelCraftIslandPocketPlayerStats*>(Model)->Player) == PlayerLaneOwner;
+    case EDojoModelKind::ProcessingLock:
+        return FFelt252::FromHex(static_cast<const UDojoModelCraftIslandPocketProcessingLock*>(Model)->Player) == PlayerLaneOwner;
+    default:
+        return false;
+    }
+}
+
+int32 ADojoHelpers::DrainIngest(double BudgetSeconds)
+{
+    check(IsInGameThread());
+
+    const double Deadline = FPlatformTime::Seconds() + BudgetSeconds;
+    int32 Drained = 0;
+    UDojoModel* Model = nullptr;
+
+    // Player lane is small and latency-sensitive: no budget, but bounded to one ring's worth per frame
+    const uint32 PlayerCapacity = PlayerRing->Capacity();
+    for (uint32 Count = 0; Count < PlayerCapacity && PlayerRing->Pop(Model); Count++)
+    {
+        if (IsValid(Model))
+        {
+            OnDojoModelUpdated.Broadcast(Model);
+            OnDojoModelIngested.Broadcast(Model);
+        }
+        EndHandOff(Model);
+        Drained++;
+    }
+
+    bool bBulkDrained = true;
+    while (IngestRing->Pop(Model))
+    {
+        // Models stay GC-protected until their receivers have them (see EndHandOff)
+        if (IsValid(Model))
+        {
+            OnDojoModelUpdated.Broadcast(Model);
+            OnDojoModelIngested.Broadcast(Model);
+        }
+        EndHandOff(Model);
+        Drained++;
+
+        // Check the clock every few models, broadcasting is cheap compared to FPlatformTime
+        if ((Drained & 15) == 0 && FPlatformTime::Seconds() >= Deadline)
+        {
+            bBulkDrained = false;
+            break;
+        }
+    }
+
+    // Refetch what a full ring made us drop, once there's room for it again
+    if (bBulkDrained && bUndeliveredPending.exchange(false))
+    {
+        TArray<TArray<FString>> Prefixes;
+        {
+            FScopeLock Lock(&UndeliveredMutex);
+            Prefixes = MoveTemp(UndeliveredPrefixes);
+            UndeliveredPrefixes.Reset();
+        }
+        if (Prefixes.Num() > 0)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("DrainIngest: refetching %d key prefixes dropped by a full ring"), Prefixes.Num());
+            FetchKeyPrefixesAsync(Prefixes);
+        }
+    }
+    return Drained;
+}
+
+bool ADojoHelpers::PushModel(TDojoMpscRing<UDojoModel*>& Ring, UDojoModel* Model)
+{
+    if (Ring.Push(Model))
+    {
+        return true;
+    }
+    UE_LOG(LogTemp, Verbose, TEXT("PushModel: %s ring full, dropped %s for refetch"),
+        &Ring == PlayerRing.Get() ? TEXT("player") : TEXT("ingest"), *Model->DojoModelType);
+    DiscardUndelivered(Model);
+    return false;
+}
+
+void ADojoHelpers::DiscardUndelivered(UDojoModel* Model)
+{
+    // Chunk-scoped models are refetched per space, player-scoped ones per owner
+    FDojoModelKey Key;
+    if (FDojoModelKey::FromModel(Model, Key))
+    {
+        TArray<FString> Prefix = { Key.Owner.ToHex() };
+        if (Key.Kind == EDojoModelKind::IslandChunk || Key.Kind == EDojoModelKind::GatherableResource ||
+            Key.Kind == EDojoModelKind::WorldStructure)
+        {
+            Prefix.Add(FString::Printf(TEXT("0x%x"), Key.Id));
+        }
+
+        FScopeLock Lock(&UndeliveredMutex);
+        UndeliveredPrefixes.AddUnique(MoveTemp(Prefix));
+        bUndeliveredPending = true;
+    }
+
+    // Nothing references it now; once out of the hand-off GC takes it back
+    EndHandOff(Model);
+}
+
+FDojoIngestStats ADojoHelpers::GetIngestStats() const
+{
+    return IngestRing ? IngestRing->GetStats() : FDojoIngestStats();
+}
+
+FDojoIngestStats ADojoHelpers::GetPlayerIngestStats() const
+{
+    return PlayerRing ? PlayerRing->GetStats() : FDojoIngestStats();
+}
+
+void ADojoHelpers::StartConnectionSupervisor()
+{
+    LastStreamActivity = FPlatformTime::Seconds();
+    if (!HealthCheckTimerHandle.IsValid())
+    {
+        GetWorldTimerManager().SetTimer(HealthCheckTimerHandle, this, &ADojoHelpers::CheckConnectionHealth,
+            HEALTH_CHECK_INTERVAL, true);
+    }
+}
+
+void ADojoHelpers::SetGapFillInterest(const TArray<TArray<FString>>& KeyPrefixes)
+{
+    FScopeLock Lock(&GapFillMutex);
+    GapFillInterest = KeyPrefixes;
+}
+
+void ADojoHelpers::CheckConnectionHealth()
+{
+    if (bReconnecting || bProbeInFlight) return;
+
+    if (!subscribed)
+    {
+        ScheduleReconnect();
+        return;
+    }
+
+    // A quiet stream is normal (an idle world sends nothing): silence only decides when to probe,
+    // the probe alone decides whether the subscription is lost
+    const double Now = FPlatformTime::Seconds();
+    if (Now - LastStreamActivity < STREAM_IDLE_PROBE_SECONDS || Now - LastProbeSuccess < STREAM_IDLE_PROBE_SECONDS) return;
+
+    bProbeInFlight = true;
+    TWeakObjectPtr<ADojoHelpers> WeakThis(this);
+    ToriiClient* client = toriiClient;
+    struct Subscription* sub = subscription;
+    Async(EAsyncExecution::Thread, [WeakThis, client, sub]()
+    {
+        // Torii must answer a query, and still know our subscription: it may serve queries
+        // after dropping the stream, and dojo.c reports no stream errors to the callback
+        ResultPageEntity probe = FDojoModule::GetEntities(client, 1, nullptr);
+        bool bHealthy = probe.tag == OkPageEntity;
+        if (bHealthy)
+        {
+            FDojoModule::CArrayFree(probe.ok.items.data, probe.ok.items.data_len);
+            bHealthy = FDojoModule::PingEntitySubscription(client, sub);
+        }
+
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, bHealthy]()
+        {
+            ADojoHelpers* Self = WeakThis.Get();
+            if (!Self) return;
+
+            // LastStreamActivity is left to the stream callbacks; a healthy probe holds off the next one
+            Self->bProbeInFlight = false;
+            if (bHealthy)
+            {
+                Self->LastProbeSuccess = FPlatformTime::Seconds();
+            }
+            else
+            {
+                UE_LOG(LogTemp, Warning, TEXT("DojoHelpers: Torii probe failed or subscription unknown, resubscribing"));
+                Self->subscribed = false;
+                Self->ScheduleReconnect();
+            }
+        });
     });
 }
 
-void ADojoHelpers::ExecuteRawDeprecated(const FAccount& account, const FString& to, const \
-             FString& selector, const FString& calldataParameter)
+void ADojoHelpers::ScheduleReconnect()
 {
-    Async(EAsyncExecution::Thread, [this, account, to, selector, calldataParameter]()
-    {
-        TArray<std::string> felts;
-        if (strcmp(TCHAR_TO_UTF8(*calldataParameter), "") != 0) {
-            TArray<FString> Out;
-            calldataParameter.ParseIntoArray(Out,TEXT(","),true);
-            for (int i = 0; i < Out.Num(); i++) {
-                std::string felt = TCHAR_TO_UTF8(*Out[i]);
-                felts.Add(felt);
-            }
-        }
-        FDojoModule::ExecuteRaw(account.account, TCHAR_TO_UTF8(*to), TCHAR_TO_UTF8(*selector), \
-             felts);
-    });
+    bReconnecting = true;
+
+    // Exponential backoff with +-20% jitter so clients don't reconnect in lockstep
+    const float Backoff = RECONNECT_BASE_DELAY * static_cast<float>(1 << FMath::Min(ReconnectAttempt, 6));
+    const float Delay = FMath::Min(Backoff, RECONNECT_MAX_DELAY) * FMath::FRandRange(0.8f, 1.2f);
+    ReconnectAttempt++;
+
+    UE_LOG(LogTemp, Warning, TEXT("DojoHelpers: reconnect attempt %d in %.1fs"), ReconnectAttempt, Delay);
+    GetWorldTimerManager().SetTimer(ReconnectTimerHandle, this, &ADojoHelpers::AttemptReconnect, Delay, false);
 }
 
-void ADojoHelpers::ExecuteFromOutside(const FControllerAccount& account, const FString& to, \
-             const FString& selector, const FString& calldataParameter)
+void ADojoHelpers::AttemptReconnect()
 {
-    Async(EAsyncExecution::Thread, [this, account, to, selector, calldataParameter]()
+    // A probe still running holds the subscription pointer: cancel only once it has returned
+    if (bProbeInFlight)
     {
-        TArray<std::string> felts;
-        if (strcmp(TCHAR_TO_UTF8(*calldataParameter), "") != 0) {
-            TArray<FString> Out;
-            calldataParameter.ParseIntoArray(Out,TEXT(","),true);
-            for (int i = 0; i < Out.Num(); i++) {
-                std::string felt = TCHAR_TO_UTF8(*Out[i]);
-                felts.Add(felt);
-            }
-        }
-        FDojoModule::ExecuteFromOutside(account.account, TCHAR_TO_UTF8(*to), \
-             TCHAR_TO_UTF8(*selector), felts);
-    });
-}
+        GetWorldTimerManager().SetTimer(ReconnectTimerHandle, this, &ADojoHelpers::AttemptReconnect, 0.1f, false);
+        return;
+    }
 
-void ADojoHelpers::FetchExistingModels()
-{
-    Async(EAsyncExecution::Thread, [this]() {
-        UE_LOG(LogTemp, Log, TEXT("FetchExistingModels: Starting to fetch entities"));
-        UE_LOG(LogTemp, Log, TEXT("FetchExistingModels: ToriiClient pointer: %p"), toriiClient);
+    if (subscription)
+    {
+        FDojoModule::SubscriptionCancel(subscription);
+        subscription = nullptr;
+        GlobalActiveSubscriptions--;
+    }
+    subscribed = false;
 
-        ResultPageEntity resEntities = FDojoModule::GetEntities(toriiClient, 1000, nullptr);
-        if (resEntities.tag == ErrPageEntity) {
-            UE_LOG(LogTemp, Error, TEXT("FetchExistingModels: Failed to fetch entities: %hs"), \
-            resEntities.err.message);
-            return;
+    TWeakObjectPtr<ADojoHelpers> WeakThis(this);
+    ToriiClient* client = toriiClient;
+    Async(EAsyncExecution::Thread, [WeakThis, client]()
+    {
+        // Don't bother resubscribing until Torii answers queries again
+        ResultPageEntity probe = FDojoModule::GetEntities(client, 1, nullptr);
+        struct ResultSubscription res;
+        res.tag = ErrSubscription;
+        if (probe.tag == OkPageEntity)
+        {
+            FDojoModule::CArrayFree(probe.ok.items.data, probe.ok.items.data_len);
+            res = FDojoModule::OnEntityUpdate(client, "{}", nullptr, CallbackProxy);
         }
 
-        UE_LOG(LogTemp, Log, TEXT("FetchExistingModels: Successfully fetched entities"));
-        CArrayEntity *entities = &resEntities.ok.items;
-        UE_LOG(LogTemp, Log, TEXT("FetchExistingModels: Processing %d entities"), entities->data_len);
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, res]()
+        {
+            ADojoHelpers* Self = WeakThis.Get();
+            if (!Self)
+            {
+                if (res.tag == OkSubscription && res.ok) FDojoModule::SubscriptionCancel(res.ok);
+                return;
+            }
+
+            if (res.tag != OkSubscription || res.ok == nullptr)
+            {
+                Self->ScheduleReconnect();
+                return;
+            }
+
+            Self->subscription = res.ok;
+            Self->subscribed = true;
+            GlobalActiveSubscriptions++;
+            Self->bReconnecting = false;
+            Self->ReconnectAttempt = 0;
+            Self->LastStreamActivity = FPlatformTime::Seconds();
+            UE_LOG(LogTemp, Log, TEXT("DojoHelpers: resubscribed to Torii, running gap-fill"));
 
-        for (int i = 0; i < entities->data_len; i++) {
-            UE_LOG(LogTemp, Log, TEXT("FetchExistingModels: Processing entity %d of %d"), i + 1, entities->data_len);
-            CArrayStruct* models = &entities->data[i].models;
-            UE_LOG(LogTemp, Log, TEXT("FetchExistingModels: Entity %d has %d models"), i, models->data_len);
-            this->ParseModelsAndSend(models);
-        }
+            if (!Self->PlayerLaneAddress.IsEmpty())
+            {
+                Self->SubscribePlayerLane(true);
+            }
 
-        UE_LOG(LogTemp, Log, TEXT("FetchExistingModels: Cleaning up entity data"));
-        FDojoModule::CArrayFree(entities->data, entities->data_len);
-        UE_LOG(LogTemp, Log, TEXT("FetchExistingModels: Completed successfully"));
+            // Updates sent while we were disconnected are lost; refetch only what we care about
+            Self->RunGapFill();
+        });
     });
 }
 
-void ADojoHelpers::SubscribeOnDojoModelUpdate()
+void ADojoHelpers::RunGapFill()
 {
-    UE_LOG(LogTemp, Log, TEXT("SubscribeOnDojoModelUpdate called"));
-    if (subscribed) {
-        UE_LOG(LogTemp, Warning, TEXT("Warning: cancelled, already subscribed."));
-        return;
+    TArray<TArray<FString>> Interest;
+    {
+        FScopeLock Lock(&GapFillMutex);
+        Interest = GapFillInterest;
     }
-    if (toriiClient == nullptr) {
-        UE_LOG(LogTemp, Error, TEXT("Error: Torii Client is not initialized."));
+    // Interest is registered before the first subscribe; without any there is nothing on screen to refetch
+    if (Interest.Num() == 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("RunGapFill: no interest registered, nothing refetched"));
         return;
     }
 
-    UE_LOG(LogTemp, Log, TEXT("Starting subscription in async thread..."));
-
-    // Run subscription in a background thread to avoid blocking the game thread
-    Async(EAsyncExecution::Thread, [this]() {
-        UE_LOG(LogTemp, Log, TEXT("Async thread: Starting entity subscription"));
-        UE_LOG(LogTemp, Log, TEXT("Async thread: ToriiClient pointer: %p"), toriiClient);
+    FetchKeyPrefixesAsync(Interest);
+}
 
-        UE_LOG(LogTemp, Log, TEXT("Async thread: About to call FDojoModule::OnEntityUpdate..."));
-        struct ResultSubscription res =
-            FDojoModule::OnEntityUpdate(toriiClient, "{}", nullptr, CallbackProxy);
-        UE_LOG(LogTemp, Log, TEXT("Async thread: FDojoModule::OnEntityUpdate returned"));
+void ADojoHelpers::RefetchKeyPrefix(const TArray<FString>& KeyPrefix)
+{
+    FetchKeyPrefixesAsync({ KeyPrefix });
+}
 
-        // Process result back on game thread
-        Async(EAsyncExecution::TaskGraphMainThread, [this, res]() {
-            // Check if subscription was successful
-            if (res.tag == ErrSubscription)
+void ADojoHelpers::FetchKeyPrefixesAsync(const TArray<TArray<FString>>& Prefixes)
+{
+    TWeakObjectPtr<ADojoHelpers> WeakThis(this);
+    ToriiClient* client = toriiClient;
+    Async(EAsyncExecution::Thread, [WeakThis, client, Prefixes]()
+    {
+        for (const TArray<FString>& Prefix : Prefixes)
+        {
+            TArray<std::string> keys;
+            for (const FString& Key : Prefix)
             {
-                UE_LOG(LogTemp, Error, TEXT("Failed to create subscription: %hs"), res.err.message);
-                subscribed = false;
-                return;
+                keys.Add(TCHAR_TO_UTF8(*Key));
             }
 
-            if (res.tag == OkSubscription && res.ok != nullptr)
-            {
-                subscription = res.ok;
-                subscribed = true;
-                GlobalActiveSubscriptions++;
-                UE_LOG(LogTemp, Log, TEXT("Entity subscription created successfully"));
-            }
-            else
-            {
-                UE_LOG(LogTemp, Error, TEXT("Subscription returned OK but with null subscription pointer"));
-                subscribed = false;
-            }
-        });
+            std::string cursor;
+            do {
+                ResultPageEntity page = FDojoModule::GetEntitiesByKeys(client, keys, FETCH_PAGE_SIZE, \
+                         cursor.empty() ? nullptr : cursor.c_str());
+                if (page.tag == ErrPageEntity) break;
+
+                cursor = (page.ok.next_cursor.tag == Somec_char && page.ok.next_cursor.some) \
+                         ? std::string(page.ok.next_cursor.some) : std::string();
+
+                // The actor may be torn down between pages (space change, EndPlay)
+                ADojoHelpers* Self = WeakThis.Get();
+                if (Self)
+                {
+                    Self->ParseEntitiesParallel(&page.ok.items);
+                }
+                FDojoModule::CArrayFree(page.ok.items.data, page.ok.items.data_len);
+                if (!Self) return;
+            } while (!cursor.empty());
+        }
+        UE_LOG(LogTemp, Log, TEXT("FetchKeyPrefixes: refetched %d key prefixes"), Prefixes.Num());
     });
 }
 
@@ -483,9 +1399,25 @@ void ADojoHelpers::CallbackProxy(struct FieldElement key, struct CArrayStruct mo
         return;
     }
 
+    SafeInstance->LastStreamActivity = FPlatformTime::Seconds();
+
     SafeInstance->ParseModelsAndSend(&models);
 }
 
+void ADojoHelpers::PlayerCallbackProxy(struct FieldElement key, struct CArrayStruct models)
+{
+    ADojoHelpers* SafeInstance = GetGlobalInstance();
+    if (!SafeInstance || !IsValid(SafeInstance))
+    {
+        UE_LOG(LogTemp, Error, TEXT("PlayerCallbackProxy: SafeInstance is null or invalid"));
+        return;
+    }
+
+    SafeInstance->LastStreamActivity = FPlatformTime::Seconds();
+
+    SafeInstance->ParseModelsAndSend(&models, true);
+}
+
 template<typename T>
 static void ConvertTyToUnrealEngineType(const Member* member, const char* expectedName, const \
              char* expectedType, T& output);
@@ -716,9 +1648,75 @@ static void ConvertTyToUnrealEngineType(const Member* member, const char* expect
 
 
 
+template<typename T>
+T* ADojoHelpers::NewPooledModel()
+{
+    {
+        FScopeLock Lock(&ModelPoolMutex);
+        TArray<UDojoModel*>* Pool = ModelPool.Find(T::StaticClass());
+        if (Pool && Pool->Num() > 0)
+        {
+            // Referenced from the pool or the hand-off set at every instant, both reported by AddReferencedObjects
+            // under this lock: an Async flag set after the pop could miss a reachability pass already under way
+            UDojoModel* Model = Pool->Pop(EAllowShrinking::No);
+            PooledInHandOff.Add(Model);
+            ModelsReused.fetch_add(1, std::memory_order_relaxed);
+            return static_cast<T*>(Model);
+        }
+    }
+    // Created off the game thread, a new object is flagged Async (GC-protected) until EndHandOff
+    return NewObject<T>(GetTransientPackage());
+}
+
+void ADojoHelpers::EndHandOff(UDojoModel* Model)
+{
+    Model->AtomicallyClearInternalFlags(EInternalObjectFlags::Async);
+
+    FScopeLock Lock(&ModelPoolMutex);
+    PooledInHandOff.Remove(Model);
+}
+
+void ADojoHelpers::RecycleModel(UDojoModel* Model)
+{
+    check(IsInGameThread());
+    if (!IsValid(Model)) return;
+
+    // Blueprint listeners may still hold it: leave it to GC rather than overwrite it under them
+    if (OnDojoModelUpdated.IsBound() && !bRecycleWithBlueprintListeners) return;
+
+    // Back to defaults so a model missing a member never inherits a stale value
+    UClass* Class = Model->GetClass();
+    const UObject* Defaults = Class->GetDefaultObject();
+    for (TFieldIterator<FProperty> It(Class); It; ++It)
+    {
+        It->CopyCompleteValue_InContainer(Model, Defaults);
+    }
+
+    FScopeLock Lock(&ModelPoolMutex);
+    TArray<UDojoModel*>& Pool = ModelPool.FindOrAdd(Class);
+    if (Pool.Num() < MODEL_POOL_CAPACITY_PER_CLASS)
+    {
+        Pool.Add(Model);
+    }
+}
+
+void ADojoHelpers::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+    ADojoHelpers* This = CastChecked<ADojoHelpers>(InThis);
+    {
+        FScopeLock Lock(&This->ModelPoolMutex);
+        for (TPair<UClass*, TArray<UDojoModel*>>& Pair : This->ModelPool)
+        {
+            Collector.AddReferencedObjects(Pair.Value, This);
+        }
+        Collector.AddReferencedObjects(This->PooledInHandOff, This);
+    }
+    Super::AddReferencedObjects(InThis, Collector);
+}
+
 UDojoModel* ADojoHelpers::parseCraftIslandPocketGatherableResourceModel(struct Struct* model)
 {
-    UDojoModelCraftIslandPocketGatherableResource* Model = NewObject<UDojoModelCraftIslandPocketGatherableResource>(GetTransientPackage());
+    UDojoModelCraftIslandPocketGatherableResource* Model = NewPooledModel<UDojoModelCraftIslandPocketGatherableResource>();
     CArrayMember* members = &model->children;
 
     for (int k = 0; k < members->data_len; k++) {
@@ -743,7 +1741,7 @@ UDojoModel* ADojoHelpers::parseCraftIslandPocketGatherableResourceModel(struct S
 
 UDojoModel* ADojoHelpers::parseCraftIslandPocketInventoryModel(struct Struct* model)
 {
-    UDojoModelCraftIslandPocketInventory* Model = NewObject<UDojoModelCraftIslandPocketInventory>(GetTransientPackage());
+    UDojoModelCraftIslandPocketInventory* Model = NewPooledModel<UDojoModelCraftIslandPocketInventory>();
     CArrayMember* members = &model->children;
 
     for (int k = 0; k < members->data_len; k++) {
@@ -766,7 +1764,7 @@ UDojoModel* ADojoHelpers::parseCraftIslandPocketInventoryModel(struct Struct* mo
 
 UDojoModel* ADojoHelpers::parseCraftIslandPocketIslandChunkModel(struct Struct* model)
 {
-    UDojoModelCraftIslandPocketIslandChunk* Model = NewObject<UDojoModelCraftIslandPocketIslandChunk>(GetTransientPackage());
+    UDojoModelCraftIslandPocketIslandChunk* Model = NewPooledModel<UDojoModelCraftIslandPocketIslandChunk>();
     CArrayMember* members = &model->children;
 
     for (int k = 0; k < members->data_len; k++) {
@@ -785,7 +1783,7 @@ UDojoModel* ADojoHelpers::parseCraftIslandPocketIslandChunkModel(struct Struct*
 
 UDojoModel* ADojoHelpers::parseCraftIslandPocketPlayerDataModel(struct Struct* model)
 {
-    UDojoModelCraftIslandPocketPlayerData* Model = NewObject<UDojoModelCraftIslandPocketPlayerData>(GetTransientPackage());
+    UDojoModelCraftIslandPocketPlayerData* Model = NewPooledModel<UDojoModelCraftIslandPocketPlayerData>();
     CArrayMember* members = &model->children;
 
     for (int k = 0; k < members->data_len; k++) {
@@ -806,7 +1804,7 @@ UDojoModel* ADojoHelpers::parseCraftIslandPocketPlayerDataModel(struct Struct* m
 
 UDojoModel* ADojoHelpers::parseCraftIslandPocketPlayerStatsModel(struct Struct* model)
 {
-    UDojoModelCraftIslandPocketPlayerStats* Model = NewObject<UDojoModelCraftIslandPocketPlayerStats>(GetTransientPackage());
+    UDojoModelCraftIslandPocketPlayerStats* Model = NewPooledModel<UDojoModelCraftIslandPocketPlayerStats>();
     CArrayMember* members = &model->children;
 
     for (int k = 0; k < members->data_len; k++) {
@@ -826,7 +1824,7 @@ UDojoModel* ADojoHelpers::parseCraftIslandPocketPlayerStatsModel(struct Struct*
 
 UDojoModel* ADojoHelpers::parseCraftIslandPocketWorldStructureModel(struct Struct* model)
 {
-    UDojoModelCraftIslandPocketWorldStructure* Model = NewObject<UDojoModelCraftIslandPocketWorldStructure>(GetTransientPackage());
+    UDojoModelCraftIslandPocketWorldStructure* Model = NewPooledModel<UDojoModelCraftIslandPocketWorldStructure>();
     CArrayMember* members = &model->children;
 
     for (int k = 0; k < members->data_len; k++) {
@@ -849,7 +1847,7 @@ UDojoModel* ADojoHelpers::parseCraftIslandPocketWorldStructureModel(struct Struc
 
 UDojoModel* ADojoHelpers::parseCraftIslandPocketProcessingLockModel(struct Struct* model)
 {
-    UDojoModelCraftIslandPocketProcessingLock* Model = NewObject<UDojoModelCraftIslandPocketProcessingLock>(GetTransientPackage());
+    UDojoModelCraftIslandPocketProcessingLock* Model = NewPooledModel<UDojoModelCraftIslandPocketProcessingLock>();
     CArrayMember* members = &model->children;
 
     for (int k = 0; k < members->data_len; k++) {
@@ -864,7 +1862,72 @@ UDojoModel* ADojoHelpers::parseCraftIslandPocketProcessingLockModel(struct Struc
     return Model;
 }
 
-void ADojoHelpers::ParseModelsAndSend(struct CArrayStruct* models)
+UDojoModel* ADojoHelpers::ParseModel(struct Struct* model, EDojoModelKind& OutKind)
+{
+    OutKind = EDojoModelKind::Unknown;
+
+    const char* ModelName = model->name;
+    if (!ModelName)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ParseModel: null model name"));
+        return nullptr;
+    }
+
+    UDojoModel* ParsedModel = nullptr;
+
+    if (strcmp(ModelName, "craft_island_pocket-GatherableResource") == 0)
+    {
+        OutKind = EDojoModelKind::GatherableResource;
+        ParsedModel = ADojoHelpers::parseCraftIslandPocketGatherableResourceModel(model);
+    }
+    else if (strcmp(ModelName, "craft_island_pocket-Inventory") == 0)
+    {
+        OutKind = EDojoModelKind::Inventory;
+        ParsedModel = ADojoHelpers::parseCraftIslandPocketInventoryModel(model);
+    }
+    else if (strcmp(ModelName, "craft_island_pocket-IslandChunk") == 0)
+    {
+        OutKind = EDojoModelKind::IslandChunk;
+        ParsedModel = ADojoHelpers::parseCraftIslandPocketIslandChunkModel(model);
+    }
+    else if (strcmp(ModelName, "craft_island_pocket-PlayerData") == 0)
+    {
+        OutKind = EDojoModelKind::PlayerData;
+        ParsedModel = ADojoHelpers::parseCraftIslandPocketPlayerDataModel(model);
+    }
+    else if (strcmp(ModelName, "craft_island_pocket-PlayerStats") == 0)
+    {
+        OutKind = EDojoModelKind::PlayerStats;
+        ParsedModel = ADojoHelpers::parseCraftIslandPocketPlayerStatsModel(model);
+    }
+    else if (strcmp(ModelName, "craft_island_pocket-WorldStructure") == 0)
+    {
+        OutKind = EDojoModelKind::WorldStructure;
+        ParsedModel = ADojoHelpers::parseCraftIslandPocketWorldStructureModel(model);
+    }
+    else if (strcmp(ModelName, "craft_island_pocket-ProcessingLock") == 0)
+    {
+        OutKind = EDojoModelKind::ProcessingLock;
+        ParsedModel = ADojoHelpers::parseCraftIslandPocketProcessingLockModel(model);
+    }
+    else
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ParseModel: Unknown model type %s"), UTF8_TO_TCHAR(ModelName));
+        return nullptr;
+    }
+
+    if (ParsedModel)
+    {
+        ParsedModel->DojoModelType = ModelName;
+    }
+    else
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ParseModel: Failed to parse model %s"), UTF8_TO_TCHAR(ModelName));
+    }
+    return ParsedModel;
+}
+
+void ADojoHelpers::ParseModelsAndSend(struct CArrayStruct* models, bool bPlayerLane)
 {
     if (!models || !models->data)
     {
@@ -872,100 +1935,122 @@ void ADojoHelpers::ParseModelsAndSend(struct CArrayStruct* models)
         return;
     }
 
-    TArray<UDojoModel*> ParsedModels;
-    ParsedModels.Reserve(models->data_len);
-
+    const bool bPlayerLaneLive = bPlayerLaneSubscribed;
+    TArray<UDojoModel*> Delivered;
+    Delivered.Reserve(models->data_len);
     for (int32 Index = 0; Index < models->data_len; ++Index)
     {
-        const char* ModelName = models->data[Index].name;
-        if (!ModelName)
+        EDojoModelKind Kind;
+        UDojoModel* Model = ParseModel(&models->data[Index], Kind);
+        if (!Model) continue;
+
+        // The player lane already delivers these; a second, budget-delayed copy could overwrite a newer state
+        if (!bPlayerLane && bPlayerLaneLive && IsPlayerLaneModel(Model, Kind))
         {
-            UE_LOG(LogTemp, Warning, TEXT("ParseModelsAndSend: null model name (%d)"), Index);
+            EndHandOff(Model);
+            PlayerModelsDedupedFromBulk++;
             continue;
         }
+        Delivered.Add(Model);
+    }
 
-        UDojoModel* ParsedModel = nullptr;
+    // Record before handing off: once pushed, the game thread owns the models
+    if (SessionRecorder->IsRecording())
+    {
+        SessionRecorder->Record(bPlayerLane ? EDojoSessionLane::Player : EDojoSessionLane::Bulk, Delivered);
+    }
 
-        if (strcmp(ModelName, "craft_island_pocket-GatherableResource") == 0)
-        {
-            ParsedModel = \
-                     ADojoHelpers::parseCraftIslandPocketGatherableResourceModel(&\
-                     models->data[Index]);
-        }
-        else if (strcmp(ModelName, "craft_island_pocket-Inventory") == 0)
-        {
-            ParsedModel = \
-                     ADojoHelpers::parseCraftIslandPocketInventoryModel(&\
-                     models->data[Index]);
-        }
-        else if (strcmp(ModelName, "craft_island_pocket-IslandChunk") == 0)
-        {
-            ParsedModel = \
-                     ADojoHelpers::parseCraftIslandPocketIslandChunkModel(&\
-                     models->data[Index]);
-        }
-        else if (strcmp(ModelName, "craft_island_pocket-PlayerData") == 0)
-        {
-            ParsedModel = \
-                     ADojoHelpers::parseCraftIslandPocketPlayerDataModel(&\
-                     models->data[Index]);
-        }
-        else if (strcmp(ModelName, "craft_island_pocket-PlayerStats") == 0)
-        {
-            ParsedModel = \
-                     ADojoHelpers::parseCraftIslandPocketPlayerStatsModel(&\
-                     models->data[Index]);
-        }
-        else if (strcmp(ModelName, "craft_island_pocket-WorldStructure") == 0)
-        {
-            ParsedModel = \
-                     ADojoHelpers::parseCraftIslandPocketWorldStructureModel(&\
-                     models->data[Index]);
-        }
-        else if (strcmp(ModelName, "craft_island_pocket-ProcessingLock") == 0)
-        {
-            ParsedModel = \
-                     ADojoHelpers::parseCraftIslandPocketProcessingLockModel(&\
-                     models->data[Index]);
-        }
-        else
-        {
-            UE_LOG(LogTemp, Warning, TEXT("ParseModelsAndSend: Unknown model type %s"), \
-             UTF8_TO_TCHAR(ModelName));
-            continue;
-        }
+    // Hand off to the game thread through the bounded rings (drained once per frame)
+    TDojoMpscRing<UDojoModel*>& Ring = bPlayerLane ? *PlayerRing : *IngestRing;
+    for (UDojoModel* Model : Delivered)
+    {
+        PushModel(Ring, Model);
+    }
+
+    // Cleanup
+    FDojoModule::CArrayFree(models->data, models->data_len);
+}
+
+void ADojoHelpers::ParseEntitiesParallel(struct CArrayEntity* entities)
+{
+    const int32 NumEntities = static_cast<int32>(entities->data_len);
+    if (NumEntities == 0) return;
 
-        if (ParsedModel)
+    constexpr int32 NumKinds = static_cast<int32>(EDojoModelKind::ProcessingLock) + 1;
+    const int32 NumTasks = FMath::DivideAndRoundUp(NumEntities, PARSE_ENTITIES_PER_TASK);
+
+    // One output shard per (task, model kind): workers never share an array
+    TArray<TArray<UDojoModel*>> Shards;
+    Shards.SetNum(NumTasks * NumKinds);
+
+    ParallelFor(NumTasks, [this, entities, NumEntities, &Shards](int32 TaskIndex)
+    {
+        const int32 First = TaskIndex * PARSE_ENTITIES_PER_TASK;
+        const int32 Last = FMath::Min(First + PARSE_ENTITIES_PER_TASK, NumEntities);
+        for (int32 EntityIndex = First; EntityIndex < Last; EntityIndex++)
         {
-            ParsedModel->DojoModelType = ModelName;
-            ParsedModels.Add(ParsedModel);
+            CArrayStruct* models = &entities->data[EntityIndex].models;
+            if (!models->data) continue;
+
+            for (uintptr_t ModelIndex = 0; ModelIndex < models->data_len; ModelIndex++)
+            {
+                EDojoModelKind Kind;
+                if (UDojoModel* Model = ParseModel(&models->data[ModelIndex], Kind))
+                {
+                    Shards[TaskIndex * NumKinds + static_cast<int32>(Kind)].Add(Model);
+                }
+            }
+            FDojoModule::CArrayFree(models->data, models->data_len);
         }
-        else
+    });
+
+    // Player-scoped models first so the manager knows the current space before world data lands
+    static const EDojoModelKind PushOrder[] = {
+        EDojoModelKind::PlayerData,
+        EDojoModelKind::Inventory,
+        EDojoModelKind::ProcessingLock,
+        EDojoModelKind::PlayerStats,
+        EDojoModelKind::IslandChunk,
+        EDojoModelKind::GatherableResource,
+        EDojoModelKind::WorldStructure,
+    };
+
+    const bool bPlayerLaneLive = bPlayerLaneSubscribed;
+    const bool bRecording = SessionRecorder->IsRecording();
+    TArray<UDojoModel*> Recorded;
+    int32 NumModels = 0;
+    for (EDojoModelKind Kind : PushOrder)
+    {
+        for (int32 TaskIndex = 0; TaskIndex < NumTasks; TaskIndex++)
         {
-            UE_LOG(LogTemp, Warning, TEXT("ParseModelsAndSend: Failed to parse model %s"), \
-             UTF8_TO_TCHAR(ModelName));
+            const TArray<UDojoModel*>& Shard = Shards[TaskIndex * NumKinds + static_cast<int32>(Kind)];
+            if (bRecording)
+            {
+                Recorded.Append(Shard);
+            }
+            NumModels += Shard.Num();
         }
     }
 
-    if (ParsedModels.Num() > 0)
+    // Record before handing off: once pushed, the game thread owns the models
+    if (bRecording)
     {
-        AsyncTask(ENamedThreads::GameThread, [this, ParsedModels = MoveTemp(ParsedModels)]()
+        SessionRecorder->Record(EDojoSessionLane::Fetch, Recorded);
+    }
+
+    for (EDojoModelKind Kind : PushOrder)
+    {
+        for (int32 TaskIndex = 0; TaskIndex < NumTasks; TaskIndex++)
         {
-            for (UDojoModel* Model : ParsedModels)
+            for (UDojoModel* Model : Shards[TaskIndex * NumKinds + static_cast<int32>(Kind)])
             {
-                if (IsValid(Model))
-                {
-                    OnDojoModelUpdated.Broadcast(Model);
-                }
+                // Fetched snapshots of our own models jump the world-data queue too
+                PushModel(bPlayerLaneLive && IsPlayerLaneModel(Model, Kind) ? *PlayerRing : *IngestRing, Model);
             }
-        });
+        }
     }
 
-    // Cleanup
-    if (models->data)
-    {
-        FDojoModule::CArrayFree(models->data, models->data_len);
-    }
+    UE_LOG(LogTemp, Log, TEXT("ParseEntitiesParallel: %d entities -> %d models over %d tasks"), NumEntities, NumModels, NumTasks);
 }
 
 
@@ -1066,15 +2151,80 @@ void ADojoHelpers::CallControllerCraftIslandPocketActionsExecuteCompressedAction
 }
 
 void ADojoHelpers::CallCraftIslandPocketActionsExecutePackedActions(const FAccount& account, const TArray<FString>& packed_data) {
-    TArray<FString> args;
-    // Format as array: [len, item1, item2, ...]
-    args.Add(FString::FromInt(packed_data.Num()));
+    TArray<FFelt252> felts;
+    felts.Reserve(packed_data.Num());
     for (const FString& PackedFelt : packed_data)
     {
-        args.Add(PackedFelt);
+        felts.Add(FFelt252::FromHex(PackedFelt));
     }
-    this->ExecuteRawDeprecated(account, this->ContractsAddresses["craft_island_pocket-actions"], \
-                     TEXT("execute_packed_actions"), FString::Join(args, TEXT(",")));
+    SubmitPackedActions(account, felts, FOnDojoTransactionSubmitted());
+}
+
+void ADojoHelpers::SubmitPackedActions(const FAccount& account, const TArray<FFelt252>& packed_data, FOnDojoTransactionSubmitted OnSubmitted) {
+    SubmitActions(account, packed_data, TArray<FDojoCall>(), OnSubmitted);
+}
+
+void ADojoHelpers::SubmitActions(const FAccount& account, const TArray<FFelt252>& packed_data, const TArray<FDojoCall>& calls, \
+             FOnDojoTransactionSubmitted OnSubmitted) {
+    const FFelt252* contract = ContractFelts.Find(TEXT("craft_island_pocket-actions"));
+    if (!contract)
+    {
+        UE_LOG(LogTemp, Error, TEXT("SubmitActions: actions contract address not set"));
+        OnSubmitted.ExecuteIfBound(FDojoSubmitResult());
+        return;
+    }
+    if (packed_data.Num() == 0 && calls.Num() == 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("SubmitActions: nothing to send"));
+        OnSubmitted.ExecuteIfBound(FDojoSubmitResult());
+        return;
+    }
+
+    // Every call's calldata written once, straight from the felts, into the buffer the transaction is signed from
+    int32 calldataLen = packed_data.Num() > 0 ? packed_data.Num() + 1 : 0;
+    for (const FDojoCall& call : calls)
+    {
+        calldataLen += call.Calldata.Num();
+    }
+    TArray<FieldElement> calldata;
+    calldata.Reserve(calldataLen);
+
+    TArray<Call> rawCalls;
+    rawCalls.Reserve(calls.Num() + 1);
+    const FieldElement to = ToFieldElement(*contract);
+    auto AddCall = [&rawCalls, &to](const char* selector, int32 len)
+    {
+        Call& rawCall = rawCalls.AddZeroed_GetRef();
+        rawCall.to = to;
+        rawCall.selector = selector;
+        rawCall.calldata.data_len = len;
+    };
+    if (packed_data.Num() > 0)
+    {
+        // Serialized Array<felt252>: [len, item1, item2, ...]
+        calldata.Add(ToFieldElement(FFelt252::FromUint64(packed_data.Num())));
+        calldata.Append(reinterpret_cast<const FieldElement*>(packed_data.GetData()), packed_data.Num());
+        AddCall("execute_packed_actions", packed_data.Num() + 1);
+    }
+    for (const FDojoCall& call : calls)
+    {
+        calldata.Append(reinterpret_cast<const FieldElement*>(call.Calldata.GetData()), call.Calldata.Num());
+        AddCall(call.Selector, call.Calldata.Num());
+    }
+    SubmitCalls(account, MoveTemp(rawCalls), MoveTemp(calldata), OnSubmitted);
+}
+
+TArray<FFelt252> ADojoHelpers::SerializeByteArray(const FString& value) {
+    TArray<FFelt252> felts;
+    struct ResultCArrayFieldElement serializedResult = FDojoModule::SerializeByteArray(value);
+    if (serializedResult.tag != OkCArrayFieldElement) {
+        return felts;
+    }
+
+    felts.SetNumUninitialized(serializedResult.ok.data_len);
+    FMemory::Memcpy(felts.GetData(), serializedResult.ok.data, felts.Num() * sizeof(FieldElement));
+    FDojoModule::CArrayFree(serializedResult.ok.data, serializedResult.ok.data_len);
+    return felts;
 }
 
 void ADojoHelpers::CallControllerCraftIslandPocketActionsExecutePackedActions(const FControllerAccount& account, const TArray<FString>& packed_data) {
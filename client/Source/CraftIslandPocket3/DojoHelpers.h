@@ -4,8 +4,13 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "HAL/ThreadSafeCounter.h"
 #include "DojoModule.h"
 #include "Account.h"
+#include "DojoIngestRing.h"
+#include "DojoModelKey.h"
+#include "DojoSessionLog.h"
+#include "DojoSubmitWorker.h"
 #include "DojoHelpers.generated.h"
 
 UCLASS(BlueprintType)
@@ -256,6 +261,45 @@ public:
     int BatchesProcessed;
 };
 
+// Outcome of handing a transaction to the account, reported on the game thread
+struct FDojoSubmitResult
+{
+    bool bAccepted = false;
+
+    // Nonce the transaction was signed with (our local count, resynchronised on rejection)
+    uint64 Nonce = 0;
+
+    // Set when accepted; later status updates for this transaction carry the same hash
+    FFelt252 TransactionHash;
+};
+
+DECLARE_DELEGATE_OneParam(FOnDojoTransactionSubmitted, const FDojoSubmitResult&);
+
+// One call on the actions contract: selector (a string literal) and its serialized arguments
+struct FDojoCall
+{
+    const char* Selector = nullptr;
+    TArray<FFelt252> Calldata;
+};
+
+// Where one of our accepted transactions stands. Indexed and the receipt can arrive in either order.
+enum class EDojoTransactionStatus : uint8
+{
+    Indexed,    // Torii saw it (client_on_transaction)
+    Succeeded,  // Receipt: executed
+    Reverted,   // Receipt: reverted, none of its effects happened
+    Unknown     // No receipt status: RPC error, wait abandoned, or reverted (dojo.c tells these apart by message only)
+};
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnDojoTransactionStatus, const FFelt252& /*TransactionHash*/, EDojoTransactionStatus);
+
+// execute_packed_actions outcome (PackedActionsResult event): one flag per packed action, in packing order
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnDojoPackedActionsResult, const FFelt252& /*TransactionHash*/, const TArray<bool>& /*Results*/);
+
+// Models as they leave the ingest rings. Transient: the receiver merges them and may hand them back to
+// the parser pool (ADojoHelpers::RecycleModel), so nothing may keep the pointer past the broadcast.
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnDojoModelIngested, UDojoModel* /*Model*/);
+
 // RAII wrapper for Dojo resources
 template<typename T>
 struct TDojoDeleter
@@ -285,6 +329,10 @@ private:
 
     // To initialize using SetContractsAddresses
     TMap<FString, FString> ContractsAddresses;
+    // Same addresses parsed once, for the binary submission path
+    TMap<FString, FFelt252> ContractFelts;
+
+    FString WorldAddress;
 
     bool subscribed;
 
@@ -293,17 +341,104 @@ private:
     static ADojoHelpers* Instance;
     static FCriticalSection InstanceMutex;
 
+    // Parsed models pushed by Torii threads, drained on the game thread by DrainIngest
+    TUniquePtr<TDojoMpscRing<UDojoModel*>> IngestRing;
+
+    // Low-latency lane: the local player's own models, on their own subscription and ring.
+    // Drained completely every frame ahead of the budgeted bulk lane.
+    TUniquePtr<TDojoMpscRing<UDojoModel*>> PlayerRing;
+    struct Subscription* playerSubscription = nullptr;
+    std::atomic<bool> bPlayerLaneSubscribed{false};
+    FString PlayerLaneAddress;
+    FFelt252 PlayerLaneOwner;
+    std::atomic<uint64> PlayerModelsDedupedFromBulk{0};
+
+    void SubscribePlayerLane(bool bResubscribe);
+
+    // True for Inventory / PlayerData / PlayerStats / ProcessingLock models owned by the local player
+    bool IsPlayerLaneModel(const UDojoModel* Model, EDojoModelKind Kind) const;
+
+    // Any thread, never waits: hands Model to the game thread, or gives it up (DiscardUndelivered) when Ring is full
+    bool PushModel(TDojoMpscRing<UDojoModel*>& Ring, UDojoModel* Model);
+
+    // Any thread: a model that never reached the game thread. GC may take it back, and the key prefix
+    // of its entity is refetched once the bulk lane has drained, so the update it carried isn't lost.
+    void DiscardUndelivered(UDojoModel* Model);
+
+    TArray<TArray<FString>> UndeliveredPrefixes;
+    FCriticalSection UndeliveredMutex;
+    std::atomic<bool> bUndeliveredPending{false};
+
+    // Connection supervisor: health-checks the subscription and reconnects with backoff
+    // Last update delivered by a subscription (stream callbacks and a fresh subscribe only)
+    std::atomic<double> LastStreamActivity{0.0};
+    // Last time Torii answered a health probe and still knew our subscription
+    double LastProbeSuccess = 0.0;
+    std::atomic<bool> bProbeInFlight{false};
+    bool bReconnecting = false;
+    int32 ReconnectAttempt = 0;
+    FTimerHandle HealthCheckTimerHandle;
+    FTimerHandle ReconnectTimerHandle;
+
+    // Key prefixes re-queried after a reconnect (e.g. {player}, {space owner, space id})
+    TArray<TArray<FString>> GapFillInterest;
+    FCriticalSection GapFillMutex;
+
+    void StartConnectionSupervisor();
+    void CheckConnectionHealth();
+    void ScheduleReconnect();
+    void AttemptReconnect();
+    void RunGapFill();
+    void FetchKeyPrefixesAsync(const TArray<TArray<FString>>& Prefixes);
+
     // Track allocated accounts for cleanup
     TArray<Account*> AllocatedAccounts;
     TArray<Provider*> AllocatedProviders;
+    TMap<Account*, Provider*> AccountProviders;
     FCriticalSection ResourceMutex;
 
+    Provider* GetAccountProvider(Account* account);
+
+    // Our own transactions as Torii indexes them
+    struct Subscription* transactionSubscription = nullptr;
+    struct Subscription* resultSubscription = nullptr;
+    std::atomic<bool> bPackedActionsResultsLive{false};
+    FString TransactionSenderAddress;
+
+    static void TransactionCallbackProxy(struct Transaction transaction);
+
+    static void PackedActionsResultCallbackProxy(struct FieldElement key, struct CArrayStruct models);
+
+    // Any thread: reports to OnTransactionStatus on the game thread
+    void PostTransactionStatus(const FFelt252& TransactionHash, EDojoTransactionStatus Status);
+
     void ControllerAccountCallback(ControllerAccount *account);
 
     static void ControllerCallbackProxy(ControllerAccount *account);
 
     static void CallbackProxy(struct FieldElement key, struct CArrayStruct models);
 
+    static void PlayerCallbackProxy(struct FieldElement key, struct CArrayStruct models);
+
+    // Writes every delivered batch to a session log while recording
+    TUniquePtr<FDojoSessionRecorder> SessionRecorder;
+
+    // Model objects handed back by the entity table, reused by the parsers instead of allocating.
+    // A model taken off the pool moves to PooledInHandOff under the same lock, so GC sees it referenced
+    // without a gap until the game thread has broadcast or given it up (EndHandOff).
+    FCriticalSection ModelPoolMutex;
+    TMap<UClass*, TArray<UDojoModel*>> ModelPool;
+    TSet<UDojoModel*> PooledInHandOff;
+    static constexpr int32 MODEL_POOL_CAPACITY_PER_CLASS = 4096;
+    std::atomic<uint64> ModelsReused{0};
+
+    // Any thread: a recycled model of class T, or a new one
+    template<typename T>
+    T* NewPooledModel();
+
+    // Any thread: Model reached the game thread or was given up; nothing but its receivers protects it from GC now
+    void EndHandOff(UDojoModel* Model);
+
     UDojoModel* parseCraftIslandPocketGatherableResourceModel(struct Struct* model);
     UDojoModel* parseCraftIslandPocketInventoryModel(struct Struct* model);
     UDojoModel* parseCraftIslandPocketIslandChunkModel(struct Struct* model);
@@ -312,7 +447,16 @@ private:
     UDojoModel* parseCraftIslandPocketWorldStructureModel(struct Struct* model);
     UDojoModel* parseCraftIslandPocketProcessingLockModel(struct Struct* model);
 
-    void ParseModelsAndSend(struct CArrayStruct *models);
+    // Parses one model struct; thread-safe, OutKind tells the caller which shard it belongs to
+    UDojoModel* ParseModel(struct Struct* model, EDojoModelKind& OutKind);
+
+    void ParseModelsAndSend(struct CArrayStruct *models, bool bPlayerLane = false);
+
+    // Parses a page of entities with ParallelFor, sharded per model type, then pushes to the ingest ring
+    void ParseEntitiesParallel(struct CArrayEntity* entities);
+
+    static constexpr int32 PARSE_ENTITIES_PER_TASK = 64;
+    static constexpr int32 FETCH_PAGE_SIZE = 1000;
 
     void ExecuteFromOutside(const FControllerAccount& account,
                             const FString& to,
@@ -324,6 +468,62 @@ private:
                               const FString& selector,
                               const FString& calldataParameter);
 
+    void SubmitRaw(const FAccount& account,
+                   const FString& to,
+                   const FString& selector,
+                   const FString& calldataParameter,
+                   FOnDojoTransactionSubmitted OnSubmitted);
+
+    // Per-account submission lanes. Signing runs on one thread, so nonces are taken one at a time against
+    // the pre-confirmed block and several transactions can be in flight with consecutive nonces.
+    // Receipts are awaited in the same order on a second thread, so signing never waits for a block.
+    struct FAccountSubmitState
+    {
+        // Signing lane only
+        uint64 NextNonce = 0;
+        bool bNonceSynced = false;
+
+        TUniquePtr<FDojoSubmitWorker> Signer;
+        TUniquePtr<FDojoSubmitWorker> Receipts;
+
+        // Signing jobs enqueue into the receipt lane: join the signer first, while Receipts is still there
+        ~FAccountSubmitState()
+        {
+            Signer.Reset();
+            Receipts.Reset();
+        }
+    };
+
+    TMap<Account*, TUniquePtr<FAccountSubmitState>> SubmitStates;
+    FCriticalSection SubmitStatesMutex;
+
+    // The receipt lane polls the account nonce every RECEIPT_POLL_SECONDS before reading a receipt, and reports
+    // the transaction as unknown once RECEIPT_WAIT_SECONDS pass without it being included
+    static constexpr double RECEIPT_WAIT_SECONDS = 30.0;
+    static constexpr float RECEIPT_POLL_SECONDS = 0.25f;
+
+    // Game thread only. The state is heap allocated, so the reference survives other accounts being added,
+    // and states are only destroyed by CleanupResources, on the game thread as well.
+    FAccountSubmitState& GetSubmitState(Account* account);
+
+    // Outside executions of a controller account, sent in order from one thread
+    TMap<ControllerAccount*, TUniquePtr<FDojoSubmitWorker>> ControllerWorkers;
+
+    FDojoSubmitWorker& GetControllerWorker(ControllerAccount* account);
+
+    // Binary submission: the calls go out in order as one transaction. Their calldata follow each other in
+    // calldata, calldata.data_len for each call; the pointers are set on the signing lane.
+    void SubmitCalls(const FAccount& account, TArray<Call>&& calls, TArray<FieldElement>&& calldata,
+                     FOnDojoTransactionSubmitted OnSubmitted);
+
+    // Signing lane part shared by SubmitRaw and SubmitCalls: signs with the next nonce,
+    // reports acceptance, then hands the receipt wait to the receipt lane
+    static void SignAndSend(TWeakObjectPtr<ADojoHelpers> WeakThis, const FAccount& account, Provider* provider,
+                            FAccountSubmitState& State, const TArray<Call>& calls,
+                            const FOnDojoTransactionSubmitted& OnSubmitted);
+
+    static FieldElement ToFieldElement(const FFelt252& Felt);
+
 public:
     ADojoHelpers();
     ~ADojoHelpers();
@@ -337,6 +537,28 @@ public:
     // Resource cleanup methods
     void CleanupResources();
 
+    // Game thread: status changes of the transactions sent through SubmitPackedActions
+    FOnDojoTransactionStatus OnTransactionStatus;
+
+    // Game thread: per-action results of our execute_packed_actions calls
+    FOnDojoPackedActionsResult OnPackedActionsResult;
+
+    // True while PackedActionsResult events are subscribed: an executed batch then waits for its results
+    bool HasPackedActionsResults() const { return bPackedActionsResultsLive; }
+
+    // Follows the transactions sent by SenderAddress on Torii (Indexed updates) and their PackedActionsResult events
+    void SubscribeTransactions(const FString& SenderAddress);
+
+    static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
+
+    // Game thread: returns a model nobody references any more (a superseded update) to the parser pool.
+    // Does nothing while OnDojoModelUpdated is bound, unless bRecycleWithBlueprintListeners says its
+    // listeners don't keep the models they were given.
+    void RecycleModel(UDojoModel* Model);
+
+    // Game thread: every model drained from the ingest rings, see FOnDojoModelIngested
+    FOnDojoModelIngested OnDojoModelIngested;
+
     // Resource tracking for debugging
     UFUNCTION(BlueprintCallable, Category = "Dojo Debug")
     void LogResourceUsage() const;
@@ -347,12 +569,50 @@ public:
     UFUNCTION(BlueprintCallable)
     void SetContractsAddresses(const TMap<FString,FString>& addresses);
 
+    // Records every model batch delivered from Torii (stream, player lane, fetches) for later replay
+    UFUNCTION(BlueprintCallable, Category = "Dojo Debug")
+    bool StartSessionRecording(const FString& Path, const FString& PlayerAddress);
+
+    UFUNCTION(BlueprintCallable, Category = "Dojo Debug")
+    void StopSessionRecording();
+
     UFUNCTION(BlueprintCallable)
     void FetchExistingModels();
 
+    // Pages every entity into a columnar snapshot (see WorldSnapshot.h), off the game thread.
+    // Empty Directory writes to Saved/DojoSnapshots/<timestamp>.
+    UFUNCTION(BlueprintCallable, Category = "Dojo Debug")
+    void ExportWorldSnapshot(const FString& Directory);
+
     UFUNCTION(BlueprintCallable)
     void SubscribeOnDojoModelUpdate();
 
+    // Opens the low-latency lane for this player's Inventory, PlayerData, PlayerStats and ProcessingLock
+    UFUNCTION(BlueprintCallable)
+    void SubscribePlayerModels(const FString& PlayerAddress);
+
+    // Game thread: broadcasts the whole player lane, then bulk models until the ring is empty
+    // or the budget is spent. Returns the number of models broadcast.
+    int32 DrainIngest(double BudgetSeconds);
+
+    FDojoIngestStats GetIngestStats() const;
+    FDojoIngestStats GetPlayerIngestStats() const;
+
+    // Keys the client cares about; only these are refetched after a reconnect.
+    // Each entry is a key prefix matched with VariableLen, hex felts.
+    void SetGapFillInterest(const TArray<TArray<FString>>& KeyPrefixes);
+
+    // Pages every entity matching KeyPrefix (same format as SetGapFillInterest) into the ingest ring
+    void RefetchKeyPrefix(const TArray<FString>& KeyPrefix);
+
+    static constexpr float HEALTH_CHECK_INTERVAL = 5.0f;
+    static constexpr double STREAM_IDLE_PROBE_SECONDS = 20.0;
+    static constexpr float RECONNECT_BASE_DELAY = 1.0f;
+    static constexpr float RECONNECT_MAX_DELAY = 60.0f;
+
+    static constexpr uint32 INGEST_RING_CAPACITY = 16384;
+    static constexpr uint32 PLAYER_RING_CAPACITY = 1024;
+
     UFUNCTION(BlueprintCallable)
     FAccount CreateAccountDeprecated(const FString& rpc_url,
                                      const FString& address,
@@ -365,9 +625,16 @@ public:
 
     DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnDojoModelUpdated, UDojoModel*, Model);
 
+    // The same models for Blueprints. Listeners own what they receive: models are not reused while this is bound,
+    // unless bRecycleWithBlueprintListeners is set.
     UPROPERTY(BlueprintAssignable)
     FOnDojoModelUpdated OnDojoModelUpdated;
 
+    // Set when every OnDojoModelUpdated listener copies what it needs during the broadcast instead of keeping
+    // the model: the parser pool then stays on with Blueprint listeners bound, and a kept model may be overwritten.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool bRecycleWithBlueprintListeners = false;
+
     // CONTROLLER
     UFUNCTION(BlueprintCallable)
     void ControllerGetAccountOrConnect(const FString& rpc_url, const FString& chain_id);
@@ -416,6 +683,18 @@ public:
     
     UFUNCTION(BlueprintCallable, Category = "Calls")
     void CallCraftIslandPocketActionsExecutePackedActions(const FAccount& account, const TArray<FString>& packed_data);
+
+    // Same call from already packed felts, reporting whether the account accepted it and with which nonce
+    void SubmitPackedActions(const FAccount& account, const TArray<FFelt252>& packed_data, FOnDojoTransactionSubmitted OnSubmitted);
+
+    // One transaction for several actions entrypoints: execute_packed_actions with packed_data (left out when empty),
+    // then each of calls on the actions contract, in order. All calldata is copied once, into the buffer signed from.
+    // Any failing call reverts the whole transaction, packed actions included.
+    void SubmitActions(const FAccount& account, const TArray<FFelt252>& packed_data, const TArray<FDojoCall>& calls,
+                       FOnDojoTransactionSubmitted OnSubmitted);
+
+    // Cairo ByteArray serialization of value, as calldata (empty on failure)
+    static TArray<FFelt252> SerializeByteArray(const FString& value);
     
     UFUNCTION(BlueprintCallable, Category = "Controller Calls")
     void CallControllerCraftIslandPocketActionsExecutePackedActions(const FControllerAccount& account, const TArray<FString>& packed_data);
@@ -0,0 +1,250 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ChunkDiskCache.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "DojoModule.h"
+
+namespace
+{
+    // Model strings are fixed-width hex ("0x" + 2 chars per byte), keep only the low bytes
+    void HexToBytes(const FString& Hex, uint8* Out, int32 NumBytes)
+    {
+        const FFelt252 Felt = FFelt252::FromHex(Hex);
+        FMemory::Memcpy(Out, Felt.Bytes + FFelt252::NumBytes - NumBytes, NumBytes);
+    }
+
+    FString BytesToHex(const uint8* Bytes, int32 NumBytes)
+    {
+        return FDojoModule::bytes_to_fstring(Bytes, NumBytes, true);
+    }
+
+    template<typename T>
+    void AppendRecord(TArray<uint8>& Buffer, const T& Record)
+    {
+        Buffer.Append(reinterpret_cast<const uint8*>(&Record), sizeof(T));
+    }
+}
+
+FString FChunkDiskCache::GetCachePath(const FString& WorldAddress, const FSpaceKey& Space)
+{
+    const FString World = FFelt252::FromHex(WorldAddress).ToHex();
+    const FString FileName = FString::Printf(TEXT("%s_%s_%d.bin"), *World, *Space.Owner.ToHex(), Space.Id);
+    return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("DojoCache"), FileName);
+}
+
+bool FChunkDiskCache::Save(const FString& WorldAddress, const FSpaceKey& Space, const FSpaceChunks& Data)
+{
+    FHeader Header;
+    FMemory::Memzero(&Header, sizeof(Header));
+    Header.Magic = MAGIC;
+    Header.FormatVersion = FORMAT_VERSION;
+    FMemory::Memcpy(Header.WorldAddress, FFelt252::FromHex(WorldAddress).Bytes, 32);
+    FMemory::Memcpy(Header.Owner, Space.Owner.Bytes, 32);
+    Header.SpaceId = Space.Id;
+
+    TArray<uint8> Buffer;
+    Buffer.Reserve(sizeof(FHeader)
+        + Data.Chunks.Num() * sizeof(FChunkRecord)
+        + Data.Gatherables.Num() * sizeof(FGatherableRecord)
+        + Data.Structures.Num() * sizeof(FStructureRecord));
+    Buffer.AddZeroed(sizeof(FHeader));
+
+    for (const auto& Pair : Data.Chunks)
+    {
+        const FCompactChunk& Chunk = Pair.Value;
+
+        FChunkRecord Record;
+        Pair.Key.ToBytes(Record.ChunkId);
+        Record.Version = Chunk.Version;
+        FMemory::Memcpy(Record.Blocks1, Chunk.Blocks, 16);
+        FMemory::Memcpy(Record.Blocks2, Chunk.Blocks + 16, 16);
+        AppendRecord(Buffer, Record);
+        Header.NumChunks++;
+    }
+
+    for (const auto& Pair : Data.Gatherables)
+    {
+        const UDojoModelCraftIslandPocketGatherableResource* Gatherable = Pair.Value;
+        if (!Gatherable) continue;
+
+        FGatherableRecord Record;
+        HexToBytes(Gatherable->ChunkId, Record.ChunkId, 16);
+        Record.Position = static_cast<uint8>(Gatherable->Position);
+        Record.ResourceId = static_cast<uint16>(Gatherable->ResourceId);
+        Record.PlantedAt = Gatherable->PlantedAt;
+        Record.NextHarvestAt = Gatherable->NextHarvestAt;
+        Record.HarvestedAt = Gatherable->HarvestedAt;
+        Record.MaxHarvest = static_cast<uint8>(Gatherable->MaxHarvest);
+        Record.RemainedHarvest = static_cast<uint8>(Gatherable->RemainedHarvest);
+        Record.Destroyed = Gatherable->Destroyed ? 1 : 0;
+        Record.Tier = static_cast<uint8>(Gatherable->Tier);
+        AppendRecord(Buffer, Record);
+        Header.NumGatherables++;
+    }
+
+    for (const auto& Pair : Data.Structures)
+    {
+        const UDojoModelCraftIslandPocketWorldStructure* Structure = Pair.Value;
+        if (!Structure) continue;
+
+        FStructureRecord Record;
+        HexToBytes(Structure->ChunkId, Record.ChunkId, 16);
+        Record.Position = static_cast<uint8>(Structure->Position);
+        Record.StructureType = static_cast<uint16>(Structure->StructureType);
+        Record.BuildInventoryId = static_cast<uint16>(Structure->BuildInventoryId);
+        Record.Completed = Structure->Completed ? 1 : 0;
+        HexToBytes(Structure->LinkedSpaceOwner, Record.LinkedSpaceOwner, 32);
+        Record.LinkedSpaceId = static_cast<uint16>(Structure->LinkedSpaceId);
+        Record.Destroyed = Structure->Destroyed ? 1 : 0;
+        AppendRecord(Buffer, Record);
+        Header.NumStructures++;
+    }
+
+    FMemory::Memcpy(Buffer.GetData(), &Header, sizeof(FHeader));
+
+    const FString Path = GetCachePath(WorldAddress, Space);
+    const FString TempPath = Path + TEXT(".tmp");
+    if (!FFileHelper::SaveArrayToFile(Buffer, *TempPath))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ChunkDiskCache: failed to write %s"), *TempPath);
+        return false;
+    }
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    PlatformFile.DeleteFile(*Path);
+    if (!PlatformFile.MoveFile(*Path, *TempPath))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ChunkDiskCache: failed to move %s into place"), *TempPath);
+        return false;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("ChunkDiskCache: saved space %s (%u chunks, %u gatherables, %u structures, %d bytes)"),
+        *Space.ToString(), Header.NumChunks, Header.NumGatherables, Header.NumStructures, Buffer.Num());
+    return true;
+}
+
+bool FChunkDiskCache::Load(const FString& WorldAddress, const FSpaceKey& Space, FSpaceChunks& OutSpace, TArray<UDojoModel*>& OutModels)
+{
+    const FString Path = GetCachePath(WorldAddress, Space);
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    if (!PlatformFile.FileExists(*Path))
+    {
+        return false;
+    }
+
+    // Prefer mapping the file; fall back to a plain read on platforms without mapping support
+    FOpenMappedResult MappedResult = PlatformFile.OpenMappedEx(*Path);
+    if (MappedResult.HasValue())
+    {
+        TUniquePtr<IMappedFileHandle> MappedFile = MappedResult.StealValue();
+        TUniquePtr<IMappedFileRegion> Region(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+        if (Region)
+        {
+            return Decode(Region->GetMappedPtr(), Region->GetMappedSize(), WorldAddress, Space, OutSpace, OutModels);
+        }
+    }
+
+    TArray<uint8> Buffer;
+    if (!FFileHelper::LoadFileToArray(Buffer, *Path))
+    {
+        return false;
+    }
+    return Decode(Buffer.GetData(), Buffer.Num(), WorldAddress, Space, OutSpace, OutModels);
+}
+
+bool FChunkDiskCache::Decode(const uint8* Data, int64 Size, const FString& WorldAddress, const FSpaceKey& Space, FSpaceChunks& OutSpace, TArray<UDojoModel*>& OutModels)
+{
+    if (Size < static_cast<int64>(sizeof(FHeader)))
+    {
+        return false;
+    }
+
+    FHeader Header;
+    FMemory::Memcpy(&Header, Data, sizeof(FHeader));
+    if (Header.Magic != MAGIC || Header.FormatVersion != FORMAT_VERSION
+        || FMemory::Memcmp(Header.WorldAddress, FFelt252::FromHex(WorldAddress).Bytes, 32) != 0
+        || FMemory::Memcmp(Header.Owner, Space.Owner.Bytes, 32) != 0
+        || Header.SpaceId != Space.Id)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ChunkDiskCache: ignoring stale or foreign cache for space %s"), *Space.ToString());
+        return false;
+    }
+
+    const int64 ExpectedSize = sizeof(FHeader)
+        + static_cast<int64>(Header.NumChunks) * sizeof(FChunkRecord)
+        + static_cast<int64>(Header.NumGatherables) * sizeof(FGatherableRecord)
+        + static_cast<int64>(Header.NumStructures) * sizeof(FStructureRecord);
+    if (Size != ExpectedSize)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ChunkDiskCache: truncated cache for space %s (%lld/%lld bytes)"), *Space.ToString(), Size, ExpectedSize);
+        return false;
+    }
+
+    const FString OwnerHex = BytesToHex(Space.Owner.Bytes, 32);
+    const uint8* Cursor = Data + sizeof(FHeader);
+    OutSpace.Chunks.Reserve(OutSpace.Chunks.Num() + Header.NumChunks);
+    OutModels.Reserve(OutModels.Num() + Header.NumGatherables + Header.NumStructures);
+
+    for (uint32 i = 0; i < Header.NumChunks; i++, Cursor += sizeof(FChunkRecord))
+    {
+        FChunkRecord Record;
+        FMemory::Memcpy(&Record, Cursor, sizeof(Record));
+
+        // Same layout as the cache entry, no model object needed
+        FCompactChunk Chunk;
+        FMemory::Memcpy(Chunk.Blocks, Record.Blocks1, 16);
+        FMemory::Memcpy(Chunk.Blocks + 16, Record.Blocks2, 16);
+        Chunk.Version = Record.Version;
+        OutSpace.AddChunk(FChunkKey::FromBytes(Record.ChunkId), Chunk);
+    }
+
+    for (uint32 i = 0; i < Header.NumGatherables; i++, Cursor += sizeof(FGatherableRecord))
+    {
+        FGatherableRecord Record;
+        FMemory::Memcpy(&Record, Cursor, sizeof(Record));
+
+        UDojoModelCraftIslandPocketGatherableResource* Gatherable = NewObject<UDojoModelCraftIslandPocketGatherableResource>(GetTransientPackage());
+        Gatherable->DojoModelType = TEXT("craft_island_pocket-GatherableResource");
+        Gatherable->IslandOwner = OwnerHex;
+        Gatherable->IslandId = Space.Id;
+        Gatherable->ChunkId = BytesToHex(Record.ChunkId, 16);
+        Gatherable->Position = Record.Position;
+        Gatherable->ResourceId = Record.ResourceId;
+        Gatherable->PlantedAt = Record.PlantedAt;
+        Gatherable->NextHarvestAt = Record.NextHarvestAt;
+        Gatherable->HarvestedAt = Record.HarvestedAt;
+        Gatherable->MaxHarvest = Record.MaxHarvest;
+        Gatherable->RemainedHarvest = Record.RemainedHarvest;
+        Gatherable->Destroyed = Record.Destroyed != 0;
+        Gatherable->Tier = Record.Tier;
+        OutModels.Add(Gatherable);
+    }
+
+    for (uint32 i = 0; i < Header.NumStructures; i++, Cursor += sizeof(FStructureRecord))
+    {
+        FStructureRecord Record;
+        FMemory::Memcpy(&Record, Cursor, sizeof(Record));
+
+        UDojoModelCraftIslandPocketWorldStructure* Structure = NewObject<UDojoModelCraftIslandPocketWorldStructure>(GetTransientPackage());
+        Structure->DojoModelType = TEXT("craft_island_pocket-WorldStructure");
+        Structure->IslandOwner = OwnerHex;
+        Structure->IslandId = Space.Id;
+        Structure->ChunkId = BytesToHex(Record.ChunkId, 16);
+        Structure->Position = Record.Position;
+        Structure->StructureType = Record.StructureType;
+        Structure->BuildInventoryId = Record.BuildInventoryId;
+        Structure->Completed = Record.Completed != 0;
+        Structure->LinkedSpaceOwner = BytesToHex(Record.LinkedSpaceOwner, 32);
+        Structure->LinkedSpaceId = Record.LinkedSpaceId;
+        Structure->Destroyed = Record.Destroyed != 0;
+        OutModels.Add(Structure);
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("ChunkDiskCache: loaded space %s (%u chunks, %u gatherables, %u structures)"),
+        *Space.ToString(), Header.NumChunks, Header.NumGatherables, Header.NumStructures);
+    return true;
+}
@@ -4,32 +4,124 @@
 #include "CraftIslandChunks.h"
 #include <memory>
 
-void UCraftIslandChunks::HandleCraftIslandModel(UDojoModel* model, UPARAM(ref) TMap<FString, FSpaceChunks>& RawSpaces)
+FCompactChunk FCompactChunk::FromModel(const UDojoModelCraftIslandPocketIslandChunk* Chunk)
+{
+    // Each half is a u128: the low 16 bytes of the parsed felt
+    FCompactChunk Compact;
+    FMemory::Memcpy(Compact.Blocks, FFelt252::FromHex(Chunk->Blocks1).Bytes + 16, 16);
+    FMemory::Memcpy(Compact.Blocks + 16, FFelt252::FromHex(Chunk->Blocks2).Bytes + 16, 16);
+    Compact.Version = static_cast<uint8>(Chunk->Version);
+    return Compact;
+}
+
+bool FCompactChunk::IsEmpty() const
+{
+    for (uint8 Byte : Blocks)
+    {
+        if (Byte != 0) return false;
+    }
+    return true;
+}
+
+void FSpaceChunks::AddChunk(UDojoModelCraftIslandPocketIslandChunk* Chunk)
+{
+    Chunks.Add(FChunkKey::FromHex(Chunk->ChunkId), FCompactChunk::FromModel(Chunk));
+}
+
+void FSpaceChunks::AddGatherable(UDojoModelCraftIslandPocketGatherableResource* Gatherable)
+{
+    const FChunkItemKey Key(FChunkKey::FromHex(Gatherable->ChunkId), static_cast<uint8>(Gatherable->Position));
+    Gatherables.Add(Key, Gatherable);
+    ChunkContents.FindOrAdd(Key.Chunk).GatherablePositions.AddUnique(Key.Position);
+}
+
+void FSpaceChunks::AddStructure(UDojoModelCraftIslandPocketWorldStructure* Structure)
+{
+    const FChunkItemKey Key(FChunkKey::FromHex(Structure->ChunkId), static_cast<uint8>(Structure->Position));
+    Structures.Add(Key, Structure);
+    ChunkContents.FindOrAdd(Key.Chunk).StructurePositions.AddUnique(Key.Position);
+}
+
+bool FSpaceChunks::RemoveGatherable(const FChunkItemKey& Key)
+{
+    if (Gatherables.Remove(Key) == 0) return false;
+    if (FChunkContents* Contents = ChunkContents.Find(Key.Chunk))
+    {
+        Contents->GatherablePositions.RemoveSwap(Key.Position);
+    }
+    return true;
+}
+
+bool FSpaceChunks::RemoveStructure(const FChunkItemKey& Key)
+{
+    if (Structures.Remove(Key) == 0) return false;
+    if (FChunkContents* Contents = ChunkContents.Find(Key.Chunk))
+    {
+        Contents->StructurePositions.RemoveSwap(Key.Position);
+    }
+    return true;
+}
+
+void FSpaceChunks::RemoveChunk(const FChunkKey& Chunk)
+{
+    Chunks.Remove(Chunk);
+
+    FChunkContents Contents;
+    if (!ChunkContents.RemoveAndCopyValue(Chunk, Contents)) return;
+    for (uint8 Position : Contents.GatherablePositions)
+    {
+        Gatherables.Remove(FChunkItemKey(Chunk, Position));
+    }
+    for (uint8 Position : Contents.StructurePositions)
+    {
+        Structures.Remove(FChunkItemKey(Chunk, Position));
+    }
+}
+
+int64 FSpaceChunks::GetAllocatedSize() const
+{
+    int64 Bytes = Chunks.GetAllocatedSize() + Gatherables.GetAllocatedSize()
+        + Structures.GetAllocatedSize() + ChunkContents.GetAllocatedSize();
+
+    // Gatherables and structures are still model objects (shared with the entity table)
+    for (const auto& Pair : Gatherables)
+    {
+        if (const UDojoModelCraftIslandPocketGatherableResource* Gatherable = Pair.Value)
+        {
+            Bytes += Gatherable->GetClass()->GetStructureSize() + Gatherable->DojoModelType.GetAllocatedSize()
+                + Gatherable->IslandOwner.GetAllocatedSize() + Gatherable->ChunkId.GetAllocatedSize();
+        }
+    }
+    for (const auto& Pair : Structures)
+    {
+        if (const UDojoModelCraftIslandPocketWorldStructure* Structure = Pair.Value)
+        {
+            Bytes += Structure->GetClass()->GetStructureSize() + Structure->DojoModelType.GetAllocatedSize()
+                + Structure->IslandOwner.GetAllocatedSize() + Structure->ChunkId.GetAllocatedSize()
+                + Structure->LinkedSpaceOwner.GetAllocatedSize();
+        }
+    }
+    return Bytes;
+}
+
+void UCraftIslandChunks::HandleCraftIslandModel(UDojoModel* model, UPARAM(ref) TMap<FSpaceKey, FSpaceChunks>& RawSpaces)
 {
     FString name = model->DojoModelType;
     FSpaceChunks* data;
 
     if (name == "craft_island_pocket-IslandChunk") {
         UDojoModelCraftIslandPocketIslandChunk* chunk = reinterpret_cast<UDojoModelCraftIslandPocketIslandChunk*>(model);
-        FString Combined = chunk->IslandOwner + FString::FromInt(chunk->IslandId);
-
-        data = &RawSpaces.FindOrAdd(Combined);
-        data->Chunks.Add(chunk->ChunkId, chunk);
+        data = &RawSpaces.FindOrAdd(FSpaceKey(chunk->IslandOwner, chunk->IslandId));
+        data->AddChunk(chunk);
     }
     else if (name == "craft_island_pocket-GatherableResource") {
         UDojoModelCraftIslandPocketGatherableResource* gatherable = reinterpret_cast<UDojoModelCraftIslandPocketGatherableResource*>(model);
-        FString Combined = gatherable->IslandOwner + FString::FromInt(gatherable->IslandId);
-
-        data = &RawSpaces.FindOrAdd(Combined);
-        FString GatherableKey = gatherable->ChunkId + FString::FromInt(gatherable->Position);
-        data->Gatherables.Add(GatherableKey, gatherable);
+        data = &RawSpaces.FindOrAdd(FSpaceKey(gatherable->IslandOwner, gatherable->IslandId));
+        data->AddGatherable(gatherable);
     }
     else if (name == "craft_island_pocket-WorldStructure") {
         UDojoModelCraftIslandPocketWorldStructure* structure = reinterpret_cast<UDojoModelCraftIslandPocketWorldStructure*>(model);
-        FString Combined = structure->IslandOwner + FString::FromInt(structure->IslandId);
-
-        data = &RawSpaces.FindOrAdd(Combined);
-        FString StructureKey = structure->ChunkId + FString::FromInt(structure->Position);
-        data->Structures.Add(StructureKey, structure);
+        data = &RawSpaces.FindOrAdd(FSpaceKey(structure->IslandOwner, structure->IslandId));
+        data->AddStructure(structure);
     }
 }
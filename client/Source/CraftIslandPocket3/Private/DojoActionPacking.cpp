@@ -0,0 +1,133 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "DojoActionPacking.h"
+
+namespace DojoActionPacking
+{
+    bool DecodeFelt(const FFelt252& Felt, TArray<FPackedAction>& OutActions)
+    {
+        FPackReader Reader(Felt);
+        const uint64 Type = Reader.Read(PACK_TYPE_BITS);
+        if (Type > static_cast<uint8>(EPackType::Single))
+        {
+            return false;
+        }
+
+        const FPackSchema& Pack = GetPackSchema(static_cast<EPackType>(Type));
+        const int32 Count = Pack.Type == EPackType::Single ? 1 : static_cast<int32>(Reader.Read(COUNT_BITS));
+        for (int32 i = 0; i < Count; i++)
+        {
+            FPackedAction Action;
+            Action.Code = Pack.Type == EPackType::Moves
+                ? EActionCode::MoveItem : static_cast<EActionCode>(Reader.Read(Pack.CodeBits));
+
+            const FActionSchema* Schema = FindActionSchema(Pack.Type, Action.Code);
+            if (!Schema)
+            {
+                return false;
+            }
+            for (int32 Field = 0; Field < Schema->NumFields; Field++)
+            {
+                Action.Fields[Field] = Reader.Read(Schema->FieldBits[Field]);
+            }
+            OutActions.Add(Action);
+        }
+        return true;
+    }
+
+    bool FPackPlanner::Add(const FPackedAction& Action, int32 MaxFelts)
+    {
+        const int32 End = Num();
+        int32 Best = MAX_int32;
+        int32 BestStart = 0;
+        const FPackSchema* BestPack = nullptr;
+
+        // Writers are tried on copies, so a refusal leaves the plan as it was
+        TArray<FOpenWriter> StillOpen;
+        StillOpen.Reserve(Open.Num() + 4);
+        auto TryWriter = [&](const FOpenWriter& Candidate)
+        {
+            FOpenWriter Extended = Candidate;
+            if (!Extended.Writer.Add(Action)) return;
+            if (Felts[Extended.Start] + 1 < Best)
+            {
+                Best = Felts[Extended.Start] + 1;
+                BestStart = Extended.Start;
+                BestPack = Extended.Pack;
+            }
+            StillOpen.Add(MoveTemp(Extended));
+        };
+
+        for (const FOpenWriter& Candidate : Open)
+        {
+            TryWriter(Candidate);
+        }
+        if (Felts[End] != MAX_int32)
+        {
+            const FPackSchema* Packs[] = { &PlaceHitPack, &MovesPack, &MixedPack, &SinglePack };
+            for (const FPackSchema* Pack : Packs)
+            {
+                TryWriter(FOpenWriter{ End, Pack, FPackWriter(*Pack) });
+            }
+        }
+
+        if (!BestPack || Best > MaxFelts)
+        {
+            return false;
+        }
+        Actions.Add(Action);
+        Felts.Add(Best);
+        SegmentStart.Add(BestStart);
+        SegmentPack.Add(BestPack);
+        Open = MoveTemp(StillOpen);
+        return true;
+    }
+
+    void FPackPlanner::AddUnpackable()
+    {
+        const int32 End = Num();
+        Actions.AddDefaulted();
+        Felts.Add(Felts[End] == MAX_int32 ? MAX_int32 : Felts[End] + 1);
+        SegmentStart.Add(End);
+        SegmentPack.Add(nullptr);
+        Open.Reset();
+    }
+
+    TArray<FFelt252> FPackPlanner::ToFelts(int32* OutBitsUsed) const
+    {
+        TArray<int32> SegmentEnds;
+        for (int32 End = Num(); End > 0; End = SegmentStart[End])
+        {
+            SegmentEnds.Add(End);
+        }
+
+        TArray<FFelt252> PackedFelts;
+        PackedFelts.Reserve(SegmentEnds.Num());
+        int32 BitsUsed = 0;
+        for (int32 Segment = SegmentEnds.Num() - 1; Segment >= 0; Segment--)
+        {
+            const int32 End = SegmentEnds[Segment];
+            const FPackSchema* Pack = SegmentPack[End];
+            if (!Pack)
+            {
+                PackedFelts.Add(FFelt252());
+                continue;
+            }
+
+            FPackWriter Writer(*Pack);
+            for (int32 i = SegmentStart[End]; i < End; i++)
+            {
+                Writer.Add(Actions[i]);
+            }
+            PackedFelts.Add(Writer.ToFelt());
+            BitsUsed += Writer.GetBitsUsed();
+        }
+
+        if (OutBitsUsed)
+        {
+            *OutBitsUsed = BitsUsed;
+        }
+        return PackedFelts;
+    }
+}
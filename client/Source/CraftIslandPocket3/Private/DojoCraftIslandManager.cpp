@@ -4,6 +4,7 @@
 #include "DojoCraftIslandManager.h"
 #include "EngineUtils.h"
 #include "BaseObject.h"
+#include "DojoDecoders.h"
 #include "Materials/MaterialInstanceDynamic.h"
 #include "Components/StaticMeshComponent.h"
 
@@ -24,10 +25,6 @@ ADojoCraftIslandManager::ADojoCraftIslandManager()
 	NextHotbarSequence = 1;
 	bHotbarSelectionPending = false;
 
-	// Initialize transaction queue
-	bIsProcessingTransaction = false;
-	TransactionQueueCount = 0;
-	
 	// Start optimistic cleanup timer
 	StartOptimisticCleanupTimer();
 }
@@ -72,23 +69,63 @@ void ADojoCraftIslandManager::BeginPlay()
 
     this->InitUIAndActors();
 
+    EntityTable = NewObject<UDojoEntityTable>(this);
+
     if (!DojoHelpers) return;
 
+    // Headless profiling: -DojoReplay=<log> [-DojoReplaySpeed=<x>] [-DojoReplayExit] replays a recorded session
+    FString ReplayPath;
+    float Speed = 1.0f;
+    FParse::Value(FCommandLine::Get(), TEXT("DojoReplaySpeed="), Speed);
+    bExitWhenReplayDone = FParse::Param(FCommandLine::Get(), TEXT("DojoReplayExit"));
+    if (FParse::Value(FCommandLine::Get(), TEXT("DojoReplay="), ReplayPath))
+    {
+        StartReplay(ReplayPath, Speed);
+    }
+
     // Step 1: Connect to Tori
-    DojoHelpers->Connect(ToriiUrl, WorldAddress);
+    if (!bReplayMode)
+    {
+        DojoHelpers->Connect(ToriiUrl, WorldAddress);
+    }
 
     // Step 2: Set contract addresses
     DojoHelpers->SetContractsAddresses(ContractsAddresses);
 
     // Step 3: Bind custom event to delegate
-    DojoHelpers->OnDojoModelUpdated.AddDynamic(this, &ADojoCraftIslandManager::HandleDojoModel);
+    DojoHelpers->OnDojoModelIngested.AddUObject(this, &ADojoCraftIslandManager::HandleDojoModel);
+    DojoHelpers->OnTransactionStatus.AddUObject(this, &ADojoCraftIslandManager::HandleTransactionStatus);
+    DojoHelpers->OnPackedActionsResult.AddUObject(this, &ADojoCraftIslandManager::HandlePackedActionsResult);
+
+    // Step 4: Create burner account (a replay plays back as the recorded player)
+    if (bReplayMode)
+    {
+        Account.Address = Replay->GetPlayerAddress();
+    }
+    else
+    {
+        Account = DojoHelpers->CreateAccountDeprecated(RpcUrl, PlayerAddress, PrivateKey);
 
-    // Step 4: Create burner account
-    Account = DojoHelpers->CreateAccountDeprecated(RpcUrl, PlayerAddress, PrivateKey);
+        FString RecordPath;
+        if (FParse::Value(FCommandLine::Get(), TEXT("DojoRecord="), RecordPath))
+        {
+            DojoHelpers->StartSessionRecording(RecordPath, Account.Address);
+        }
+    }
 
     // Initialize current space tracking
-    CurrentSpaceOwner = Account.Address;
+    AccountAddress = FFelt252::FromHex(Account.Address);
+    CurrentSpaceOwner = AccountAddress;
     CurrentSpaceId = 1;
+
+    UpdateGapFillInterest();
+    TouchSpace(GetCurrentIslandKey());
+
+    // Render the home island from the previous session right away, Torii reconciles it afterwards
+    if (!bReplayMode && RestoreSpaceFromDisk(GetCurrentIslandKey()))
+    {
+        LoadAllChunksFromCache();
+    }
     
     // Set player address in UI if it exists
     if (UI)
@@ -144,8 +181,17 @@ void ADojoCraftIslandManager::BeginPlay()
 
     ConnectGameInstanceEvents();
 
+    // Replays get all their data from the log
+    if (bReplayMode) return;
+
     DojoHelpers->SubscribeOnDojoModelUpdate();
 
+    // Our own inventory / player data gets its own subscription so it never queues behind world streaming
+    DojoHelpers->SubscribePlayerModels(Account.Address);
+
+    // Our transactions as Torii indexes them drive the queue (receipts are the fallback)
+    DojoHelpers->SubscribeTransactions(Account.Address);
+
     // Step 2: Call custom spawn function
     CraftIslandSpawn();
 
@@ -159,6 +205,27 @@ void ADojoCraftIslandManager::BeginPlay()
     );
 }
 
+void ADojoCraftIslandManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (DojoHelpers)
+    {
+        DojoHelpers->OnDojoModelIngested.RemoveAll(this);
+        DojoHelpers->OnTransactionStatus.RemoveAll(this);
+        DojoHelpers->OnPackedActionsResult.RemoveAll(this);
+    }
+
+    if (!Account.Address.IsEmpty())
+    {
+        SaveSpaceToDisk(MakeSpaceKey(AccountAddress, 1));
+        if (GetCurrentIslandKey() != MakeSpaceKey(AccountAddress, 1))
+        {
+            SaveSpaceToDisk(GetCurrentIslandKey());
+        }
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
 void ADojoCraftIslandManager::ConnectGameInstanceEvents()
 {
     UGameInstance* GameInstance = GetGameInstance();
@@ -189,6 +256,23 @@ void ADojoCraftIslandManager::Tick(float DeltaTime)
 {
     Super::Tick(DeltaTime);
 
+    // Pull what Torii threads delivered since last frame (player lane in full, world data within budget), then apply it
+    if (bReplayMode)
+    {
+        AdvanceReplay(DeltaTime);
+    }
+    else if (DojoHelpers)
+    {
+        DojoHelpers->DrainIngest(IngestFrameBudgetMs / 1000.0);
+    }
+    FlushPendingModelUpdates();
+
+    ChunkCacheBudgetTimer += DeltaTime;
+    if (ChunkCacheBudgetTimer >= CHUNK_CACHE_BUDGET_CHECK_INTERVAL)
+    {
+        ChunkCacheBudgetTimer = 0.0f;
+        EnforceChunkCacheBudget();
+    }
 
     // Original Tick functionality for handling target blocks and spawn queue
     APlayerController* PC = GetWorld()->GetFirstPlayerController();
@@ -519,16 +603,10 @@ void ADojoCraftIslandManager::HandlePlayerData(UDojoModel* Object)
     // Check if this is the current player
     if (IsCurrentPlayer())
     {
-        // Check if space has changed - normalize addresses to handle leading zeros
-        auto GetHexPart = [](const FString& Address) -> FString {
-            FString Hex = Address.StartsWith("0x") ? Address.Mid(2) : Address;
-            return Hex.ToLower();
-        };
-        
-        FString CurrentOwnerHex = GetHexPart(CurrentSpaceOwner);
-        FString PlayerDataOwnerHex = GetHexPart(PlayerData->CurrentSpaceOwner);
-        
-        bool bOwnerChanged = !(CurrentOwnerHex.EndsWith(PlayerDataOwnerHex) || PlayerDataOwnerHex.EndsWith(CurrentOwnerHex));
+        // Check if space has changed - felts compare in canonical form, leading zeros don't matter
+        FFelt252 PlayerDataOwner = FFelt252::FromHex(PlayerData->CurrentSpaceOwner);
+
+        bool bOwnerChanged = (CurrentSpaceOwner != PlayerDataOwner);
         bool bSpaceChanged = (bOwnerChanged || CurrentSpaceId != PlayerData->CurrentSpaceId);
 
         // For the first player data, force initial loading
@@ -539,8 +617,9 @@ void ADojoCraftIslandManager::HandlePlayerData(UDojoModel* Object)
                    *PlayerData->CurrentSpaceOwner, PlayerData->CurrentSpaceId);
             
             // Update current space and force initial load
-            CurrentSpaceOwner = PlayerData->CurrentSpaceOwner;
+            CurrentSpaceOwner = PlayerDataOwner;
             CurrentSpaceId = PlayerData->CurrentSpaceId;
+            UpdateGapFillInterest();
             
             // Force initial chunk loading for starting space
             LoadAllChunksFromCache();
@@ -581,7 +660,7 @@ void ADojoCraftIslandManager::HandleProcessingLock(UDojoModel* Object)
         *ProcessingLock->Player, ProcessingLock->UnlockTime, ProcessingLock->ProcessType);
 
     // Check if this is the current player
-    if (ProcessingLock->Player == Account.Address)
+    if (FFelt252::FromHex(ProcessingLock->Player) == AccountAddress)
     {
         // Update our local processing lock state
         CurrentProcessingLock.Player = ProcessingLock->Player;
@@ -617,32 +696,166 @@ FIntVector ADojoCraftIslandManager::GetWorldPositionFromLocal(int Position, cons
 
 void ADojoCraftIslandManager::HandleDojoModel(UDojoModel* Model)
 {
-    UE_LOG(LogTemp, VeryVerbose, TEXT("=== HandleDojoModel START ==="));
-    UE_LOG(LogTemp, VeryVerbose, TEXT("Model Type: %s"), *Model->DojoModelType);
-    FString Name = Model->DojoModelType;
+    if (!Model) return;
 
-    // When we receive any model update, it means a transaction was processed
-    // Continue processing the queue
-    OnTransactionComplete();
+    TotalModelUpdates++;
 
-    // First, update the chunk cache
-    UCraftIslandChunks::HandleCraftIslandModel(Model, ChunkCache);
+    FDojoModelKey Key;
+    if (!FDojoModelKey::FromModel(Model, Key))
+    {
+        // Unknown model type, nothing to coalesce against
+        PendingModelUpdates.Add(Model);
+        return;
+    }
 
-    // Then process for immediate display if it's for the current space
-    if (Name == "craft_island_pocket-IslandChunk") {
-        UE_LOG(LogTemp, VeryVerbose, TEXT("Processing IslandChunk model"));
-        UDojoModelCraftIslandPocketIslandChunk* Chunk = Cast<UDojoModelCraftIslandPocketIslandChunk>(Model);
-        if (Chunk)
-        {
-            UE_LOG(LogTemp, VeryVerbose, TEXT("Chunk Owner: %s, Id: %d | Current Space: %s, Id: %d"), 
-                *Chunk->IslandOwner, Chunk->IslandId, *CurrentSpaceOwner, CurrentSpaceId);
-            if (Chunk->IslandOwner == CurrentSpaceOwner && Chunk->IslandId == CurrentSpaceId)
+    if (const int32* ExistingIndex = PendingModelIndex.Find(Key))
+    {
+        // Newer version of an entity already staged this frame: replace it in place
+        DojoHelpers->RecycleModel(PendingModelUpdates[*ExistingIndex]);
+        PendingModelUpdates[*ExistingIndex] = Model;
+        CoalescedModelUpdates++;
+        return;
+    }
+
+    PendingModelIndex.Add(Key, PendingModelUpdates.Add(Model));
+}
+
+bool ADojoCraftIslandManager::StartReplay(const FString& Path, float Speed)
+{
+    TUniquePtr<FDojoSessionReplay> NewReplay = MakeUnique<FDojoSessionReplay>();
+    if (!NewReplay->Open(Path)) return false;
+
+    Replay = MoveTemp(NewReplay);
+    bReplayMode = true;
+    ReplaySpeed = Speed;
+    ReplayedBatches = 0;
+    ReplayedModels = 0;
+    ReplayStartWallTime = FPlatformTime::Seconds();
+
+    double FirstTimestamp = 0.0;
+    ReplayClock = Replay->PeekTimestamp(FirstTimestamp) ? FirstTimestamp : 0.0;
+
+    UE_LOG(LogTemp, Log, TEXT("StartReplay: %s at %s"), *Path,
+        Speed > 0.0f ? *FString::Printf(TEXT("%.2fx"), Speed) : TEXT("max speed"));
+    return true;
+}
+
+void ADojoCraftIslandManager::AdvanceReplay(float DeltaTime)
+{
+    if (!Replay.IsValid()) return;
+
+    const double Deadline = FPlatformTime::Seconds() + IngestFrameBudgetMs / 1000.0;
+    ReplayClock += DeltaTime * FMath::Max(ReplaySpeed, 0.0f);
+
+    TArray<UDojoModel*> Batch;
+    EDojoSessionLane Lane;
+    double Timestamp = 0.0;
+    while (Replay->PeekTimestamp(Timestamp))
+    {
+        // Real-time / accelerated: follow the recorded clock. Max speed: fill the frame budget.
+        if (ReplaySpeed > 0.0f ? Timestamp > ReplayClock : FPlatformTime::Seconds() >= Deadline) break;
+
+        if (!Replay->NextBatch(Batch, Lane, Timestamp)) break;
+        for (UDojoModel* Model : Batch)
+        {
+            HandleDojoModel(Model);
+        }
+        ReplayedBatches++;
+        ReplayedModels += Batch.Num();
+    }
+
+    if (Replay->IsFinished())
+    {
+        UE_LOG(LogTemp, Log, TEXT("Replay finished: %lld batches, %lld models in %.2fs wall time (%lld coalesced)"),
+            ReplayedBatches, ReplayedModels, FPlatformTime::Seconds() - ReplayStartWallTime, CoalescedModelUpdates);
+        Replay.Reset();
+
+        if (bExitWhenReplayDone)
+        {
+            // Apply the last frame's updates before leaving
+            FlushPendingModelUpdates();
+            FPlatformMisc::RequestExit(false);
+        }
+    }
+}
+
+void ADojoCraftIslandManager::FlushPendingModelUpdates()
+{
+    if (PendingModelUpdates.Num() == 0) return;
+
+    // Swap out first: applying a model can broadcast to Blueprints which may trigger new updates
+    TArray<UDojoModel*> Updates = MoveTemp(PendingModelUpdates);
+    PendingModelUpdates.Reset();
+    PendingModelIndex.Reset();
+
+    for (UDojoModel* Model : Updates)
+    {
+        ApplyDojoModel(Model);
+    }
+
+    UE_LOG(LogTemp, VeryVerbose, TEXT("FlushPendingModelUpdates: applied %d models (%lld received, %lld coalesced so far)"),
+        Updates.Num(), TotalModelUpdates, CoalescedModelUpdates);
+}
+
+void ADojoCraftIslandManager::ApplyDojoModel(UDojoModel* Incoming)
+{
+    UE_LOG(LogTemp, VeryVerbose, TEXT("=== HandleDojoModel START ==="));
+    UE_LOG(LogTemp, VeryVerbose, TEXT("Model Type: %s"), *Incoming->DojoModelType);
+    FString Name = Incoming->DojoModelType;
+
+    // Chunks live only in ChunkCache as compact PODs, the model object is just the transport
+    if (Name == "craft_island_pocket-IslandChunk")
+    {
+        if (UDojoModelCraftIslandPocketIslandChunk* Chunk = Cast<UDojoModelCraftIslandPocketIslandChunk>(Incoming))
+        {
+            const FSpaceKey Space(Chunk->IslandOwner, Chunk->IslandId);
+            const FChunkKey Key = FChunkKey::FromHex(Chunk->ChunkId);
+            const FCompactChunk Compact = FCompactChunk::FromModel(Chunk);
+
+            FSpaceChunks& SpaceData = ChunkCache.FindOrAdd(Space);
+            const FCompactChunk* Cached = SpaceData.Chunks.Find(Key);
+            const bool bUnchanged = Cached && *Cached == Compact;
+            if (bUnchanged)
             {
-                ProcessIslandChunk(Chunk);
+                UnchangedFromCacheCount++;
+            }
+            else
+            {
+                SpaceData.AddChunk(Key, Compact);
+                UE_LOG(LogTemp, VeryVerbose, TEXT("Chunk Owner: %s, Id: %d | Current Space: %s, Id: %d"),
+                    *Chunk->IslandOwner, Chunk->IslandId, *CurrentSpaceOwner.ToHex(), CurrentSpaceId);
+                if (Space.Owner == CurrentSpaceOwner && Space.Id == CurrentSpaceId)
+                {
+                    ProcessIslandChunk(Space, Key, Compact);
+                }
             }
         }
+        DojoHelpers->RecycleModel(Incoming);
+        UE_LOG(LogTemp, VeryVerbose, TEXT("=== HandleDojoModel END ==="));
+        return;
+    }
+
+    // Merge into the entity's canonical object; from here on everything holds that one
+    TArray<FName> ChangedFields;
+    bool bCreated = false;
+    UDojoModel* Model = EntityTable->Upsert(Incoming, ChangedFields, bCreated);
+    if (Model != Incoming)
+    {
+        DojoHelpers->RecycleModel(Incoming);
+    }
+
+    // Entities already rendered (e.g. from the disk cache) don't need to be processed again
+    const bool bUnchanged = !bCreated && ChangedFields.Num() == 0;
+    if (bUnchanged)
+    {
+        UnchangedFromCacheCount++;
     }
-    else if (Name == "craft_island_pocket-GatherableResource") {
+
+    // First, update the chunk cache
+    UCraftIslandChunks::HandleCraftIslandModel(Model, ChunkCache);
+
+    // Then process for immediate display if it's for the current space
+    if (Name == "craft_island_pocket-GatherableResource") {
         UE_LOG(LogTemp, VeryVerbose, TEXT("Processing GatherableResource model"));
         UDojoModelCraftIslandPocketGatherableResource* Resource = Cast<UDojoModelCraftIslandPocketGatherableResource>(Model);
         if (Resource)
@@ -650,9 +863,9 @@ void ADojoCraftIslandManager::HandleDojoModel(UDojoModel* Model)
             UE_LOG(LogTemp, VeryVerbose, TEXT("Resource Owner: %s, Id: %d, Position: %d, ResourceId: %d, Tier: %d"), 
                 *Resource->IslandOwner, Resource->IslandId, 
                 Resource->Position, Resource->ResourceId, Resource->Tier);
-            UE_LOG(LogTemp, VeryVerbose, TEXT("Current Space: %s, Id: %d"), *CurrentSpaceOwner, CurrentSpaceId);
+            UE_LOG(LogTemp, VeryVerbose, TEXT("Current Space: %s, Id: %d"), *CurrentSpaceOwner.ToHex(), CurrentSpaceId);
             
-            if (Resource->IslandOwner == CurrentSpaceOwner && Resource->IslandId == CurrentSpaceId)
+            if (!bUnchanged && IsInCurrentSpace(Resource->IslandOwner, Resource->IslandId))
             {
                 UE_LOG(LogTemp, VeryVerbose, TEXT("Resource is in current space, processing..."));
                 ProcessGatherableResource(Resource);
@@ -669,8 +882,8 @@ void ADojoCraftIslandManager::HandleDojoModel(UDojoModel* Model)
         if (Structure)
         {
             UE_LOG(LogTemp, VeryVerbose, TEXT("Structure Owner: %s, Id: %d | Current Space: %s, Id: %d"), 
-                *Structure->IslandOwner, Structure->IslandId, *CurrentSpaceOwner, CurrentSpaceId);
-            if (Structure->IslandOwner == CurrentSpaceOwner && Structure->IslandId == CurrentSpaceId)
+                *Structure->IslandOwner, Structure->IslandId, *CurrentSpaceOwner.ToHex(), CurrentSpaceId);
+            if (!bUnchanged && IsInCurrentSpace(Structure->IslandOwner, Structure->IslandId))
             {
                 ProcessWorldStructure(Structure);
             }
@@ -779,7 +992,7 @@ AActor* ADojoCraftIslandManager::PlaceAssetInWorld(E_Item Item, const FIntVector
                 if (ExistingBlock->Item == Item)
                 {
                     // If we're in space 1 and the actor is hidden, show it
-                    if (CurrentSpaceOwner == Account.Address && CurrentSpaceId == 1 && ExistingActor->IsHidden())
+                    if (CurrentSpaceOwner == AccountAddress && CurrentSpaceId == 1 && ExistingActor->IsHidden())
                     {
                         ExistingActor->SetActorHiddenInGame(false);
                         ExistingActor->SetActorEnableCollision(true);
@@ -1077,6 +1290,7 @@ void ADojoCraftIslandManager::RequestPlaceUse()
     }
     
     // Optimistic rendering: Place the item/result immediately with visual feedback
+    const int32 PlacementSequence = NextPlacementSequence++;
     if ((SelectedItemId > 0 && !bIsTool) || (bIsTool && ResultItemId > 0))
     {
         FIntVector OptimisticPosition(
@@ -1148,6 +1362,7 @@ void ADojoCraftIslandManager::RequestPlaceUse()
 
                 // Apply pending visual feedback
                 ApplyPendingVisual(OptimisticActor);
+                OptimisticActor->Tags.Add(GetPlacementTag(PlacementSequence));
 
                 UE_LOG(LogTemp, Log, TEXT("Optimistic placement at (%d, %d, %d) for item %d"),
                     OptimisticPosition.X, OptimisticPosition.Y, OptimisticPosition.Z, ItemToPlace);
@@ -1163,6 +1378,7 @@ void ADojoCraftIslandManager::RequestPlaceUse()
         TargetBlock.Y + 8192,
         TargetBlock.Z + 8192 + ZOffset
     );
+    Item.SequenceNumber = PlacementSequence;
     QueueTransaction(Item);
 }
 
@@ -1335,6 +1551,8 @@ void ADojoCraftIslandManager::RequestHit()
     FTransactionQueueItem Item;
     Item.Type = ETransactionType::Hit;
     Item.Position = HitPosition;
+    // Tool in hand, lets the optimiser tell whether this hit undoes a pending placement
+    Item.ItemType = static_cast<E_Item>(SelectedItemId);
     
     QueueTransaction(Item);
     
@@ -1372,14 +1590,15 @@ void ADojoCraftIslandManager::RequestSell()
 
 void ADojoCraftIslandManager::RequestBuy(int32 ItemId, int32 Quantity)
 {
-    DojoHelpers->CallCraftIslandPocketActionsBuy(Account, ItemId, Quantity);
+    // Queued: a shopping session goes out in as few transactions as the batching allows
+    QueueBuy({ ItemId }, { Quantity });
 }
 
 void ADojoCraftIslandManager::RequestGoBackHome()
 {
     UE_LOG(LogTemp, VeryVerbose, TEXT("========== RequestGoBackHome START =========="));
     UE_LOG(LogTemp, VeryVerbose, TEXT("RequestGoBackHome: Current space: %s:%d"),
-        *CurrentSpaceOwner, CurrentSpaceId);
+        *CurrentSpaceOwner.ToHex(), CurrentSpaceId);
     UE_LOG(LogTemp, VeryVerbose, TEXT("RequestGoBackHome: Account.Address = %s"), *Account.Address);
     UE_LOG(LogTemp, VeryVerbose, TEXT("RequestGoBackHome: bSpace1ActorsHidden = %s"), bSpace1ActorsHidden ? TEXT("true") : TEXT("false"));
     UE_LOG(LogTemp, VeryVerbose, TEXT("RequestGoBackHome: Actors.Num() = %d"), Actors.Num());
@@ -1400,14 +1619,12 @@ void ADojoCraftIslandManager::RequestStartProcessing(uint8 ProcessType, int32 In
 {
     UE_LOG(LogTemp, Log, TEXT("RequestStartProcessing: ProcessType=%d, InputAmount=%d"), ProcessType, InputAmount);
 
-    if (DojoHelpers)
-    {
-        DojoHelpers->CallCraftIslandPocketActionsStartProcessing(Account, ProcessType, InputAmount);
-    }
-    else
-    {
-        UE_LOG(LogTemp, Error, TEXT("RequestStartProcessing: DojoHelpers is null!"));
-    }
+    FTransactionQueueItem Item;
+    Item.Type = ETransactionType::StartProcess;
+    Item.IntParam = ProcessType;
+    Item.IntParam2 = InputAmount;
+
+    QueueTransaction(Item);
 }
 
 void ADojoCraftIslandManager::RequestCancelProcessing()
@@ -1506,15 +1723,184 @@ void ADojoCraftIslandManager::SetTargetBlock(FVector Location)
 
 // Helper function implementations
 
-FString ADojoCraftIslandManager::GetCurrentIslandKey() const
+FSpaceKey ADojoCraftIslandManager::GetCurrentIslandKey() const
 {
     // Use the tracked current space for the cache key
     return MakeSpaceKey(CurrentSpaceOwner, CurrentSpaceId);
 }
 
-FString ADojoCraftIslandManager::MakeSpaceKey(const FString& Owner, int32 Id) const
+FSpaceKey ADojoCraftIslandManager::MakeSpaceKey(const FFelt252& Owner, int32 Id) const
+{
+    return FSpaceKey(Owner, Id);
+}
+
+bool ADojoCraftIslandManager::IsInCurrentSpace(const FString& Owner, int32 Id) const
+{
+    return Id == CurrentSpaceId && FFelt252::FromHex(Owner) == CurrentSpaceOwner;
+}
+
+void ADojoCraftIslandManager::UpdateGapFillInterest()
+{
+    if (!DojoHelpers) return;
+
+    // Everything keyed by our address first: PlayerData, Inventories, ProcessingLock and our own islands
+    TArray<TArray<FString>> Interest;
+    Interest.Add({ AccountAddress.ToHex() });
+    if (CurrentSpaceOwner != AccountAddress)
+    {
+        Interest.Add({ CurrentSpaceOwner.ToHex(), FString::Printf(TEXT("0x%x"), CurrentSpaceId) });
+    }
+    DojoHelpers->SetGapFillInterest(Interest);
+}
+
+FChunkCacheStats ADojoCraftIslandManager::GetChunkCacheStats() const
+{
+    FChunkCacheStats Stats;
+    Stats.Spaces = ChunkCache.Num();
+    Stats.Bytes = ChunkCache.GetAllocatedSize();
+    for (const auto& Pair : ChunkCache)
+    {
+        Stats.Chunks += Pair.Value.Chunks.Num();
+        Stats.Gatherables += Pair.Value.Gatherables.Num();
+        Stats.Structures += Pair.Value.Structures.Num();
+        Stats.Bytes += Pair.Value.GetAllocatedSize();
+    }
+    Stats.SpacesEvicted = SpacesEvicted;
+    return Stats;
+}
+
+void ADojoCraftIslandManager::TouchSpace(const FSpaceKey& Space)
+{
+    SpaceVisitStamps.Add(Space, ++SpaceVisitCounter);
+}
+
+void ADojoCraftIslandManager::EnforceChunkCacheBudget()
+{
+    if (ChunkCacheBudgetBytes <= 0) return;
+
+    struct FCandidate
+    {
+        FSpaceKey Space;
+        uint64 Stamp;
+        int64 Bytes;
+    };
+
+    const FSpaceKey Home = MakeSpaceKey(AccountAddress, 1);
+    const FSpaceKey Current = GetCurrentIslandKey();
+
+    int64 TotalBytes = ChunkCache.GetAllocatedSize();
+    TArray<FCandidate> Candidates;
+    for (const auto& Pair : ChunkCache)
+    {
+        const int64 Bytes = Pair.Value.GetAllocatedSize();
+        TotalBytes += Bytes;
+        if (Pair.Key != Home && Pair.Key != Current)
+        {
+            // Spaces only seen through the subscription were never visited: stamp 0, evicted first
+            const uint64* Stamp = SpaceVisitStamps.Find(Pair.Key);
+            Candidates.Add({ Pair.Key, Stamp ? *Stamp : 0, Bytes });
+        }
+    }
+    if (TotalBytes <= ChunkCacheBudgetBytes) return;
+
+    Candidates.Sort([](const FCandidate& A, const FCandidate& B) { return A.Stamp < B.Stamp; });
+
+    const int64 BytesBefore = TotalBytes;
+    int32 Evicted = 0;
+    for (const FCandidate& Candidate : Candidates)
+    {
+        if (TotalBytes <= ChunkCacheBudgetBytes) break;
+        EvictSpace(Candidate.Space);
+        TotalBytes -= Candidate.Bytes;
+        Evicted++;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("EnforceChunkCacheBudget: evicted %d spaces, %lld -> %lld bytes (budget %lld)"),
+        Evicted, BytesBefore, TotalBytes, ChunkCacheBudgetBytes);
+}
+
+void ADojoCraftIslandManager::EvictSpace(const FSpaceKey& Space)
+{
+    FSpaceChunks* SpaceData = ChunkCache.Find(Space);
+    if (!SpaceData) return;
+
+    // Keep it on disk so a revisit renders immediately
+    SaveSpaceToDisk(Space);
+
+    // Gatherables and structures are canonical entity objects; drop them from the table too so they can be collected
+    FDojoModelKey Key;
+    for (const auto& Pair : SpaceData->Gatherables)
+    {
+        if (Pair.Value && FDojoModelKey::FromModel(Pair.Value, Key))
+        {
+            EntityTable->Remove(Key);
+        }
+    }
+    for (const auto& Pair : SpaceData->Structures)
+    {
+        if (Pair.Value && FDojoModelKey::FromModel(Pair.Value, Key))
+        {
+            EntityTable->Remove(Key);
+        }
+    }
+
+    ChunkCache.Remove(Space);
+    SpaceVisitStamps.Remove(Space);
+    EvictedSpaces.Add(Space);
+    SpacesEvicted++;
+}
+
+bool ADojoCraftIslandManager::RestoreSpaceFromDisk(const FSpaceKey& Space)
+{
+    TArray<UDojoModel*> Models;
+    FSpaceChunks DiskData;
+    if (!FChunkDiskCache::Load(WorldAddress, Space, DiskData, Models))
+    {
+        return false;
+    }
+
+    // The disk copy dates from eviction; anything the subscription delivered since is newer, so it only fills gaps
+    FSpaceChunks& SpaceData = ChunkCache.FindOrAdd(Space);
+    int32 Restored = 0;
+    for (const auto& Pair : DiskData.Chunks)
+    {
+        if (!SpaceData.Chunks.Contains(Pair.Key))
+        {
+            SpaceData.AddChunk(Pair.Key, Pair.Value);
+            Restored++;
+        }
+    }
+
+    TArray<FName> ChangedFields;
+    bool bCreated = false;
+    FDojoModelKey Key;
+    for (UDojoModel* Model : Models)
+    {
+        if (FDojoModelKey::FromModel(Model, Key) && EntityTable->Find(Key))
+        {
+            DojoHelpers->RecycleModel(Model);
+            continue;
+        }
+        UDojoModel* Canonical = EntityTable->Upsert(Model, ChangedFields, bCreated);
+        UCraftIslandChunks::HandleCraftIslandModel(Canonical, ChunkCache);
+        if (Canonical != Model)
+        {
+            DojoHelpers->RecycleModel(Model);
+        }
+        Restored++;
+    }
+    return Restored > 0;
+}
+
+void ADojoCraftIslandManager::SaveSpaceToDisk(const FSpaceKey& Space)
 {
-    return Owner + FString::FromInt(Id);
+    // Replayed sessions must not overwrite the live cache
+    if (bReplayMode) return;
+
+    if (const FSpaceChunks* SpaceData = ChunkCache.Find(Space))
+    {
+        FChunkDiskCache::Save(WorldAddress, Space, *SpaceData);
+    }
 }
 
 void ADojoCraftIslandManager::SaveCurrentPlayerPosition()
@@ -1523,30 +1909,30 @@ void ADojoCraftIslandManager::SaveCurrentPlayerPosition()
     {
         if (APawn* PlayerPawn = PC->GetPawn())
         {
-            FString CurrentSpaceKey = GetCurrentIslandKey();
+            FSpaceKey CurrentSpaceKey = GetCurrentIslandKey();
             FVector CurrentPos = PlayerPawn->GetActorLocation();
             SpacePlayerPositions.Add(CurrentSpaceKey, CurrentPos);
             UE_LOG(LogTemp, Log, TEXT("Saved position %s for space %s"),
-                *CurrentPos.ToString(), *CurrentSpaceKey);
+                *CurrentPos.ToString(), *CurrentSpaceKey.ToString());
         }
     }
 }
 
-FVector ADojoCraftIslandManager::GetSpawnPositionForSpace(const FString& SpaceKey, bool bHasBlockChunks)
+FVector ADojoCraftIslandManager::GetSpawnPositionForSpace(const FSpaceKey& SpaceKey, bool bHasBlockChunks)
 {
     // Check if we have a saved position for this space
-    if (SpacePlayerPositions.Contains(SpaceKey))
+    if (const FVector* SavedPosPtr = SpacePlayerPositions.Find(SpaceKey))
     {
-        FVector SavedPos = SpacePlayerPositions[SpaceKey];
+        FVector SavedPos = *SavedPosPtr;
         UE_LOG(LogTemp, Log, TEXT("Restoring saved position %s for space %s"),
-            *SavedPos.ToString(), *SpaceKey);
+            *SavedPos.ToString(), *SpaceKey.ToString());
         return SavedPos;
     }
 
     // Return default position based on space type
     FVector DefaultPos = bHasBlockChunks ? DEFAULT_OUTDOOR_SPAWN_POS : DEFAULT_BUILDING_SPAWN_POS;
     UE_LOG(LogTemp, Log, TEXT("Using default position %s for new space %s"),
-        *DefaultPos.ToString(), *SpaceKey);
+        *DefaultPos.ToString(), *SpaceKey.ToString());
     return DefaultPos;
 }
 
@@ -1620,75 +2006,16 @@ int32 ADojoCraftIslandManager::GetSelectedItemId() const
     
     UE_LOG(LogTemp, VeryVerbose, TEXT("GetSelectedItemId: Raw slot data for felt %d: %s"), FeltIndex, *SlotData);
 
-    // Convert hex string to number
-    if (SlotData.StartsWith("0x"))
-    {
-        SlotData = SlotData.Mid(2);
-    }
-
-    // Parse the hex string to a big integer
-    // We need to handle this as a 256-bit number
-    TArray<uint8> Bytes;
-
-    // Convert hex string to bytes
-    for (int32 i = 0; i < SlotData.Len(); i += 2)
-    {
-        uint8 Byte = 0;
-
-        // High nibble
-        TCHAR C1 = (i < SlotData.Len()) ? SlotData[i] : '0';
-        if (C1 >= '0' && C1 <= '9') Byte = (C1 - '0') << 4;
-        else if (C1 >= 'a' && C1 <= 'f') Byte = (10 + (C1 - 'a')) << 4;
-        else if (C1 >= 'A' && C1 <= 'F') Byte = (10 + (C1 - 'A')) << 4;
-
-        // Low nibble
-        TCHAR C2 = (i + 1 < SlotData.Len()) ? SlotData[i + 1] : '0';
-        if (C2 >= '0' && C2 <= '9') Byte |= (C2 - '0');
-        else if (C2 >= 'a' && C2 <= 'f') Byte |= (10 + (C2 - 'a'));
-        else if (C2 >= 'A' && C2 <= 'F') Byte |= (10 + (C2 - 'A'));
-
-        Bytes.Add(Byte);
-    }
-
     // Cairo stores slots packed from LSB to MSB in the felt252
     // Each slot is 28 bits: [10 bits item_type][8 bits quantity][10 bits extra]
-    // Slot 0 starts at bit 0, slot 1 at bit 28, etc.
-
-    // Pad bytes array to 32 bytes if needed
-    while (Bytes.Num() < 32)
-    {
-        Bytes.Insert(0, 0); // Pad at the beginning since hex is big-endian
-    }
-
-    // Calculate bit position for the selected slot
-    uint32 BitOffset = SlotInFelt * 28;
-
-    // Extract 28 bits from the bytes array
-    // Since felt252 is big-endian but slots are packed from LSB, we need to
-    // work from the right side of the number
-    uint64 SlotDataValue = 0;
-
-    // Read from the end of the array (LSB) and extract bits
-    for (int32 i = 0; i < 5; i++) // Read 5 bytes to ensure we get all 28 bits
-    {
-        int32 ByteIndex = 31 - (BitOffset / 8) - i;
-        if (ByteIndex >= 0 && ByteIndex < Bytes.Num())
-        {
-            SlotDataValue |= ((uint64)Bytes[ByteIndex]) << (i * 8);
-        }
-    }
-
-    // Shift to align with the bit offset within the bytes
-    SlotDataValue >>= (BitOffset % 8);
-
-    // Mask to get only 28 bits
-    SlotDataValue &= 0x0FFFFFFF;
+    const FFelt252 Felt = FFelt252::FromHex(SlotData);
+    const uint32 SlotDataValue = DojoDecoders::GetInventorySlotBits(Felt.Bytes, SlotInFelt);
 
     // Extract item_type (bits 18-27, top 10 bits of the 28-bit value)
     int32 ItemType = (SlotDataValue >> 18) & 0x3FF;
     
-    UE_LOG(LogTemp, VeryVerbose, TEXT("GetSelectedItemId: BitOffset=%d, SlotDataValue=0x%llX, Extracted ItemType=%d"), 
-           BitOffset, SlotDataValue, ItemType);
+    UE_LOG(LogTemp, VeryVerbose, TEXT("GetSelectedItemId: SlotInFelt=%d, SlotDataValue=0x%X, Extracted ItemType=%d"),
+           SlotInFelt, SlotDataValue, ItemType);
 
     return ItemType;
 }
@@ -1727,34 +2054,23 @@ void ADojoCraftIslandManager::HandleSpaceTransition(UDojoModelCraftIslandPocketP
 
     UE_LOG(LogTemp, Warning, TEXT("=== SPACE TRANSITION START ==="));
     UE_LOG(LogTemp, Warning, TEXT("Space changed from %s:%d to %s:%d"),
-        *CurrentSpaceOwner, CurrentSpaceId,
+        *CurrentSpaceOwner.ToHex(), CurrentSpaceId,
         *PlayerData->CurrentSpaceOwner, PlayerData->CurrentSpaceId);
 
     // Save current player position before changing spaces
     SaveCurrentPlayerPosition();
 
     // Check if we're leaving space 1 BEFORE updating current space
-    // Compare addresses by removing 0x prefix and comparing the hex part
-    auto GetHexPart = [](const FString& Address) -> FString {
-        FString Hex = Address.StartsWith("0x") ? Address.Mid(2) : Address;
-        return Hex.ToLower();
-    };
-    
-    FString CurrentOwnerHex = GetHexPart(CurrentSpaceOwner);
-    FString AccountAddressHex = GetHexPart(Account.Address);
-    FString PlayerDataOwnerHex = GetHexPart(PlayerData->CurrentSpaceOwner);
-    
-    // Compare by checking if one address ends with the other (handles leading zeros)
-    bool bAddressesMatch = (CurrentOwnerHex.EndsWith(AccountAddressHex) || AccountAddressHex.EndsWith(CurrentOwnerHex));
-    bool bPlayerDataAddressesMatch = (PlayerDataOwnerHex.EndsWith(AccountAddressHex) || AccountAddressHex.EndsWith(PlayerDataOwnerHex));
+    FFelt252 PlayerDataOwner = FFelt252::FromHex(PlayerData->CurrentSpaceOwner);
+
+    bool bAddressesMatch = (CurrentSpaceOwner == AccountAddress);
+    bool bPlayerDataAddressesMatch = (PlayerDataOwner == AccountAddress);
     
     bool bLeavingSpace1 = (bAddressesMatch && CurrentSpaceId == 1);
     bool bReturningToSpace1 = (bPlayerDataAddressesMatch && PlayerData->CurrentSpaceId == 1);
 
     UE_LOG(LogTemp, Warning, TEXT("HandleSpaceTransition: CurrentSpaceOwner=%s, Account.Address=%s"), 
-           *CurrentSpaceOwner, *Account.Address);
-    UE_LOG(LogTemp, Warning, TEXT("HandleSpaceTransition: CurrentOwnerHex=%s, AccountAddressHex=%s"), 
-           *CurrentOwnerHex, *AccountAddressHex);
+           *CurrentSpaceOwner.ToHex(), *AccountAddress.ToHex());
     UE_LOG(LogTemp, Warning, TEXT("HandleSpaceTransition: CurrentSpaceId=%d, comparing to 1"), 
            CurrentSpaceId);
     UE_LOG(LogTemp, Warning, TEXT("HandleSpaceTransition: bAddressesMatch=%d, bLeavingSpace1=%d, bReturningToSpace1=%d"), 
@@ -1773,9 +2089,24 @@ void ADojoCraftIslandManager::HandleSpaceTransition(UDojoModelCraftIslandPocketP
         ClearAllSpawnedActors();
     }
 
+    // Persist the space we're leaving so the next session (or a revisit) can start from it
+    SaveSpaceToDisk(GetCurrentIslandKey());
+
     // Update current space tracking
-    CurrentSpaceOwner = PlayerData->CurrentSpaceOwner;
+    CurrentSpaceOwner = PlayerDataOwner;
     CurrentSpaceId = PlayerData->CurrentSpaceId;
+    UpdateGapFillInterest();
+    TouchSpace(GetCurrentIslandKey());
+
+    // An evicted space comes back from disk right away, Torii fills in the rest
+    if (EvictedSpaces.Remove(GetCurrentIslandKey()) > 0)
+    {
+        RestoreSpaceFromDisk(GetCurrentIslandKey());
+        if (DojoHelpers && !bReplayMode)
+        {
+            DojoHelpers->RefetchKeyPrefix({ CurrentSpaceOwner.ToHex(), FString::Printf(TEXT("0x%x"), CurrentSpaceId) });
+        }
+    }
 
     // Reset structure type if returning to main space
     if (bReturningToSpace1)
@@ -1805,17 +2136,17 @@ void ADojoCraftIslandManager::HandleSpaceTransition(UDojoModelCraftIslandPocketP
     if (!(bReturningToSpace1 && !bSpace1ActorsHidden))
     {
         // Load chunks from cache for the new space
-        FString NewIslandKey = GetCurrentIslandKey();
+        FSpaceKey NewIslandKey = GetCurrentIslandKey();
 
-        if (ChunkCache.Contains(NewIslandKey))
+        if (FSpaceChunks* SpaceDataPtr = ChunkCache.Find(NewIslandKey))
         {
-            FSpaceChunks& SpaceData = ChunkCache[NewIslandKey];
-            UE_LOG(LogTemp, Log, TEXT("Found cache for space %s with %d chunks"), *NewIslandKey, SpaceData.Chunks.Num());
+            FSpaceChunks& SpaceData = *SpaceDataPtr;
+            UE_LOG(LogTemp, Log, TEXT("Found cache for space %s with %d chunks"), *NewIslandKey.ToString(), SpaceData.Chunks.Num());
 
             // Check if there are any block chunks
             for (const auto& ChunkPair : SpaceData.Chunks)
             {
-                if (ChunkPair.Value && (ChunkPair.Value->Blocks1 != "0x0" || ChunkPair.Value->Blocks2 != "0x0"))
+                if (!ChunkPair.Value.IsEmpty())
                 {
                     bHasBlockChunks = true;
                     break;
@@ -1824,13 +2155,13 @@ void ADojoCraftIslandManager::HandleSpaceTransition(UDojoModelCraftIslandPocketP
 
             if (bHasBlockChunks)
             {
-                UE_LOG(LogTemp, Log, TEXT("Loading cached data for space %s"), *NewIslandKey);
+                UE_LOG(LogTemp, Log, TEXT("Loading cached data for space %s"), *NewIslandKey.ToString());
                 LoadAllChunksFromCache();
             }
         }
         else
         {
-            UE_LOG(LogTemp, Log, TEXT("No cached data for space %s"), *NewIslandKey);
+            UE_LOG(LogTemp, Log, TEXT("No cached data for space %s"), *NewIslandKey.ToString());
         }
     }
     else
@@ -1937,7 +2268,7 @@ void ADojoCraftIslandManager::HandleSpaceTransition(UDojoModelCraftIslandPocketP
     }
 
     // Handle player teleportation
-    FString NewSpaceKey = GetCurrentIslandKey();
+    FSpaceKey NewSpaceKey = GetCurrentIslandKey();
     FVector NewLocation = GetSpawnPositionForSpace(NewSpaceKey, bHasBlockChunks);
     TeleportPlayer(NewLocation, bReturningToSpace1);
 }
@@ -1959,12 +2290,12 @@ void ADojoCraftIslandManager::ClearAllSpawnedActors()
 
     UE_LOG(LogTemp, Warning, TEXT("=== CLEAR ACTORS START ==="));
     UE_LOG(LogTemp, Warning, TEXT("ClearAllSpawnedActors: CurrentSpace=%s:%d, Account=%s"),
-        *CurrentSpaceOwner, CurrentSpaceId, *Account.Address);
+        *CurrentSpaceOwner.ToHex(), CurrentSpaceId, *Account.Address);
     UE_LOG(LogTemp, Warning, TEXT("ClearAllSpawnedActors: Actors.Num()=%d, bSpace1ActorsHidden=%d"), 
         Actors.Num(), bSpace1ActorsHidden);
 
     // Check if we're currently in space 1
-    bool bLeavingSpace1 = (CurrentSpaceOwner == Account.Address && CurrentSpaceId == 1);
+    bool bLeavingSpace1 = (CurrentSpaceOwner == AccountAddress && CurrentSpaceId == 1);
 
     UE_LOG(LogTemp, Warning, TEXT("ClearAllSpawnedActors: bLeavingSpace1=%d"), bLeavingSpace1);
 
@@ -2122,48 +2453,30 @@ void ADojoCraftIslandManager::ProcessChunkBlock(uint8 Byte, const FIntVector& Do
     }
 }
 
-void ADojoCraftIslandManager::ProcessIslandChunk(UDojoModelCraftIslandPocketIslandChunk* Chunk)
+void ADojoCraftIslandManager::ProcessIslandChunk(const FSpaceKey& Space, const FChunkKey& Key, const FCompactChunk& Chunk)
 {
-    if (!Chunk) return;
-
-    UE_LOG(LogTemp, Log, TEXT("ProcessIslandChunk: Checking chunk %s, owner=%s, currentOwner=%s, account=%s"),
-        *Chunk->ChunkId, *Chunk->IslandOwner, *CurrentSpaceOwner, *Account.Address);
+    UE_LOG(LogTemp, Log, TEXT("ProcessIslandChunk: Checking chunk %s, space=%s, currentOwner=%s, account=%s"),
+        *Key.ToString(), *Space.ToString(), *CurrentSpaceOwner.ToHex(), *Account.Address);
 
     // When loading from cache, we should check against CurrentSpaceOwner instead of Account.Address
-    if (Chunk->IslandOwner != CurrentSpaceOwner)
+    if (Space.Owner != CurrentSpaceOwner)
     {
         UE_LOG(LogTemp, VeryVerbose, TEXT("ProcessIslandChunk: Skipping chunk due to owner mismatch"));
         return;
     }
 
-    UE_LOG(LogTemp, Log, TEXT("ProcessIslandChunk: Processing chunk %s with blocks1=%s, blocks2=%s"),
-        *Chunk->ChunkId, *Chunk->Blocks1, *Chunk->Blocks2);
-
-    FString Blocks = Chunk->Blocks1.Mid(2) + Chunk->Blocks2.Mid(2);
-
-    // Validate chunk data length
-    if (Blocks.Len() != 64)
-    {
-        UE_LOG(LogTemp, Error, TEXT("Invalid chunk data length: %d, expected 64 for chunk %s"),
-            Blocks.Len(), *Chunk->ChunkId);
-        return;
-    }
-
-    FString SubStr = Blocks.Reverse();
-    FIntVector ChunkOffset = HexStringToVector(Chunk->ChunkId);
+    FIntVector ChunkOffset = Key.GetCoordinates();
 
     // Process chunk data and batch add to queue
     TArray<FSpawnQueueData> ChunkSpawnData;
 
-    int32 Index = 0;
-    for (TCHAR Char : SubStr)
+    for (int32 Index = 0; Index < DojoDecoders::BLOCKS_PER_CHUNK; Index++)
     {
-        uint8 Byte = FParse::HexDigit(Char);
+        uint8 Byte = Chunk.GetBlock(Index);
         E_Item Item = static_cast<E_Item>(Byte);
         FIntVector DojoPos = GetWorldPositionFromLocal(Index, ChunkOffset);
 
         ProcessChunkBlock(Byte, DojoPos, Item, ChunkSpawnData);
-        Index++;
     }
 
     QueueSpawnBatchWithOverflowProtection(ChunkSpawnData);
@@ -2171,7 +2484,7 @@ void ADojoCraftIslandManager::ProcessIslandChunk(UDojoModelCraftIslandPocketIsla
 
 void ADojoCraftIslandManager::ProcessGatherableResource(UDojoModelCraftIslandPocketGatherableResource* Gatherable)
 {
-    if (!Gatherable || Gatherable->IslandOwner != CurrentSpaceOwner)
+    if (!Gatherable || FFelt252::FromHex(Gatherable->IslandOwner) != CurrentSpaceOwner)
     {
         return;
     }
@@ -2192,7 +2505,7 @@ void ADojoCraftIslandManager::ProcessGatherableResource(UDojoModelCraftIslandPoc
 
 void ADojoCraftIslandManager::ProcessWorldStructure(UDojoModelCraftIslandPocketWorldStructure* Structure)
 {
-    if (!Structure || Structure->IslandOwner != CurrentSpaceOwner) return;
+    if (!Structure || FFelt252::FromHex(Structure->IslandOwner) != CurrentSpaceOwner) return;
 
     FIntVector ChunkOffset = HexStringToVector(Structure->ChunkId);
     E_Item Item = static_cast<E_Item>(Structure->StructureType);
@@ -2239,16 +2552,18 @@ void ADojoCraftIslandManager::ProcessWorldStructure(UDojoModelCraftIslandPocketW
 
 void ADojoCraftIslandManager::LoadChunkFromCache(const FString& ChunkId)
 {
-    FString IslandKey = GetCurrentIslandKey();
-    if (!ChunkCache.Contains(IslandKey)) return;
+    FSpaceChunks* SpaceDataPtr = ChunkCache.Find(GetCurrentIslandKey());
+    if (!SpaceDataPtr) return;
 
-    FSpaceChunks& SpaceData = ChunkCache[IslandKey];
+    FSpaceChunks& SpaceData = *SpaceDataPtr;
+
+    const FChunkKey Chunk = FChunkKey::FromHex(ChunkId);
 
     // Load chunk blocks
-    if (SpaceData.Chunks.Contains(ChunkId))
+    if (const FCompactChunk* CompactChunk = SpaceData.Chunks.Find(Chunk))
     {
         UE_LOG(LogTemp, Log, TEXT("LoadChunkFromCache: Found chunk %s, processing it"), *ChunkId);
-        ProcessIslandChunk(SpaceData.Chunks[ChunkId]);
+        ProcessIslandChunk(GetCurrentIslandKey(), Chunk, *CompactChunk);
     }
     else
     {
@@ -2259,19 +2574,22 @@ void ADojoCraftIslandManager::LoadChunkFromCache(const FString& ChunkId)
             UE_LOG(LogTemp, VeryVerbose, TEXT("LoadChunkFromCache: Chunk %s not found in cache. Available chunks:"), *ChunkId);
             for (const auto& ChunkPair : SpaceData.Chunks)
             {
-                UE_LOG(LogTemp, VeryVerbose, TEXT("  - %s"), *ChunkPair.Key);
+                UE_LOG(LogTemp, VeryVerbose, TEXT("  - %s"), *ChunkPair.Key.ToString());
             }
             LogCount++;
         }
     }
 
-    // Load gatherables for this chunk
+    // Gatherables and structures come from the chunk's own index, not a scan of the space
+    const FChunkContents* Contents = SpaceData.FindContents(Chunk);
+    if (!Contents) return;
+
     int32 GatherableCount = 0;
-    for (const auto& Pair : SpaceData.Gatherables)
+    for (uint8 Position : Contents->GatherablePositions)
     {
-        if (Pair.Value && Pair.Value->ChunkId == ChunkId)
+        if (UDojoModelCraftIslandPocketGatherableResource* const* Gatherable = SpaceData.Gatherables.Find(FChunkItemKey(Chunk, Position)))
         {
-            ProcessGatherableResource(Pair.Value);
+            ProcessGatherableResource(*Gatherable);
             GatherableCount++;
         }
     }
@@ -2280,13 +2598,12 @@ void ADojoCraftIslandManager::LoadChunkFromCache(const FString& ChunkId)
         UE_LOG(LogTemp, Log, TEXT("LoadChunkFromCache: Processed %d gatherables for chunk %s"), GatherableCount, *ChunkId);
     }
 
-    // Load structures for this chunk
     int32 StructureCount = 0;
-    for (const auto& Pair : SpaceData.Structures)
+    for (uint8 Position : Contents->StructurePositions)
     {
-        if (Pair.Value && Pair.Value->ChunkId == ChunkId)
+        if (UDojoModelCraftIslandPocketWorldStructure* const* Structure = SpaceData.Structures.Find(FChunkItemKey(Chunk, Position)))
         {
-            ProcessWorldStructure(Pair.Value);
+            ProcessWorldStructure(*Structure);
             StructureCount++;
         }
     }
@@ -2298,22 +2615,19 @@ void ADojoCraftIslandManager::LoadChunkFromCache(const FString& ChunkId)
 
 void ADojoCraftIslandManager::LoadAllChunksFromCache()
 {
-    FString IslandKey = GetCurrentIslandKey();
-    if (!ChunkCache.Contains(IslandKey)) return;
+    FSpaceChunks* SpaceDataPtr = ChunkCache.Find(GetCurrentIslandKey());
+    if (!SpaceDataPtr) return;
 
-    FSpaceChunks& SpaceData = ChunkCache[IslandKey];
+    FSpaceChunks& SpaceData = *SpaceDataPtr;
 
-    UE_LOG(LogTemp, Log, TEXT("LoadAllChunksFromCache: Loading all chunks for key %s"), *IslandKey);
+    UE_LOG(LogTemp, Log, TEXT("LoadAllChunksFromCache: Loading all chunks for key %s"), *GetCurrentIslandKey().ToString());
 
     // Load all chunks
     int32 ChunksLoaded = 0;
     for (const auto& ChunkPair : SpaceData.Chunks)
     {
-        if (ChunkPair.Value)
-        {
-            ProcessIslandChunk(ChunkPair.Value);
-            ChunksLoaded++;
-        }
+        ProcessIslandChunk(GetCurrentIslandKey(), ChunkPair.Key, ChunkPair.Value);
+        ChunksLoaded++;
     }
     UE_LOG(LogTemp, Log, TEXT("LoadAllChunksFromCache: Loaded %d chunks"), ChunksLoaded);
 
@@ -2447,55 +2761,148 @@ void ADojoCraftIslandManager::AddOptimisticRemoval(const FIntVector& Position)
 
 void ADojoCraftIslandManager::ConfirmOptimisticAction(const FIntVector& Position)
 {
-    if (OptimisticActors.Contains(Position))
+    AActor** Found = OptimisticActors.Find(Position);
+    if (!Found) return;
+
+    // The chain accepted it: the optimistic timeout no longer applies
+    AActor* OptimisticActor = *Found;
+    OptimisticActorTimestamps.Remove(Position);
+    if (!IsValid(OptimisticActor))
     {
-        AActor* OptimisticActor = OptimisticActors[Position];
-        if (OptimisticActor)
-        {
-            RemovePendingVisual(OptimisticActor);
-        }
         OptimisticActors.Remove(Position);
-        OptimisticActorTimestamps.Remove(Position);
+        return;
     }
-}
 
-void ADojoCraftIslandManager::RollbackOptimisticAction(const FIntVector& Position)
-{
-    if (OptimisticActors.Contains(Position))
+    if (OptimisticActor->Tags.Contains(FName("OptimisticRemoval")))
     {
-        AActor* OptimisticActor = OptimisticActors[Position];
-        if (OptimisticActor)
+        // A hit doesn't always empty the cell (regrowing gatherables, blocks that take several hits):
+        // only the state says so. If it isn't in yet, the model update removes the restored actor.
+        const FActorSpawnInfo* SpawnInfo = ActorSpawnInfo.Find(Position);
+        if (SpawnInfo && IsConfirmedEmpty(Position, SpawnInfo->SpawnType))
         {
-            // Play a disappear animation or effect
             OptimisticActor->Destroy();
+            Actors.Remove(Position);
+            ActorSpawnInfo.Remove(Position);
+        }
+        else
+        {
+            RestoreOptimisticRemoval(OptimisticActor);
         }
         OptimisticActors.Remove(Position);
-        OptimisticActorTimestamps.Remove(Position);
-
-        UE_LOG(LogTemp, Warning, TEXT("Rolled back optimistic action at position (%d, %d, %d)"),
-            Position.X, Position.Y, Position.Z);
+    }
+    else
+    {
+        // Shown as final right away; the model update still moves it into Actors
+        RemovePendingVisual(OptimisticActor);
+    }
+}
+
+bool ADojoCraftIslandManager::IsConfirmedEmpty(const FIntVector& Position, EActorSpawnType Type) const
+{
+    const FSpaceChunks* Space = ChunkCache.Find(GetCurrentIslandKey());
+    if (!Space) return false;
+
+    // Inverse of GetWorldPositionFromLocal
+    const FIntVector Local = Position - FIntVector(8192);
+    const FChunkKey Chunk = FChunkKey::FromCoordinates(FIntVector(Local.X >> 2, Local.Y >> 2, Local.Z >> 2));
+    const uint8 Cell = static_cast<uint8>((Local.X & 3) + (Local.Y & 3) * 4 + (Local.Z & 3) * 16);
+
+    switch (Type)
+    {
+        case EActorSpawnType::ChunkBlock:
+        {
+            const FCompactChunk* Blocks = Space->Chunks.Find(Chunk);
+            return Blocks && Blocks->GetBlock(Cell) == 0;
+        }
+        case EActorSpawnType::GatherableResource:
+        {
+            UDojoModelCraftIslandPocketGatherableResource* const* Gatherable = Space->Gatherables.Find(FChunkItemKey(Chunk, Cell));
+            return Gatherable && *Gatherable && static_cast<E_Item>((*Gatherable)->ResourceId) == E_Item::None;
+        }
+        case EActorSpawnType::WorldStructure:
+        {
+            UDojoModelCraftIslandPocketWorldStructure* const* Structure = Space->Structures.Find(FChunkItemKey(Chunk, Cell));
+            return Structure && *Structure && static_cast<E_Item>((*Structure)->StructureType) == E_Item::None;
+        }
+        default:
+            return false;
+    }
+}
+
+void ADojoCraftIslandManager::RollbackOptimisticAction(const FIntVector& Position)
+{
+    if (OptimisticActors.Contains(Position))
+    {
+        AActor* OptimisticActor = OptimisticActors[Position];
+        if (IsValid(OptimisticActor) && OptimisticActor->Tags.Contains(FName("OptimisticRemoval")))
+        {
+            // The block is still there: undo the removal look instead of destroying it
+            RestoreOptimisticRemoval(OptimisticActor);
+        }
+        else if (OptimisticActor)
+        {
+            // Play a disappear animation or effect
+            OptimisticActor->Destroy();
+        }
+        OptimisticActors.Remove(Position);
+        OptimisticActorTimestamps.Remove(Position);
+
+        UE_LOG(LogTemp, Warning, TEXT("Rolled back optimistic action at position (%d, %d, %d)"),
+            Position.X, Position.Y, Position.Z);
     }
 }
 
+void ADojoCraftIslandManager::RestoreOptimisticRemoval(AActor* Actor)
+{
+    TArray<UActorComponent*> MeshComponents = Actor->GetComponents().Array();
+    for (UActorComponent* Component : MeshComponents)
+    {
+        if (UStaticMeshComponent* MeshComp = Cast<UStaticMeshComponent>(Component))
+        {
+            for (int32 i = 0; i < MeshComp->GetNumMaterials(); i++)
+            {
+                if (UMaterialInstanceDynamic* DynMaterial = Cast<UMaterialInstanceDynamic>(MeshComp->GetMaterial(i)))
+                {
+                    DynMaterial->SetScalarParameterValue(FName("Opacity"), 1.0f);
+                    DynMaterial->SetVectorParameterValue(FName("EmissiveColor"), FLinearColor::Black);
+                }
+            }
+        }
+    }
+
+    // Scale and collision
+    RemovePendingVisual(Actor);
+    Actor->Tags.Remove(FName("OptimisticRemoval"));
+}
+
 void ADojoCraftIslandManager::QueueTransaction(const FTransactionQueueItem& Item)
 {
     FScopeLock Lock(&TransactionQueueMutex);
     
     // Prevent unbounded queue growth
-    if (TransactionQueueCount >= MAX_QUEUE_SIZE)
+    if (TransactionQueue.Num() >= MAX_QUEUE_SIZE)
     {
         UE_LOG(LogTemp, Warning, TEXT("Transaction queue is full (%d items), dropping oldest transactions"), MAX_QUEUE_SIZE);
         // Remove oldest items until we have room
-        while (TransactionQueueCount >= MAX_QUEUE_SIZE - 10 && !TransactionQueue.IsEmpty())
+        while (TransactionQueue.Num() >= MAX_QUEUE_SIZE - 10)
         {
-            FTransactionQueueItem DroppedItem;
-            TransactionQueue.Dequeue(DroppedItem);
-            TransactionQueueCount--;
+            TransactionQueue.PopFirst();
         }
     }
-    
-    TransactionQueue.Enqueue(Item);
-    TransactionQueueCount++;
+
+    const double Now = GetWorld()->GetTimeSeconds();
+    if (LastActionQueuedAt >= 0.0)
+    {
+        const double Interval = FMath::Min(Now - LastActionQueuedAt, INPUT_IDLE_SECONDS);
+        InputIntervalEma = InputIntervalEma > 0.0
+            ? FMath::Lerp(InputIntervalEma, Interval, BATCH_EMA_WEIGHT)
+            : Interval;
+    }
+    LastActionQueuedAt = Now;
+
+    FTransactionQueueItem& Queued = TransactionQueue.EmplaceLast(Item);
+    Queued.QueuedAt = Now;
+    bPendingActionsDirty = true;
     
     // Notify about queue update
     OnActionQueueUpdate.Broadcast(GetPendingActionCount());
@@ -2506,8 +2913,8 @@ void ADojoCraftIslandManager::QueueTransaction(const FTransactionQueueItem& Item
         GI->OnActionQueueUpdate.Broadcast(GetPendingActionCount());
     }
 
-    // If not already processing, start processing the queue
-    if (!bIsProcessingTransaction)
+    // Start a batch right away if the pipeline has room
+    if (CanSubmitTransaction())
     {
         ProcessNextTransaction();
     }
@@ -2517,200 +2924,419 @@ void ADojoCraftIslandManager::ProcessNextTransaction()
 {
     // Cancel any existing batch timer
     GetWorld()->GetTimerManager().ClearTimer(BatchTimerHandle);
+
+    // Pipeline full: the next confirmation, rejection or timeout calls us again
+    if (!CanSubmitTransaction()) return;
     
-    // Collect batchable actions
+    // Collect batchable actions: packed ones, or a run of ones sent as their own calls (ActionCalls)
     TArray<FTransactionQueueItem> BatchedActions;
-    int32 TotalBits = 0;
+    TArray<FDojoCall> ActionCalls;
+    int32 NumPacked = 0;
+    DojoActionPacking::FPackPlanner Planner;
+    int32 CallsCalldata = 0;
+    bool bBatchClosed = false; // the next action can't join this batch anyway
+    double HoldSeconds = 0.0;
+    
+    int32 Coalesced = 0;
     
     // Lock for queue access
     {
         FScopeLock Lock(&TransactionQueueMutex);
-        
-        // Try to collect as many actions as can fit
-        while (!TransactionQueue.IsEmpty() && BatchedActions.Num() < MAX_BATCH_SIZE)
-        {
-        FTransactionQueueItem* PeekedItem = TransactionQueue.Peek();
-        if (!PeekedItem) break;
-        
-        // Check if this action can be batched
-        if (CanBatchAction(PeekedItem->Type))
+
+        // Optimise what's queued since the last pass, before any of it is sent
+        if (bPendingActionsDirty)
         {
-            int32 ActionSize = GetActionSize(PeekedItem->Type);
-            
-            // Check if we have room (conservative estimate)
-            if (TotalBits + ActionSize > 240 && BatchedActions.Num() > 0)
+            bPendingActionsDirty = false;
+            TArray<FTransactionQueueItem> Pending;
+            Pending.Reserve(TransactionQueue.Num());
+            while (!TransactionQueue.IsEmpty())
             {
-                break; // This action would overflow, send what we have
+                Pending.Add(MoveTemp(TransactionQueue.First()));
+                TransactionQueue.PopFirst();
             }
-            
-            FTransactionQueueItem Item;
-            TransactionQueue.Dequeue(Item);
-            TransactionQueueCount--;
-            BatchedActions.Add(Item);
-            TotalBits += ActionSize;
-            
-            // Force send if we have enough actions
-            if (BatchedActions.Num() >= FORCE_SEND_SIZE)
+            Coalesced = CoalescePendingActions(Pending);
+            for (FTransactionQueueItem& Action : Pending)
             {
-                break;
+                TransactionQueue.PushLast(MoveTemp(Action));
             }
         }
-        else
+        
+        // Try to collect as many actions as can fit
+        while (!TransactionQueue.IsEmpty())
         {
-            // Non-batchable action
-            if (BatchedActions.Num() > 0)
+            const FTransactionQueueItem& PeekedItem = TransactionQueue.First();
+
+            // Calls panic on failure and revert the whole transaction, while execute_packed_actions reports
+            // each action's failure and carries on: a transaction holds packed actions or calls, never both
+            DojoActionPacking::FPackedAction Packed;
+            const bool bPackable = ToPackedAction(PeekedItem, Packed);
+            if (bPackable ? ActionCalls.Num() > 0 : NumPacked > 0)
             {
-                // Send batched actions first
+                bBatchClosed = true;
                 break;
             }
-            else
+
+            if (bPackable)
             {
-                // Process single large action
-                FTransactionQueueItem Item;
-                TransactionQueue.Dequeue(Item);
-                TransactionQueueCount--;
-                BatchedActions.Add(Item);
+                // Packed the way EncodePackedActions will: stop once it would take more felts than the contract reads
+                if (!Planner.Add(Packed, MAX_PACKED_FELTS))
+                {
+                    bBatchClosed = true;
+                    break;
+                }
+
+                BatchedActions.Add(PeekedItem);
+                TransactionQueue.PopFirst();
+                NumPacked++;
+                continue;
+            }
+
+            // Doesn't pack (a buy of several items, a name): its own call, in queue order.
+            // Consecutive calls share the transaction and succeed or revert together.
+            FDojoCall ActionCall;
+            if (!ToActionCall(PeekedItem, ActionCall))
+            {
+                if (BatchedActions.Num() == 0)
+                {
+                    UE_LOG(LogTemp, Error, TEXT("ProcessNextTransaction: action type %d can't be sent, dropping it"),
+                        (int32)PeekedItem.Type);
+                    TransactionQueue.PopFirst();
+                    continue;
+                }
+                bBatchClosed = true;
+                break;
+            }
+
+            if (CallsCalldata + ActionCall.Calldata.Num() > MAX_CALLS_CALLDATA && BatchedActions.Num() > 0)
+            {
+                bBatchClosed = true;
                 break;
             }
+
+            BatchedActions.Add(PeekedItem);
+            TransactionQueue.PopFirst();
+            CallsCalldata += ActionCall.Calldata.Num();
+            ActionCalls.Add(MoveTemp(ActionCall));
+        }
+
+        // FlushActionQueue sends everything queued so far without waiting
+        if (TransactionQueue.IsEmpty())
+        {
+            bFlushRequested = false;
+        }
+
+        // Room left and more input expected soon: hold the batch back, in order, until its window closes
+        if (!bBatchClosed && !bFlushRequested && BatchedActions.Num() > 0)
+        {
+            const double Fill = NumPacked > 0
+                ? static_cast<double>(Planner.GetNumFelts()) / MAX_PACKED_FELTS
+                : static_cast<double>(CallsCalldata) / MAX_CALLS_CALLDATA;
+            const double Deadline = BatchedActions[0].QueuedAt + GetBatchWindow(BatchedActions.Num(), Fill);
+            HoldSeconds = Deadline - GetWorld()->GetTimeSeconds();
+            if (HoldSeconds > 0.0)
+            {
+                for (int32 i = BatchedActions.Num() - 1; i >= 0; i--)
+                {
+                    TransactionQueue.PushFirst(MoveTemp(BatchedActions[i]));
+                }
+                BatchedActions.Reset();
+            }
         }
-        } // End while loop
     } // End lock scope
+
+    if (Coalesced > 0)
+    {
+        OnActionQueueUpdate.Broadcast(GetPendingActionCount());
+    }
+
+    if (HoldSeconds > 0.0)
+    {
+        GetWorld()->GetTimerManager().SetTimer(BatchTimerHandle, this,
+            &ADojoCraftIslandManager::ProcessNextTransaction, HoldSeconds, false);
+        return;
+    }
     
     // If we have actions to process
     if (BatchedActions.Num() > 0)
     {
-        // Check if we should wait for more actions (need to check queue size safely)
-        bool bQueueNotEmpty = false;
+        FInFlightTransaction& InFlight = InFlightTransactions.AddDefaulted_GetRef();
+        InFlight.Id = NextTransactionId++;
+        InFlight.SentAt = GetWorld()->GetTimeSeconds();
+        InFlight.Actions = BatchedActions;
+        InFlight.NumPacked = NumPacked;
+        const int32 TransactionId = InFlight.Id;
+
+        // Each in-flight transaction times out on its own
+        if (!GetWorld()->GetTimerManager().IsTimerActive(TransactionTimeoutHandle))
         {
-            FScopeLock QueueLock(&TransactionQueueMutex);
-            bQueueNotEmpty = !TransactionQueue.IsEmpty();
+            GetWorld()->GetTimerManager().SetTimer(TransactionTimeoutHandle, this,
+                &ADojoCraftIslandManager::CheckTransactionTimeouts, 1.0f, true);
         }
         
-        bool bShouldWait = BatchedActions.Num() < 3 && 
-                          bQueueNotEmpty && 
-                          CanBatchAction(BatchedActions[0].Type);
-        
-        if (bShouldWait)
+        // Use new universal encoder
+        TArray<FFelt252> PackedActions;
+        if (NumPacked > 0)
         {
-            // Set timer to wait for more actions
-            GetWorld()->GetTimerManager().SetTimer(BatchTimerHandle, [this]()
-            {
-                ProcessNextTransaction();
-            }, BATCH_WAIT_TIME, false);
-            
-            // Re-queue the actions we dequeued
-            for (int32 i = BatchedActions.Num() - 1; i >= 0; i--)
-            {
-                // Note: TQueue doesn't support re-queuing at front, so this is a limitation
-                // In production, we'd use a different data structure
-            }
-            return;
+            PackedActions = EncodePackedActions(MakeArrayView(BatchedActions.GetData(), NumPacked));
         }
-        
-        bIsProcessingTransaction = true;
-        
-        // Set timeout
-        GetWorld()->GetTimerManager().SetTimer(TransactionTimeoutHandle, [this]()
+        if (ActionCalls.Num() > 0)
         {
-            UE_LOG(LogTemp, Warning, TEXT("Transaction timeout reached, forcing completion"));
-            OnTransactionComplete();
-        }, 15.0f, false);
-        
-        // Use new universal encoder
-        TArray<FString> PackedActions = EncodePackedActions(BatchedActions);
-        
-        
-        // Call the new execute_packed_actions method
+            UE_LOG(LogTemp, Log, TEXT("Transaction %d: %d packed actions and %d calls (%d calldata felts)"),
+                TransactionId, NumPacked, ActionCalls.Num(), CallsCalldata);
+        }
+
+        // One transaction: execute_packed_actions, or the calls
         if (DojoHelpers)
         {
-            
-            // Use the universal packing system
-            DojoHelpers->CallCraftIslandPocketActionsExecutePackedActions(Account, PackedActions);
+            DojoHelpers->SubmitActions(Account, PackedActions, ActionCalls,
+                FOnDojoTransactionSubmitted::CreateUObject(this, &ADojoCraftIslandManager::OnTransactionSubmitted, TransactionId));
+        }
+
+        // Keep the pipeline full: the next batch doesn't wait for this one to be confirmed
+        bool bMoreQueued = false;
+        {
+            FScopeLock QueueLock(&TransactionQueueMutex);
+            bMoreQueued = !TransactionQueue.IsEmpty();
+        }
+        if (bMoreQueued && CanSubmitTransaction())
+        {
+            GetWorld()->GetTimerManager().SetTimerForNextTick(this, &ADojoCraftIslandManager::ProcessNextTransaction);
         }
-        
     }
-    else
+}
+
+void ADojoCraftIslandManager::FinishTransaction(int32 Index, bool bSucceeded, const TArray<bool>& Results)
+{
+    const FInFlightTransaction Transaction = MoveTemp(InFlightTransactions[Index]);
+    InFlightTransactions.RemoveAt(Index);
+    if (InFlightTransactions.Num() == 0)
     {
-        bIsProcessingTransaction = false;
+        GetWorld()->GetTimerManager().ClearTimer(TransactionTimeoutHandle);
     }
+
+    int32 Failed = 0;
+    for (int32 i = 0; i < Transaction.Actions.Num(); i++)
+    {
+        const bool bActionSucceeded = Results.IsValidIndex(i) ? Results[i] : bSucceeded;
+        if (bActionSucceeded)
+        {
+            ConfirmTransactionAction(Transaction.Actions[i]);
+        }
+        else
+        {
+            RollbackTransactionAction(Transaction.Actions[i]);
+            Failed++;
+        }
+    }
+    UE_LOG(LogTemp, Log, TEXT("Transaction %d (%s) %s, %d/%d actions failed"), Transaction.Id, *Transaction.Hash.ToHex(),
+        bSucceeded ? TEXT("executed") : TEXT("reverted"), Failed, Transaction.Actions.Num());
+
+    // Notify about queue update
+    OnActionQueueUpdate.Broadcast(GetPendingActionCount());
+    
+    // Forward to GameInstance
+    if (UCraftIslandGameInst* GI = Cast<UCraftIslandGameInst>(GetGameInstance()))
+    {
+        GI->OnActionQueueUpdate.Broadcast(GetPendingActionCount());
+    }
+
+    ProcessNextTransaction();
 }
 
-void ADojoCraftIslandManager::ProcessSingleAction(const FTransactionQueueItem& Action)
+bool ADojoCraftIslandManager::CanSubmitTransaction() const
+{
+    int32 Pending = 0;
+    for (const FInFlightTransaction& Transaction : InFlightTransactions)
+    {
+        if (!Transaction.bExecuted) Pending++;
+    }
+    return Pending < FMath::Max(1, MaxTransactionsInFlight);
+}
+
+int32 ADojoCraftIslandManager::FindSubmittedTransaction(const FFelt252& TransactionHash) const
+{
+    return InFlightTransactions.IndexOfByPredicate([&TransactionHash](const FInFlightTransaction& Transaction)
+    {
+        return Transaction.bSubmitted && Transaction.Hash == TransactionHash;
+    });
+}
+
+void ADojoCraftIslandManager::HandleTransactionStatus(const FFelt252& TransactionHash, EDojoTransactionStatus Status)
+{
+    // Not ours, or already finished (Torii, the receipt and the results event all report it)
+    const int32 Index = FindSubmittedTransaction(TransactionHash);
+    if (Index == INDEX_NONE) return;
+
+    FInFlightTransaction& Transaction = InFlightTransactions[Index];
+
+    // Calls besides execute_packed_actions report no per-action results
+    const bool bAwaitingResults = DojoHelpers && DojoHelpers->HasPackedActionsResults() && Transaction.NumPacked > 0;
+    if (Status == EDojoTransactionStatus::Unknown)
+    {
+        // Nothing says whether it executed. Only an executed batch emits its results event, which still settles it
+        // (or the timeout does); without one, leave the optimistic state to the model updates and free the slot now.
+        if (bAwaitingResults)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Transaction %d: receipt status unknown, waiting for its results"), Transaction.Id);
+            return;
+        }
+        UE_LOG(LogTemp, Warning, TEXT("Transaction %d: receipt status unknown, left to the model updates"), Transaction.Id);
+        InFlightTransactions.RemoveAt(Index);
+        if (InFlightTransactions.Num() == 0)
+        {
+            GetWorld()->GetTimerManager().ClearTimer(TransactionTimeoutHandle);
+        }
+        ProcessNextTransaction();
+        return;
+    }
+
+    if (Status == EDojoTransactionStatus::Reverted)
+    {
+        FinishTransaction(Index, false);
+        return;
+    }
+
+    if (!Transaction.bExecuted)
+    {
+        RecordConfirmationLatency(Transaction.SentAt);
+    }
+    const bool bWasExecuted = Transaction.bExecuted;
+    Transaction.bExecuted = true;
+    if (Status == EDojoTransactionStatus::Succeeded)
+    {
+        Transaction.bConfirmed = true;
+    }
+
+    // Being indexed frees the pipeline slot but says nothing about the execution status: only the
+    // receipt finishes the batch
+    if (Transaction.bConfirmed && !bAwaitingResults)
+    {
+        FinishTransaction(Index, true);
+        return;
+    }
+    if (!bWasExecuted)
+    {
+        ProcessNextTransaction();
+    }
+}
+
+void ADojoCraftIslandManager::HandlePackedActionsResult(const FFelt252& TransactionHash, const TArray<bool>& Results)
+{
+    const int32 Index = FindSubmittedTransaction(TransactionHash);
+    if (Index == INDEX_NONE) return;
+
+    if (Results.Num() != InFlightTransactions[Index].NumPacked)
+    {
+        // Encoder and contract disagree on the layout: don't guess which action failed
+        UE_LOG(LogTemp, Warning, TEXT("Transaction %d: %d results for %d packed actions, confirming the batch as a whole"),
+            InFlightTransactions[Index].Id, Results.Num(), InFlightTransactions[Index].NumPacked);
+        FinishTransaction(Index, true);
+        return;
+    }
+    FinishTransaction(Index, true, Results);
+}
+
+void ADojoCraftIslandManager::OnTransactionSubmitted(const FDojoSubmitResult& Result, int32 TransactionId)
+{
+    const int32 Index = InFlightTransactions.IndexOfByPredicate([TransactionId](const FInFlightTransaction& Transaction)
+    {
+        return Transaction.Id == TransactionId;
+    });
+    if (Index == INDEX_NONE) return; // Already timed out
+
+    if (Result.bAccepted)
+    {
+        InFlightTransactions[Index].bSubmitted = true;
+        InFlightTransactions[Index].Nonce = Result.Nonce;
+        InFlightTransactions[Index].Hash = Result.TransactionHash;
+        UE_LOG(LogTemp, Log, TEXT("Transaction %d accepted with nonce %llu (%d in flight)"),
+            TransactionId, Result.Nonce, InFlightTransactions.Num());
+        return;
+    }
+
+    // Rejected before reaching the chain: nothing of it will happen, undo it now
+    UE_LOG(LogTemp, Warning, TEXT("Transaction %d rejected, rolling back %d actions"),
+        TransactionId, InFlightTransactions[Index].Actions.Num());
+    const TArray<FTransactionQueueItem> Actions = MoveTemp(InFlightTransactions[Index].Actions);
+    InFlightTransactions.RemoveAt(Index);
+    RollbackTransactionActions(Actions);
+
+    OnActionQueueUpdate.Broadcast(GetPendingActionCount());
+    ProcessNextTransaction();
+}
+
+void ADojoCraftIslandManager::CheckTransactionTimeouts()
+{
+    const double Now = GetWorld()->GetTimeSeconds();
+    int32 Expired = 0;
+    for (int32 Index = InFlightTransactions.Num() - 1; Index >= 0; Index--)
+    {
+        if (Now - InFlightTransactions[Index].SentAt <= TRANSACTION_TIMEOUT_SECONDS) continue;
+
+        if (InFlightTransactions[Index].bConfirmed)
+        {
+            // Executed but its results never arrived: the model updates settle the world
+            FinishTransaction(Index, true);
+        }
+        else
+        {
+            InFlightTransactions.RemoveAt(Index);
+            Expired++;
+        }
+    }
+
+    if (InFlightTransactions.Num() == 0)
+    {
+        GetWorld()->GetTimerManager().ClearTimer(TransactionTimeoutHandle);
+    }
+
+    if (Expired > 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Transaction timeout reached, forcing completion of %d transactions"), Expired);
+        ProcessNextTransaction();
+    }
+}
+
+void ADojoCraftIslandManager::RollbackTransactionActions(const TArray<FTransactionQueueItem>& Actions)
+{
+    for (const FTransactionQueueItem& Action : Actions)
+    {
+        RollbackTransactionAction(Action);
+    }
+}
+
+void ADojoCraftIslandManager::RollbackTransactionAction(const FTransactionQueueItem& Action)
 {
-    UE_LOG(LogTemp, Warning, TEXT("=== ProcessSingleAction START ==="));
-    UE_LOG(LogTemp, Warning, TEXT("Action Type: %d"), (int32)Action.Type);
-    
     switch (Action.Type)
     {
-        case ETransactionType::SelectHotbar:
-            DojoHelpers->CallCraftIslandPocketActionsSelectHotbarSlot(Account, Action.IntParam);
+        case ETransactionType::PlaceUse:
+        case ETransactionType::Hit:
+            RollbackOptimisticAction(Action.Position);
             break;
         case ETransactionType::MoveItem:
-            DojoHelpers->CallCraftIslandPocketActionsInventoryMoveItem(Account, 
-                Action.IntParam, Action.IntParam2, Action.IntParam3, Action.IntParam4);
-            break;
-        case ETransactionType::Craft:
-            DojoHelpers->CallCraftIslandPocketActionsCraft(Account, 
-                Action.IntParam, Action.Position.X, Action.Position.Y, Action.Position.Z);
-            break;
-        case ETransactionType::Buy:
-            // TODO: Handle multiple items
-            if (Action.ItemIds.Num() > 0 && Action.Quantities.Num() > 0)
-            {
-                DojoHelpers->CallCraftIslandPocketActionsBuy(Account, 
-                    Action.ItemIds[0], Action.Quantities[0]);
-            }
-            break;
-        case ETransactionType::Sell:
-            DojoHelpers->CallCraftIslandPocketActionsSell(Account);
-            break;
-        case ETransactionType::StartProcess:
-            DojoHelpers->CallCraftIslandPocketActionsStartProcessing(Account, 
-                Action.IntParam, Action.IntParam2);
-            break;
-        case ETransactionType::CancelProcess:
-            DojoHelpers->CallCraftIslandPocketActionsCancelProcessing(Account);
+            RollbackOptimisticInventoryMove(Action);
             break;
-        case ETransactionType::Visit:
-            DojoHelpers->CallCraftIslandPocketActionsVisit(Account, Action.IntParam);
+        default:
             break;
-        case ETransactionType::VisitNewIsland:
-            DojoHelpers->CallCraftIslandPocketActionsVisitNewIsland(Account);
+    }
+}
+
+void ADojoCraftIslandManager::ConfirmTransactionAction(const FTransactionQueueItem& Action)
+{
+    switch (Action.Type)
+    {
+        case ETransactionType::PlaceUse:
+        case ETransactionType::Hit:
+            ConfirmOptimisticAction(Action.Position);
             break;
-        case ETransactionType::GenerateIsland:
-            DojoHelpers->CallCraftIslandPocketActionsGenerateIslandPart(Account, 
-                Action.Position.X, Action.Position.Y, Action.Position.Z, Action.IntParam);
+        case ETransactionType::MoveItem:
+            RemovePendingInventoryMove(Action);
             break;
         default:
-            UE_LOG(LogTemp, Warning, TEXT("Unhandled transaction type: %d"), (int32)Action.Type);
             break;
     }
 }
 
-void ADojoCraftIslandManager::OnTransactionComplete()
-{
-    // Clear the timeout timer since transaction completed
-    GetWorld()->GetTimerManager().ClearTimer(TransactionTimeoutHandle);
-    
-    bIsProcessingTransaction = false;
-    
-    // Notify about queue update
-    OnActionQueueUpdate.Broadcast(GetPendingActionCount());
-    
-    // Forward to GameInstance
-    if (UCraftIslandGameInst* GI = Cast<UCraftIslandGameInst>(GetGameInstance()))
-    {
-        GI->OnActionQueueUpdate.Broadcast(GetPendingActionCount());
-    }
-
-    // Process next transaction in queue after a small delay
-    FTimerHandle TimerHandle;
-    GetWorld()->GetTimerManager().SetTimer(TimerHandle, [this]()
-    {
-        ProcessNextTransaction();
-    }, 0.1f, false);
-}
-
 // Removed old EncodeCompressedActions function - now using EncodePackedActions
 #if 0
 FString ADojoCraftIslandManager::EncodeCompressedActions(const TArray<FTransactionQueueItem>& Actions)
@@ -2888,9 +3514,10 @@ void ADojoCraftIslandManager::FlushActionQueue()
     {
         FScopeLock Lock(&TransactionQueueMutex);
         bHasPendingActions = !TransactionQueue.IsEmpty();
+        bFlushRequested = bHasPendingActions;
     }
     
-    if (!bIsProcessingTransaction && bHasPendingActions)
+    if (CanSubmitTransaction() && bHasPendingActions)
     {
         ProcessNextTransaction();
     }
@@ -2898,447 +3525,416 @@ void ADojoCraftIslandManager::FlushActionQueue()
 
 int32 ADojoCraftIslandManager::GetPendingActionCount() const
 {
-    return TransactionQueueCount;
+    FScopeLock Lock(&TransactionQueueMutex);
+    return TransactionQueue.Num();
 }
 
-// Universal action encoder implementation
-TArray<FString> ADojoCraftIslandManager::EncodePackedActions(const TArray<FTransactionQueueItem>& Actions)
+int32 ADojoCraftIslandManager::CoalescePendingActions(TArray<FTransactionQueueItem>& Actions)
 {
-    TArray<FString> PackedFelts;
-    int32 Index = 0;
-    
-    while (Index < Actions.Num())
+    const int32 NumBefore = Actions.Num();
+    TArray<bool> Dropped;
+    Dropped.Init(false, Actions.Num());
+
+    auto NextKept = [&Actions, &Dropped](int32 From, bool bSkipSelects) -> int32
     {
-        const FTransactionQueueItem& CurrentAction = Actions[Index];
-        
-        
-        // Determine which pack type to use
-        if (CurrentAction.Type == ETransactionType::MoveItem)
+        for (int32 j = From + 1; j < Actions.Num(); j++)
         {
-            // Try to pack Type 1 actions
-            FString Packed = PackType1Actions(Actions, Index);
-            if (!Packed.IsEmpty())
-            {
-                PackedFelts.Add(Packed);
-                continue;
-            }
-        }
-        else if (CanBatchAction(CurrentAction.Type) || 
-                 CurrentAction.Type == ETransactionType::PlaceUse || 
-                 CurrentAction.Type == ETransactionType::Hit)
-        {
-            // Try to pack Type 2 actions (now includes PlaceUse/Hit)
-            FString Packed = PackType2Actions(Actions, Index);
-            if (!Packed.IsEmpty())
-            {
-                PackedFelts.Add(Packed);
-                continue;
-            }
+            if (Dropped[j]) continue;
+            if (bSkipSelects && Actions[j].Type == ETransactionType::SelectHotbar) continue;
+            return j;
         }
-        
-        // Fall back to Type 3 for large actions
-        FString Packed = PackType3Action(CurrentAction);
-        PackedFelts.Add(Packed);
-        Index++;
-    }
-    
-    return PackedFelts;
-}
+        return INDEX_NONE;
+    };
 
-FString ADojoCraftIslandManager::PackType0Actions(const TArray<FTransactionQueueItem>& Actions, int32& Index)
-{
-    // Pack up to 8 PlaceUse/Hit actions
-    TArray<uint8> Bytes;
-    Bytes.SetNum(32);
-    for (int i = 0; i < 32; i++) Bytes[i] = 0;
-    
-    int32 BitOffset = 0;
-    
-    // Pack type (8 bits)
-    WriteBits(Bytes, BitOffset, 0, 8);
-    
-    int32 Count = 0;
-    int32 StartIndex = Index;
-    
-    // Reserve space for count (4 bits)
-    BitOffset += 4;
-    
-    // Pack actions
-    while (Index < Actions.Num() && Count < 8)
+    // 1. Place then hit on the same cell: the block never needs to exist on chain.
+    //    Only selections may sit in between (the placed item must still be in hand to come back).
+    for (int32 i = 0; i < Actions.Num(); i++)
     {
-        const FTransactionQueueItem& Action = Actions[Index];
-        if (Action.Type != ETransactionType::PlaceUse && Action.Type != ETransactionType::Hit)
+        if (Dropped[i] || Actions[i].Type != ETransactionType::PlaceUse) continue;
+        const int32 j = NextKept(i, true);
+        if (j == INDEX_NONE || Actions[j].Type != ETransactionType::Hit || Actions[j].Position != Actions[i].Position) continue;
+        if (!HitUndoesPendingPlacement(Actions[i], Actions[j])) continue;
+
+        Dropped[i] = Dropped[j] = true;
+
+        // The hit tagged the block for removal, so a rollback would restore it: take it out for good
+        const FIntVector Position = Actions[i].Position;
+        AActor* Placed = OptimisticActors.FindRef(Position);
+        OptimisticActors.Remove(Position);
+        OptimisticActorTimestamps.Remove(Position);
+        if (Actors.FindRef(Position) == Placed)
         {
-            break;
+            Actors.Remove(Position);
+            ActorSpawnInfo.Remove(Position);
         }
-        
-        // Calculate coordinates - use game coordinates directly
-        // The contract expects coordinates with 8192 offset (e.g., 8192,8192,8193)
-        uint32 X = Action.Position.X;
-        uint32 Y = Action.Position.Y;
-        uint32 Z = Action.Position.Z - 8192; // Convert back to blockchain coordinate system
-        uint32 ActionType = (Action.Type == ETransactionType::Hit) ? 1 : 0;
-        
-        // Pack 30 bits: [1 bit: action_type][14 bits: y][14 bits: x][1 bit: z]
-        // Bit positions: action_type(0), y(1-14), x(15-28), z(29)
-        uint32 PackedAction = (ActionType & 0x1) | ((Y & 0x3FFF) << 1) | ((X & 0x3FFF) << 15) | (Z << 29);
-        
-        UE_LOG(LogTemp, Warning, TEXT("Packing Type0 Action: Pos(%d,%d,%d) Z_bit=%d ActionType=%d PackedAction=0x%08X"), 
-            Action.Position.X, Action.Position.Y, Action.Position.Z, Z, ActionType, PackedAction);
-        UE_LOG(LogTemp, Warning, TEXT("  Raw values: X=%d(0x%X) Y=%d(0x%X) after mask: X=%d Y=%d"), 
-            X, X, Y, Y, X & 0x3FFF, Y & 0x3FFF);
-        
-        // Debug: Check individual components
-        uint32 ActionTypeCheck = PackedAction & 0x1;      // 1 bit for action type
-        uint32 YCheck = (PackedAction >> 1) & 0x3FFF;     // 14 bits for Y
-        uint32 XCheck = (PackedAction >> 15) & 0x3FFF;    // 14 bits for X
-        uint32 ZCheck = (PackedAction >> 29) & 0x1;       // 1 bit for Z at position 29
-        UE_LOG(LogTemp, Warning, TEXT("  Verify: ActionType=%d Y=%d X=%d Z=%d"), ActionTypeCheck, YCheck, XCheck, ZCheck);
-        
-        WriteBits(Bytes, BitOffset, PackedAction, 30);
-        
-        Count++;
-        Index++;
-    }
-    
-    // If no actions were packed, return empty
-    if (Count == 0)
-    {
-        Index = StartIndex;
-        return TEXT("");
+        Placed->Destroy();
     }
-    
-    // Write count
-    int32 CountOffset = 8;
-    WriteBits(Bytes, CountOffset, Count, 4);
-    
-    FString HexResult = BytesToHexString(Bytes);
-    UE_LOG(LogTemp, Warning, TEXT("PackType0Actions result: %s"), *HexResult);
-    
-    return HexResult;
-}
 
-FString ADojoCraftIslandManager::PackType1Actions(const TArray<FTransactionQueueItem>& Actions, int32& Index)
-{
-    // Pack up to 6 MoveItem actions
-    TArray<uint8> Bytes;
-    Bytes.SetNum(32);
-    for (int i = 0; i < 32; i++) Bytes[i] = 0;
-    
-    int32 BitOffset = 0;
-    
-    // Pack type (8 bits)
-    WriteBits(Bytes, BitOffset, 1, 8);
-    
-    int32 Count = 0;
-    int32 StartIndex = Index;
-    
-    // Reserve space for count (4 bits)
-    BitOffset += 4;
-    
-    // Pack actions
-    while (Index < Actions.Num() && Count < 6)
+    // 2. Inventory moves. The slot states of the last inventory update only describe what the moves
+    //    will find when nothing unconfirmed runs before them: no transaction in flight and only
+    //    selections or moves on other slots queued ahead.
+    auto SlotUntouchedBefore = [&Actions, &Dropped](int32 Index, int32 Inventory, int32 Slot)
     {
-        const FTransactionQueueItem& Action = Actions[Index];
-        if (Action.Type != ETransactionType::MoveItem)
+        for (int32 k = 0; k < Index; k++)
         {
-            break;
+            if (Dropped[k] || Actions[k].Type == ETransactionType::SelectHotbar) continue;
+            if (Actions[k].Type != ETransactionType::MoveItem) return false;
+            if ((Actions[k].IntParam == Inventory && Actions[k].IntParam2 == Slot) ||
+                (Actions[k].IntParam3 == Inventory && Actions[k].IntParam4 == Slot))
+            {
+                return false;
+            }
         }
-        
-        // Pack 40 bits: [8 bits: from_inv][8 bits: from_slot][8 bits: to_inv][8 bits: to_slot][8 bits: reserved]
-        uint64 PackedMove = (Action.IntParam & 0xFF) | 
-                           ((Action.IntParam2 & 0xFF) << 8) |
-                           ((Action.IntParam3 & 0xFF) << 16) |
-                           ((Action.IntParam4 & 0xFF) << 24);
-        
-        WriteBits(Bytes, BitOffset, PackedMove, 40);
-        
-        Count++;
-        Index++;
-    }
-    
-    // If no actions were packed, return empty
-    if (Count == 0)
-    {
-        Index = StartIndex;
-        return TEXT("");
-    }
-    
-    // Write count
-    int32 CountOffset = 8;
-    WriteBits(Bytes, CountOffset, Count, 4);
-    
-    return BytesToHexString(Bytes);
-}
+        return true;
+    };
 
-FString ADojoCraftIslandManager::PackType2Actions(const TArray<FTransactionQueueItem>& Actions, int32& Index)
-{
-    // Pack mixed simple actions
-    TArray<uint8> Bytes;
-    Bytes.SetNum(32);
-    for (int i = 0; i < 32; i++) Bytes[i] = 0;
-    
-    int32 BitOffset = 0;
-    
-    // Pack type (8 bits)
-    WriteBits(Bytes, BitOffset, 2, 8);
-    
-    int32 Count = 0;
-    int32 StartIndex = Index;
-    
-    // Reserve space for count (4 bits)
-    BitOffset += 4;
-    
-    // Pack actions
-    while (Index < Actions.Num() && BitOffset < 240) // Leave some buffer
+    if (InFlightTransactions.Num() == 0)
     {
-        const FTransactionQueueItem& Action = Actions[Index];
-        
-        int32 ActionTypeCode = -1;
-        int32 ExtraBits = 0;
-        uint64 ExtraData = 0;
-        
-        switch (Action.Type)
+        for (int32 i = 0; i < Actions.Num(); i++)
         {
-            case ETransactionType::PlaceUse:
-                ActionTypeCode = 0;
-                ExtraBits = 32; // 30 bits position + 2 bits padding
+            if (Dropped[i] || Actions[i].Type != ETransactionType::MoveItem) continue;
+
+            // Follow the chain A -> B -> C ... while each hop lands on an empty slot
+            int32 j = NextKept(i, false);
+            while (j != INDEX_NONE && Actions[j].Type == ETransactionType::MoveItem)
+            {
+                FTransactionQueueItem& First = Actions[i];
+                const FTransactionQueueItem& Second = Actions[j];
+                if (Second.IntParam != First.IntParam3 || Second.IntParam2 != First.IntParam4) break;
+
+                // A -> B -> ... only equals its shortcut when B was empty (nothing swapped or merged
+                // on the way) and the market's item filter can't reject the middle hop
+                const int32 MidInventory = First.IntParam3, MidSlot = First.IntParam4;
+                if (MidInventory == 3 || !IsInventorySlotEmpty(MidInventory, MidSlot) ||
+                    !SlotUntouchedBefore(i, MidInventory, MidSlot))
                 {
-                    uint32 X = Action.Position.X & 0x3FFF; // 14 bits
-                    uint32 Y = Action.Position.Y & 0x3FFF; // 14 bits  
-                    uint32 Z = (Action.Position.Z == 8193) ? 1 : 0; // 1 bit
-                    ExtraData = Y | (X << 14) | (Z << 28); // 30 bits total
+                    break;
                 }
-                break;
-            case ETransactionType::Hit:
-                ActionTypeCode = 1;
-                ExtraBits = 32; // 30 bits position + 2 bits padding
+
+                const bool bBackToStart = Second.IntParam3 == First.IntParam && Second.IntParam4 == First.IntParam2;
+                if (bBackToStart)
                 {
-                    uint32 X = Action.Position.X & 0x3FFF; // 14 bits
-                    uint32 Y = Action.Position.Y & 0x3FFF; // 14 bits
-                    uint32 Z = (Action.Position.Z == 8193) ? 1 : 0; // 1 bit
-                    ExtraData = Y | (X << 14) | (Z << 28); // 30 bits total
+                    // A -> B -> A: nothing happened
+                    RemovePendingInventoryMove(First);
+                    RemovePendingInventoryMove(Second);
+                    Dropped[i] = Dropped[j] = true;
+                    break;
                 }
-                break;
-            case ETransactionType::SelectHotbar:
-                ActionTypeCode = 2;
-                ExtraBits = 8;
-                ExtraData = Action.IntParam & 0xFF;
-                break;
-            case ETransactionType::Sell:
-                ActionTypeCode = 6;
-                break;
-            case ETransactionType::CancelProcess:
-                ActionTypeCode = 8;
-                break;
-            case ETransactionType::Visit:
-                ActionTypeCode = 9;
-                ExtraBits = 16;
-                ExtraData = Action.IntParam & 0xFFFF;
-                break;
-            case ETransactionType::VisitNewIsland:
-                ActionTypeCode = 10;
-                break;
-            default:
-                // Skip non-simple actions
-                break;
+
+                // A -> C directly, which also needs C empty so it can't swap into A instead of B
+                if (!IsInventorySlotEmpty(Second.IntParam3, Second.IntParam4) ||
+                    !SlotUntouchedBefore(i, Second.IntParam3, Second.IntParam4))
+                {
+                    break;
+                }
+                RemovePendingInventoryMove(First);
+                RemovePendingInventoryMove(Second);
+                First.IntParam3 = Second.IntParam3;
+                First.IntParam4 = Second.IntParam4;
+                OptimisticInventory.PendingActions.Add(First);
+                Dropped[j] = true;
+                j = NextKept(i, false);
+            }
         }
-        
-        if (ActionTypeCode == -1)
+    }
+
+    // 3. Consecutive hotbar selections: only the last one matters
+    for (int32 i = 0; i < Actions.Num(); i++)
+    {
+        if (Dropped[i] || Actions[i].Type != ETransactionType::SelectHotbar) continue;
+        const int32 j = NextKept(i, false);
+        if (j != INDEX_NONE && Actions[j].Type == ETransactionType::SelectHotbar)
         {
-            break;
+            Dropped[i] = true;
         }
-        
-        // Check if we have space
-        if (BitOffset + 8 + ExtraBits > 250)
+    }
+
+    // 4. Consecutive single-item buys of the same item become one. A merged buy is all or nothing:
+    //    with coins for only the first part, neither part goes through.
+    for (int32 i = 0; i < Actions.Num(); i++)
+    {
+        if (Dropped[i] || Actions[i].Type != ETransactionType::Buy || Actions[i].ItemIds.Num() != 1 ||
+            Actions[i].Quantities.Num() != 1)
         {
-            break;
+            continue;
         }
-        
-        // Write action type
-        WriteBits(Bytes, BitOffset, ActionTypeCode, 8);
-        
-        // Write extra data if any
-        if (ExtraBits > 0)
+
+        int32 j = NextKept(i, false);
+        while (j != INDEX_NONE && Actions[j].Type == ETransactionType::Buy && Actions[j].ItemIds.Num() == 1 &&
+               Actions[j].ItemIds[0] == Actions[i].ItemIds[0] && Actions[j].Quantities.Num() == 1)
         {
-            WriteBits(Bytes, BitOffset, ExtraData, ExtraBits);
+            // The sum must fit the queued int32, which also keeps it within the 32-bit quantity field it is packed into
+            const int64 Merged = static_cast<int64>(Actions[i].Quantities[0]) + Actions[j].Quantities[0];
+            if (Merged > MAX_int32) break;
+            Actions[i].Quantities[0] = static_cast<int32>(Merged);
+            Dropped[j] = true;
+            j = NextKept(i, false);
         }
-        
-        Count++;
-        Index++;
     }
-    
-    // If no actions were packed, return empty
-    if (Count == 0)
+
+    int32 Write = 0;
+    for (int32 i = 0; i < Actions.Num(); i++)
     {
-        Index = StartIndex;
-        return TEXT("");
+        if (Dropped[i]) continue;
+        if (Write != i)
+        {
+            Actions[Write] = MoveTemp(Actions[i]);
+        }
+        Write++;
     }
-    
-    // Write count
-    int32 CountOffset = 8;
-    WriteBits(Bytes, CountOffset, Count, 4);
-    
-    return BytesToHexString(Bytes);
+    Actions.SetNum(Write);
+
+    const int32 Removed = NumBefore - Actions.Num();
+    if (Removed > 0)
+    {
+        CoalescedActions += Removed;
+        UE_LOG(LogTemp, Log, TEXT("Coalesced %d queued actions into %d (%lld saved in total)"),
+            NumBefore, Actions.Num(), CoalescedActions);
+    }
+    return Removed;
 }
 
-FString ADojoCraftIslandManager::PackType3Action(const FTransactionQueueItem& Action)
+bool ADojoCraftIslandManager::HitUndoesPendingPlacement(const FTransactionQueueItem& Place, const FTransactionQueueItem& Hit) const
 {
-    // Pack single large action
-    TArray<uint8> Bytes;
-    Bytes.SetNum(32);
-    for (int i = 0; i < 32; i++) Bytes[i] = 0;
-    
-    int32 BitOffset = 0;
-    
-    // Pack type (8 bits)
-    WriteBits(Bytes, BitOffset, 3, 8);
-    
-    // Action type (8 bits)
-    int32 ActionTypeCode = -1;
-    switch (Action.Type)
+    // The hit must land on the unconfirmed block this very PlaceUse spawned, and only a shovel takes blocks back.
+    // A block from an earlier placement at the same cell, already sent, must stay.
+    AActor* const* Found = OptimisticActors.Find(Hit.Position);
+    if (!Found || Place.SequenceNumber <= 0) return false;
+
+    const ABaseBlock* Block = Cast<ABaseBlock>(*Found);
+    if (!IsValid(Block) || !Block->Tags.Contains(FName("OptimisticPlacement")) ||
+        !Block->Tags.Contains(GetPlacementTag(Place.SequenceNumber)))
     {
-        case ETransactionType::Craft:
-            ActionTypeCode = 3;
-            break;
-        case ETransactionType::Buy:
-            ActionTypeCode = 5;
-            break;
-        case ETransactionType::StartProcess:
-            ActionTypeCode = 7;
-            break;
-        case ETransactionType::GenerateIsland:
-            ActionTypeCode = 11;
-            break;
-        default:
-            UE_LOG(LogTemp, Error, TEXT("Unsupported action type for Type 3 packing"));
-            return TEXT("0x0");
+        return false;
     }
-    
-    WriteBits(Bytes, BitOffset, ActionTypeCode, 8);
-    
-    // Pack action-specific data
-    switch (Action.Type)
+
+    // Shovel has ID 39 (Stone Shovel); blocks are the IDs below 16
+    return static_cast<int32>(Block->Item) < 16 && static_cast<int32>(Hit.ItemType) == 39;
+}
+
+bool ADojoCraftIslandManager::IsInventorySlotEmpty(int32 InventoryId, int32 Slot) const
+{
+    if (!EntityTable || Slot < 0 || Slot >= DojoDecoders::MAX_INVENTORY_SLOTS) return false;
+
+    FDojoModelKey Key;
+    Key.Kind = EDojoModelKind::Inventory;
+    Key.Owner = AccountAddress;
+    Key.Id = InventoryId;
+    const UDojoModelCraftIslandPocketInventory* Inventory = Cast<UDojoModelCraftIslandPocketInventory>(EntityTable->Find(Key));
+    if (!Inventory || Slot >= Inventory->InventorySize) return false;
+
+    const FString* SlotFelts[] = { &Inventory->Slots1, &Inventory->Slots2, &Inventory->Slots3, &Inventory->Slots4 };
+    const FFelt252 Felt = FFelt252::FromHex(*SlotFelts[Slot / DojoDecoders::SLOTS_PER_FELT]);
+    return DojoDecoders::DecodeInventorySlot(Felt.Bytes, Slot % DojoDecoders::SLOTS_PER_FELT).IsEmpty();
+}
+
+void ADojoCraftIslandManager::RemovePendingInventoryMove(const FTransactionQueueItem& Move)
+{
+    const int32 Pending = OptimisticInventory.PendingActions.IndexOfByPredicate([&Move](const FTransactionQueueItem& Item) {
+        return Item.IntParam == Move.IntParam &&
+               Item.IntParam2 == Move.IntParam2 &&
+               Item.IntParam3 == Move.IntParam3 &&
+               Item.IntParam4 == Move.IntParam4;
+    });
+    if (Pending != INDEX_NONE)
     {
-        case ETransactionType::Craft:
-        {
-            // [32 bits: item_id][30 bits: position]
-            WriteBits(Bytes, BitOffset, Action.IntParam, 32);
-            
-            // Pack 30 bits: [14 bits: y][14 bits: x][2 bits: z and reserved]
-            uint32 Y = Action.Position.Y & 0x3FFF; // 14 bits
-            uint32 X = Action.Position.X & 0x3FFF; // 14 bits
-            uint32 Z = (Action.Position.Z == 8193) ? 1 : 0;
-            uint32 Coords = Y | (X << 14) | (Z << 28);
-            WriteBits(Bytes, BitOffset, Coords, 30);
-            break;
-        }
-        case ETransactionType::Buy:
-        {
-            // For simplicity, only support single item buy in Type 3
-            if (Action.ItemIds.Num() > 0 && Action.Quantities.Num() > 0)
-            {
-                WriteBits(Bytes, BitOffset, Action.ItemIds[0], 16);
-                WriteBits(Bytes, BitOffset, Action.Quantities[0], 32);
-            }
-            break;
-        }
-        case ETransactionType::StartProcess:
-        {
-            WriteBits(Bytes, BitOffset, Action.IntParam, 8); // process type
-            WriteBits(Bytes, BitOffset, Action.IntParam2, 32); // amount
-            break;
-        }
-        case ETransactionType::GenerateIsland:
-        {
-            // Pack 30 bits: [14 bits: y][14 bits: x][2 bits: z and reserved]
-            uint32 Y = Action.Position.Y & 0x3FFF; // 14 bits
-            uint32 X = Action.Position.X & 0x3FFF; // 14 bits
-            uint32 Z = (Action.Position.Z == 8193) ? 1 : 0;
-            uint32 Coords = Y | (X << 14) | (Z << 28);
-            WriteBits(Bytes, BitOffset, Coords, 30);
-            WriteBits(Bytes, BitOffset, Action.IntParam, 16); // island_id
-            break;
-        }
+        OptimisticInventory.PendingActions.RemoveAt(Pending);
     }
-    
-    return BytesToHexString(Bytes);
 }
 
+double ADojoCraftIslandManager::GetBatchWindow(int32 BatchedCount, double Fill) const
+{
+    // No input rate yet: nothing to wait for
+    if (InputIntervalEma <= 0.0) return 0.0;
+
+    // Time until the batch would be full at its current density, capped by a fraction of the confirmation
+    // latency the wait adds to, so slow chains tolerate longer windows than fast ones
+    Fill = FMath::Clamp(Fill, 0.01, 1.0);
+    const double TimeToFill = BatchedCount * (1.0 - Fill) / Fill * InputIntervalEma;
+    const double Window = FMath::Min3(TimeToFill, ConfirmationLatencyEma * BATCH_WINDOW_LATENCY_FRACTION,
+        static_cast<double>(MaxBatchWindowSeconds));
+
+    // Not even one more action expected within the window: waiting only adds latency
+    return InputIntervalEma < Window ? Window : 0.0;
+}
+
+void ADojoCraftIslandManager::RecordConfirmationLatency(double SentAt)
+{
+    const double Latency = GetWorld()->GetTimeSeconds() - SentAt;
+    ConfirmationLatencyEma = FMath::Lerp(ConfirmationLatencyEma, Latency, BATCH_EMA_WEIGHT);
+}
 
-bool ADojoCraftIslandManager::CanBatchAction(ETransactionType Type)
+// Universal action encoder implementation
+bool ADojoCraftIslandManager::ToPackedAction(const FTransactionQueueItem& Action, DojoActionPacking::FPackedAction& OutAction)
 {
-    switch(Type)
+    using namespace DojoActionPacking;
+
+    // Positions: [y][x][z layer bit], the contract adds the 8192 offset back on z only
+    const uint64 X = Action.Position.X & 0x3FFF;
+    const uint64 Y = Action.Position.Y & 0x3FFF;
+    const uint64 Z = (Action.Position.Z == BASE_Z + 1) ? 1 : 0;
+
+    OutAction = FPackedAction();
+    uint64* Fields = OutAction.Fields;
+    switch (Action.Type)
     {
         case ETransactionType::PlaceUse:
         case ETransactionType::Hit:
-        case ETransactionType::MoveItem:
+            OutAction.Code = Action.Type == ETransactionType::Hit ? EActionCode::Hit : EActionCode::PlaceUse;
+            Fields[0] = Y; Fields[1] = X; Fields[2] = Z;
+            return true;
         case ETransactionType::SelectHotbar:
+            OutAction.Code = EActionCode::SelectHotbar;
+            Fields[0] = Action.IntParam;
+            return true;
+        case ETransactionType::MoveItem:
+            OutAction.Code = EActionCode::MoveItem;
+            Fields[0] = Action.IntParam; Fields[1] = Action.IntParam2;
+            Fields[2] = Action.IntParam3; Fields[3] = Action.IntParam4;
+            return true;
         case ETransactionType::Sell:
+            OutAction.Code = EActionCode::Sell;
+            return true;
         case ETransactionType::CancelProcess:
+            OutAction.Code = EActionCode::CancelProcess;
+            return true;
         case ETransactionType::Visit:
+            OutAction.Code = EActionCode::Visit;
+            Fields[0] = Action.IntParam;
+            return true;
         case ETransactionType::VisitNewIsland:
+            OutAction.Code = EActionCode::VisitNewIsland;
+            return true;
+        case ETransactionType::Craft:
+            OutAction.Code = EActionCode::Craft;
+            Fields[0] = Action.IntParam; Fields[1] = Y; Fields[2] = X; Fields[3] = Z;
+            return true;
+        case ETransactionType::Buy:
+            // Single item per pack, several items go through the buy entrypoint (ToActionCall)
+            if (Action.ItemIds.Num() != 1 || Action.Quantities.Num() != 1) return false;
+            OutAction.Code = EActionCode::Buy;
+            Fields[0] = Action.ItemIds[0]; Fields[1] = Action.Quantities[0];
+            return true;
+        case ETransactionType::StartProcess:
+            OutAction.Code = EActionCode::StartProcess;
+            Fields[0] = Action.IntParam; Fields[1] = Action.IntParam2;
+            return true;
+        case ETransactionType::GenerateIsland:
+            OutAction.Code = EActionCode::GenerateIsland;
+            Fields[0] = Y; Fields[1] = X; Fields[2] = Z; Fields[4] = Action.IntParam;
             return true;
         default:
             return false;
     }
 }
 
-int32 ADojoCraftIslandManager::GetActionSize(ETransactionType Type)
+bool ADojoCraftIslandManager::ToActionCall(const FTransactionQueueItem& Action, FDojoCall& OutCall)
 {
-    switch(Type)
+    // Arguments serialized the way the actions entrypoints declare them (contracts/src/systems/actions.cairo)
+    TArray<FFelt252>& Calldata = OutCall.Calldata;
+    Calldata.Reset();
+    switch (Action.Type)
     {
-        case ETransactionType::PlaceUse:
-        case ETransactionType::Hit:
-            return 30; // bits
-        case ETransactionType::MoveItem:
-            return 40; // bits
-        case ETransactionType::SelectHotbar:
-            return 16; // 8 + 8 bits
-        case ETransactionType::Sell:
-        case ETransactionType::CancelProcess:
-        case ETransactionType::VisitNewIsland:
-            return 8; // bits
-        case ETransactionType::Visit:
-            return 24; // 8 + 16 bits
+        case ETransactionType::Buy:
+        {
+            // buy(item_ids: Array<u16>, quantities: Array<u32>)
+            if (Action.ItemIds.Num() == 0 || Action.ItemIds.Num() != Action.Quantities.Num()) return false;
+            OutCall.Selector = "buy";
+            Calldata.Add(FFelt252::FromUint64(Action.ItemIds.Num()));
+            for (int32 ItemId : Action.ItemIds)
+            {
+                Calldata.Add(FFelt252::FromUint64(static_cast<uint16>(ItemId)));
+            }
+            Calldata.Add(FFelt252::FromUint64(Action.Quantities.Num()));
+            for (int32 Quantity : Action.Quantities)
+            {
+                Calldata.Add(FFelt252::FromUint64(static_cast<uint32>(Quantity)));
+            }
+            return true;
+        }
+        case ETransactionType::Craft:
+            OutCall.Selector = "craft";
+            Calldata.Add(FFelt252::FromUint64(static_cast<uint32>(Action.IntParam)));
+            Calldata.Add(FFelt252::FromUint64(Action.Position.X));
+            Calldata.Add(FFelt252::FromUint64(Action.Position.Y));
+            Calldata.Add(FFelt252::FromUint64(Action.Position.Z));
+            return true;
+        case ETransactionType::StartProcess:
+            OutCall.Selector = "start_processing";
+            Calldata.Add(FFelt252::FromUint64(static_cast<uint8>(Action.IntParam)));
+            Calldata.Add(FFelt252::FromUint64(static_cast<uint32>(Action.IntParam2)));
+            return true;
+        case ETransactionType::GenerateIsland:
+            OutCall.Selector = "generate_island_part";
+            Calldata.Add(FFelt252::FromUint64(Action.Position.X));
+            Calldata.Add(FFelt252::FromUint64(Action.Position.Y));
+            Calldata.Add(FFelt252::FromUint64(Action.Position.Z));
+            Calldata.Add(FFelt252::FromUint64(static_cast<uint16>(Action.IntParam)));
+            return true;
+        case ETransactionType::SetName:
+            OutCall.Selector = "set_name";
+            Calldata = ADojoHelpers::SerializeByteArray(Action.StringParam);
+            return Calldata.Num() > 0;
         default:
-            return 256; // Full felt
+            return false;
     }
 }
 
-void ADojoCraftIslandManager::WriteBits(TArray<uint8>& Bytes, int32& BitOffset, uint64 Value, int32 NumBits)
+TArray<FFelt252> ADojoCraftIslandManager::EncodePackedActions(TConstArrayView<FTransactionQueueItem> Actions)
 {
-    for (int32 i = 0; i < NumBits; i++)
+    using namespace DojoActionPacking;
+
+    const int32 NumActions = Actions.Num();
+    TArray<FPackedAction> Packed;
+    TArray<bool> Packable;
+    Packed.SetNum(NumActions);
+    Packable.SetNum(NumActions);
+
+    // Fewest felts any mix of pack types allows, the same plan ProcessNextTransaction budgeted the batch with
+    FPackPlanner Planner;
+    for (int32 i = 0; i < NumActions; i++)
     {
-        if ((Value & (1ULL << i)) != 0)
+        Packable[i] = ToPackedAction(Actions[i], Packed[i]);
+        if (!Packable[i] || !Planner.Add(Packed[i]))
         {
-            int32 ByteIndex = BitOffset / 8;
-            int32 BitInByte = BitOffset % 8;
-            if (ByteIndex < Bytes.Num())
-            {
-                Bytes[ByteIndex] |= (1 << BitInByte);
-            }
+            UE_LOG(LogTemp, Error, TEXT("EncodePackedActions: action type %d can't be packed"), (int32)Actions[i].Type);
+            Packable[i] = false;
+            Planner.AddUnpackable();
         }
-        BitOffset++;
     }
-}
 
-FString ADojoCraftIslandManager::BytesToHexString(const TArray<uint8>& Bytes)
-{
-    // Convert to hex string (big-endian for Starknet felt252)
-    FString HexString = TEXT("0x");
-    bool bFoundNonZero = false;
-    
-    for (int32 i = 31; i >= 0; i--)
+    int32 BitsUsed = 0;
+    TArray<FFelt252> PackedFelts = Planner.ToFelts(&BitsUsed);
+
+    UE_LOG(LogTemp, Log, TEXT("EncodePackedActions: %d actions in %d felts, %d of %d bits used"),
+        NumActions, PackedFelts.Num(), BitsUsed, PackedFelts.Num() * FELT_BITS);
+
+#if !UE_BUILD_SHIPPING
+    // Decode what we're about to send and compare with the actions (truncated fields, layout drift)
+    TArray<FPackedAction> Expected, Decoded;
+    for (int32 i = 0; i < NumActions; i++)
+    {
+        if (Packable[i])
+        {
+            Expected.Add(Packed[i]);
+        }
+    }
+    for (const FFelt252& Felt : PackedFelts)
     {
-        if (Bytes[i] != 0 || bFoundNonZero || i == 0)
+        if (!Felt.IsBelowPrime())
         {
-            HexString += FString::Printf(TEXT("%02x"), Bytes[i]);
-            bFoundNonZero = true;
+            UE_LOG(LogTemp, Error, TEXT("EncodePackedActions: %s is not a valid felt, the transaction will be rejected"), *Felt.ToHex());
         }
+        DecodeFelt(Felt, Decoded);
     }
+    if (Decoded != Expected)
+    {
+        UE_LOG(LogTemp, Error, TEXT("EncodePackedActions: %d actions decode back as %d different ones"),
+            Expected.Num(), Decoded.Num());
+    }
+#endif
     
-    return HexString;
+    return PackedFelts;
 }
 
 // Optimistic inventory update methods
@@ -3499,5 +4095,10 @@ void ADojoCraftIslandManager::HandleSetPlayerName(const FString& PlayerName)
         return;
     }
     
-    DojoHelpers->CallCraftIslandPocketActionsSetName(Account, PlayerName);
+    // Rides along with whatever else is queued, as a set_name call of the same transaction
+    FTransactionQueueItem Item;
+    Item.Type = ETransactionType::SetName;
+    Item.StringParam = PlayerName;
+
+    QueueTransaction(Item);
 }
@@ -0,0 +1,111 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "DojoEntityTable.h"
+#include "../DojoHelpers.h"
+#include "UObject/UnrealType.h"
+
+UDojoModel* UDojoEntityTable::Upsert(UDojoModel* Incoming, TArray<FName>& OutChangedFields, bool& bOutCreated)
+{
+    check(IsInGameThread());
+    OutChangedFields.Reset();
+    bOutCreated = false;
+
+    FDojoModelKey Key;
+    if (!Incoming || !FDojoModelKey::FromModel(Incoming, Key))
+    {
+        bOutCreated = true;
+        return Incoming;
+    }
+
+    UDojoModel** Existing = Entities.Find(Key);
+    if (!Existing || !*Existing || (*Existing)->GetClass() != Incoming->GetClass())
+    {
+        Entities.Add(Key, Incoming);
+        bOutCreated = true;
+        return Incoming;
+    }
+
+    UDojoModel* Canonical = *Existing;
+    if (Canonical == Incoming)
+    {
+        UnchangedUpdates++;
+        return Canonical;
+    }
+
+    for (FProperty* Property : GetProperties(Canonical->GetClass()))
+    {
+        if (!Property->Identical_InContainer(Canonical, Incoming))
+        {
+            Property->CopyCompleteValue_InContainer(Canonical, Incoming);
+            OutChangedFields.Add(Property->GetFName());
+        }
+    }
+
+    if (OutChangedFields.Num() == 0)
+    {
+        UnchangedUpdates++;
+        return Canonical;
+    }
+
+    UpdatesInPlace++;
+    for (const FName& Field : OutChangedFields)
+    {
+        if (FOnFieldChangedNative* Listeners = FieldListeners.Find(TPair<UClass*, FName>(Canonical->GetClass(), Field)))
+        {
+            Listeners->Broadcast(Canonical, Field);
+        }
+        OnEntityFieldChanged.Broadcast(Canonical, Field);
+    }
+    return Canonical;
+}
+
+UDojoModel* UDojoEntityTable::Find(const FDojoModelKey& Key) const
+{
+    UDojoModel* const* Found = Entities.Find(Key);
+    return Found ? *Found : nullptr;
+}
+
+void UDojoEntityTable::Remove(const FDojoModelKey& Key)
+{
+    Entities.Remove(Key);
+}
+
+void UDojoEntityTable::Reset()
+{
+    Entities.Reset();
+}
+
+UDojoEntityTable::FOnFieldChangedNative& UDojoEntityTable::OnFieldChanged(UClass* ModelClass, FName Field)
+{
+    return FieldListeners.FindOrAdd(TPair<UClass*, FName>(ModelClass, Field));
+}
+
+const TArray<FProperty*>& UDojoEntityTable::GetProperties(UClass* Class)
+{
+    if (const TArray<FProperty*>* Cached = PropertiesByClass.Find(Class))
+    {
+        return *Cached;
+    }
+
+    // Model fields only: UDojoModel's own DojoModelType never differs within a class
+    TArray<FProperty*>& Properties = PropertiesByClass.Add(Class);
+    for (TFieldIterator<FProperty> It(Class); It; ++It)
+    {
+        if (It->GetOwnerClass() != UDojoModel::StaticClass())
+        {
+            Properties.Add(*It);
+        }
+    }
+    return Properties;
+}
+
+void UDojoEntityTable::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+    UDojoEntityTable* This = CastChecked<UDojoEntityTable>(InThis);
+    for (TPair<FDojoModelKey, UDojoModel*>& Pair : This->Entities)
+    {
+        Collector.AddReferencedObject(Pair.Value, This);
+    }
+    Super::AddReferencedObjects(InThis, Collector);
+}
@@ -0,0 +1,90 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "DojoModelKey.h"
+#include "../DojoHelpers.h"
+
+EDojoModelKind FDojoModelKey::KindFromTypeName(const FString& DojoModelType)
+{
+    if (DojoModelType == TEXT("craft_island_pocket-IslandChunk")) return EDojoModelKind::IslandChunk;
+    if (DojoModelType == TEXT("craft_island_pocket-GatherableResource")) return EDojoModelKind::GatherableResource;
+    if (DojoModelType == TEXT("craft_island_pocket-WorldStructure")) return EDojoModelKind::WorldStructure;
+    if (DojoModelType == TEXT("craft_island_pocket-Inventory")) return EDojoModelKind::Inventory;
+    if (DojoModelType == TEXT("craft_island_pocket-PlayerData")) return EDojoModelKind::PlayerData;
+    if (DojoModelType == TEXT("craft_island_pocket-PlayerStats")) return EDojoModelKind::PlayerStats;
+    if (DojoModelType == TEXT("craft_island_pocket-ProcessingLock")) return EDojoModelKind::ProcessingLock;
+    return EDojoModelKind::Unknown;
+}
+
+bool FDojoModelKey::FromModel(const UDojoModel* Model, FDojoModelKey& OutKey)
+{
+    if (!Model) return false;
+
+    OutKey = FDojoModelKey();
+    OutKey.Kind = KindFromTypeName(Model->DojoModelType);
+
+    switch (OutKey.Kind)
+    {
+    case EDojoModelKind::IslandChunk:
+        if (const UDojoModelCraftIslandPocketIslandChunk* Chunk = Cast<UDojoModelCraftIslandPocketIslandChunk>(Model))
+        {
+            OutKey.Owner = FFelt252::FromHex(Chunk->IslandOwner);
+            OutKey.Id = Chunk->IslandId;
+            OutKey.Chunk = FFelt252::FromHex(Chunk->ChunkId);
+            return true;
+        }
+        break;
+    case EDojoModelKind::GatherableResource:
+        if (const UDojoModelCraftIslandPocketGatherableResource* Gatherable = Cast<UDojoModelCraftIslandPocketGatherableResource>(Model))
+        {
+            OutKey.Owner = FFelt252::FromHex(Gatherable->IslandOwner);
+            OutKey.Id = Gatherable->IslandId;
+            OutKey.Chunk = FFelt252::FromHex(Gatherable->ChunkId);
+            OutKey.Position = Gatherable->Position;
+            return true;
+        }
+        break;
+    case EDojoModelKind::WorldStructure:
+        if (const UDojoModelCraftIslandPocketWorldStructure* Structure = Cast<UDojoModelCraftIslandPocketWorldStructure>(Model))
+        {
+            OutKey.Owner = FFelt252::FromHex(Structure->IslandOwner);
+            OutKey.Id = Structure->IslandId;
+            OutKey.Chunk = FFelt252::FromHex(Structure->ChunkId);
+            OutKey.Position = Structure->Position;
+            return true;
+        }
+        break;
+    case EDojoModelKind::Inventory:
+        if (const UDojoModelCraftIslandPocketInventory* Inventory = Cast<UDojoModelCraftIslandPocketInventory>(Model))
+        {
+            OutKey.Owner = FFelt252::FromHex(Inventory->Owner);
+            OutKey.Id = Inventory->Id;
+            return true;
+        }
+        break;
+    case EDojoModelKind::PlayerData:
+        if (const UDojoModelCraftIslandPocketPlayerData* PlayerData = Cast<UDojoModelCraftIslandPocketPlayerData>(Model))
+        {
+            OutKey.Owner = FFelt252::FromHex(PlayerData->Player);
+            return true;
+        }
+        break;
+    case EDojoModelKind::PlayerStats:
+        if (const UDojoModelCraftIslandPocketPlayerStats* PlayerStats = Cast<UDojoModelCraftIslandPocketPlayerStats>(Model))
+        {
+            OutKey.Owner = FFelt252::FromHex(PlayerStats->Player);
+            return true;
+        }
+        break;
+    case EDojoModelKind::ProcessingLock:
+        if (const UDojoModelCraftIslandPocketProcessingLock* ProcessingLock = Cast<UDojoModelCraftIslandPocketProcessingLock>(Model))
+        {
+            OutKey.Owner = FFelt252::FromHex(ProcessingLock->Player);
+            return true;
+        }
+        break;
+    default:
+        break;
+    }
+    return false;
+}
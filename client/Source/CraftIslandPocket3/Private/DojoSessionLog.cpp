@@ -0,0 +1,385 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "DojoSessionLog.h"
+#include "../DojoHelpers.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UnrealType.h"
+#include "Algo/AllOf.h"
+
+namespace
+{
+    void WriteVarUInt(TArray<uint8>& Out, uint64 Value)
+    {
+        while (Value >= 0x80)
+        {
+            Out.Add(static_cast<uint8>(Value) | 0x80);
+            Value >>= 7;
+        }
+        Out.Add(static_cast<uint8>(Value));
+    }
+
+    void WriteVarInt(TArray<uint8>& Out, int64 Value)
+    {
+        WriteVarUInt(Out, (static_cast<uint64>(Value) << 1) ^ static_cast<uint64>(Value >> 63));
+    }
+
+    void WriteString(TArray<uint8>& Out, const FString& Value)
+    {
+        const FTCHARToUTF8 Utf8(*Value);
+        WriteVarUInt(Out, Utf8.Length());
+        Out.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+    }
+
+    // Model strings are mostly fixed-width hex from bytes_to_fstring: store the bytes, keep the width
+    void WriteModelString(TArray<uint8>& Out, const FString& Value)
+    {
+        const bool bHex = Value.StartsWith(TEXT("0x")) && (Value.Len() % 2) == 0
+            && Algo::AllOf(Value.RightChop(2), [](TCHAR C) { return FChar::IsHexDigit(C); });
+        if (!bHex)
+        {
+            Out.Add(FDojoSessionLog::Utf8String);
+            WriteString(Out, Value);
+            return;
+        }
+
+        const int32 NumBytes = (Value.Len() - 2) / 2;
+        Out.Add(FDojoSessionLog::HexString);
+        WriteVarUInt(Out, NumBytes);
+        for (int32 i = 0; i < NumBytes; i++)
+        {
+            Out.Add(static_cast<uint8>((FParse::HexDigit(Value[2 + i * 2]) << 4) | FParse::HexDigit(Value[3 + i * 2])));
+        }
+    }
+
+    struct FReader
+    {
+        const TArray<uint8>& Data;
+        int64& Offset;
+        bool bOk = true;
+
+        bool Has(int64 Num) { bOk = bOk && Offset + Num <= Data.Num(); return bOk; }
+
+        uint8 U8() { return Has(1) ? Data[Offset++] : 0; }
+
+        uint64 VarUInt()
+        {
+            uint64 Value = 0;
+            for (int32 Shift = 0; Shift < 64 && Has(1); Shift += 7)
+            {
+                const uint8 Byte = Data[Offset++];
+                Value |= static_cast<uint64>(Byte & 0x7F) << Shift;
+                if ((Byte & 0x80) == 0) return Value;
+            }
+            bOk = false;
+            return 0;
+        }
+
+        int64 VarInt()
+        {
+            const uint64 Value = VarUInt();
+            return static_cast<int64>(Value >> 1) ^ -static_cast<int64>(Value & 1);
+        }
+
+        template<typename T>
+        T Raw()
+        {
+            T Value{};
+            if (Has(sizeof(T)))
+            {
+                FMemory::Memcpy(&Value, Data.GetData() + Offset, sizeof(T));
+                Offset += sizeof(T);
+            }
+            return Value;
+        }
+
+        FString String()
+        {
+            const uint64 Len = VarUInt();
+            if (!Has(Len)) return FString();
+            const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Data.GetData() + Offset), Len);
+            FString Value(Converted.Length(), Converted.Get());
+            Offset += Len;
+            return Value;
+        }
+
+        FString ModelString()
+        {
+            if (U8() == FDojoSessionLog::Utf8String) return String();
+
+            const uint64 NumBytes = VarUInt();
+            if (!Has(NumBytes)) return FString();
+            FString Value = TEXT("0x");
+            Value.Reserve(2 + NumBytes * 2);
+            for (uint64 i = 0; i < NumBytes; i++)
+            {
+                Value += FString::Printf(TEXT("%02x"), Data[Offset++]);
+            }
+            return Value;
+        }
+    };
+}
+
+FDojoSessionRecorder::~FDojoSessionRecorder()
+{
+    Stop();
+}
+
+bool FDojoSessionRecorder::Start(const FString& Path, const FString& WorldAddress, const FString& PlayerAddress)
+{
+    Stop();
+
+    FScopeLock Lock(&Mutex);
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    PlatformFile.CreateDirectoryTree(*FPaths::GetPath(Path));
+    File = PlatformFile.OpenWrite(*Path);
+    if (!File)
+    {
+        UE_LOG(LogTemp, Error, TEXT("DojoSessionRecorder: can't open %s"), *Path);
+        return false;
+    }
+
+    TArray<uint8> Header;
+    const uint32 Magic = FDojoSessionLog::MAGIC;
+    const uint16 Version = FDojoSessionLog::FORMAT_VERSION;
+    Header.Append(reinterpret_cast<const uint8*>(&Magic), sizeof(Magic));
+    Header.Append(reinterpret_cast<const uint8*>(&Version), sizeof(Version));
+    WriteString(Header, WorldAddress);
+    WriteString(Header, PlayerAddress);
+    File->Write(Header.GetData(), Header.Num());
+
+    Types.Empty();
+    BytesWritten = Header.Num();
+    BatchesWritten = 0;
+    StartTime = FPlatformTime::Seconds();
+    bRecording = true;
+
+    UE_LOG(LogTemp, Log, TEXT("DojoSessionRecorder: recording to %s"), *Path);
+    return true;
+}
+
+void FDojoSessionRecorder::Stop()
+{
+    FScopeLock Lock(&Mutex);
+    bRecording = false;
+    if (File)
+    {
+        File->Flush();
+        delete File;
+        File = nullptr;
+        UE_LOG(LogTemp, Log, TEXT("DojoSessionRecorder: stopped, %lld batches, %lld bytes"), BatchesWritten, BytesWritten);
+    }
+}
+
+const FDojoSessionRecorder::FTypeInfo& FDojoSessionRecorder::FindOrWriteType(UClass* Class, TArray<uint8>& Out)
+{
+    if (const FTypeInfo* Existing = Types.Find(Class))
+    {
+        return *Existing;
+    }
+
+    FTypeInfo Info;
+    Info.Index = Types.Num();
+    for (TFieldIterator<FProperty> It(Class); It; ++It)
+    {
+        FProperty* Property = *It;
+        if (Property->IsA<FIntProperty>()) Info.Kinds.Add(FDojoSessionLog::Int32Value);
+        else if (Property->IsA<FInt64Property>()) Info.Kinds.Add(FDojoSessionLog::Int64Value);
+        else if (Property->IsA<FBoolProperty>()) Info.Kinds.Add(FDojoSessionLog::BoolValue);
+        else if (Property->IsA<FStrProperty>()) Info.Kinds.Add(FDojoSessionLog::StringValue);
+        else continue;
+        Info.Properties.Add(Property);
+    }
+
+    Out.Add(FDojoSessionLog::TypeRecord);
+    WriteString(Out, Class->GetPathName());
+    WriteVarUInt(Out, Info.Properties.Num());
+    for (int32 i = 0; i < Info.Properties.Num(); i++)
+    {
+        WriteString(Out, Info.Properties[i]->GetName());
+        Out.Add(Info.Kinds[i]);
+    }
+    return Types.Add(Class, MoveTemp(Info));
+}
+
+void FDojoSessionRecorder::Record(EDojoSessionLane Lane, const TArray<UDojoModel*>& Models)
+{
+    if (!IsRecording() || Models.Num() == 0) return;
+
+    FScopeLock Lock(&Mutex);
+    if (!File) return;
+
+    TArray<uint8> TypeRecords;
+    TArray<uint8> Batch;
+    Batch.Reserve(Models.Num() * 48);
+    for (UDojoModel* Model : Models)
+    {
+        const FTypeInfo& Info = FindOrWriteType(Model->GetClass(), TypeRecords);
+        WriteVarUInt(Batch, Info.Index);
+        for (int32 i = 0; i < Info.Properties.Num(); i++)
+        {
+            const void* Value = Info.Properties[i]->ContainerPtrToValuePtr<void>(Model);
+            switch (Info.Kinds[i])
+            {
+            case FDojoSessionLog::Int32Value:
+                WriteVarInt(Batch, *static_cast<const int32*>(Value));
+                break;
+            case FDojoSessionLog::Int64Value:
+                WriteVarInt(Batch, *static_cast<const int64*>(Value));
+                break;
+            case FDojoSessionLog::BoolValue:
+                Batch.Add(CastFieldChecked<FBoolProperty>(Info.Properties[i])->GetPropertyValue(Value) ? 1 : 0);
+                break;
+            default:
+                WriteModelString(Batch, *static_cast<const FString*>(Value));
+                break;
+            }
+        }
+    }
+
+    TArray<uint8> Header;
+    const double Timestamp = FPlatformTime::Seconds() - StartTime;
+    Header.Add(FDojoSessionLog::BatchRecord);
+    Header.Append(reinterpret_cast<const uint8*>(&Timestamp), sizeof(Timestamp));
+    Header.Add(static_cast<uint8>(Lane));
+    WriteVarUInt(Header, Models.Num());
+
+    File->Write(TypeRecords.GetData(), TypeRecords.Num());
+    File->Write(Header.GetData(), Header.Num());
+    File->Write(Batch.GetData(), Batch.Num());
+    BytesWritten += TypeRecords.Num() + Header.Num() + Batch.Num();
+    BatchesWritten++;
+}
+
+bool FDojoSessionReplay::Open(const FString& Path)
+{
+    if (!FFileHelper::LoadFileToArray(Data, *Path))
+    {
+        UE_LOG(LogTemp, Error, TEXT("DojoSessionReplay: can't read %s"), *Path);
+        return false;
+    }
+
+    Offset = 0;
+    FReader Reader{Data, Offset};
+    const uint32 Magic = Reader.Raw<uint32>();
+    const uint16 Version = Reader.Raw<uint16>();
+    WorldAddress = Reader.String();
+    PlayerAddress = Reader.String();
+    if (!Reader.bOk || Magic != FDojoSessionLog::MAGIC || Version != FDojoSessionLog::FORMAT_VERSION)
+    {
+        UE_LOG(LogTemp, Error, TEXT("DojoSessionReplay: %s is not a session log (or an older format)"), *Path);
+        return false;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("DojoSessionReplay: opened %s (%d bytes, player %s)"), *Path, Data.Num(), *PlayerAddress);
+    return true;
+}
+
+bool FDojoSessionReplay::SkipToBatch()
+{
+    FReader Reader{Data, Offset};
+    while (!bCorrupt && Offset < Data.Num() && Data[Offset] == FDojoSessionLog::TypeRecord)
+    {
+        Offset++;
+        FTypeInfo Info;
+        const FString ClassPath = Reader.String();
+        Info.Class = FindObject<UClass>(nullptr, *ClassPath);
+        const uint64 NumProperties = Reader.VarUInt();
+        for (uint64 i = 0; i < NumProperties && Reader.bOk; i++)
+        {
+            const FString Name = Reader.String();
+            Info.Kinds.Add(Reader.U8());
+            Info.Properties.Add(Info.Class ? FindFProperty<FProperty>(Info.Class, *Name) : nullptr);
+        }
+        if (!Info.Class)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("DojoSessionReplay: unknown model class %s, its models are skipped"), *ClassPath);
+        }
+        bCorrupt = !Reader.bOk;
+        Types.Add(MoveTemp(Info));
+    }
+    return !bCorrupt && Offset < Data.Num() && Data[Offset] == FDojoSessionLog::BatchRecord;
+}
+
+bool FDojoSessionReplay::PeekTimestamp(double& OutTimestamp)
+{
+    if (!SkipToBatch()) return false;
+    if (Offset + 1 + static_cast<int64>(sizeof(double)) > Data.Num()) return false;
+    FMemory::Memcpy(&OutTimestamp, Data.GetData() + Offset + 1, sizeof(double));
+    return true;
+}
+
+bool FDojoSessionReplay::IsFinished()
+{
+    return !SkipToBatch();
+}
+
+bool FDojoSessionReplay::NextBatch(TArray<UDojoModel*>& OutModels, EDojoSessionLane& OutLane, double& OutTimestamp)
+{
+    check(IsInGameThread());
+    OutModels.Reset();
+    if (!SkipToBatch()) return false;
+
+    FReader Reader{Data, Offset};
+    Offset++; // tag
+    OutTimestamp = Reader.Raw<double>();
+    OutLane = static_cast<EDojoSessionLane>(Reader.U8());
+    const uint64 NumModels = Reader.VarUInt();
+
+    for (uint64 m = 0; m < NumModels && Reader.bOk; m++)
+    {
+        const uint64 TypeIndex = Reader.VarUInt();
+        if (!Types.IsValidIndex(TypeIndex))
+        {
+            Reader.bOk = false;
+            break;
+        }
+
+        const FTypeInfo& Info = Types[TypeIndex];
+        UDojoModel* Model = Info.Class ? NewObject<UDojoModel>(GetTransientPackage(), Info.Class) : nullptr;
+        for (int32 i = 0; i < Info.Kinds.Num(); i++)
+        {
+            void* Value = (Model && Info.Properties[i]) ? Info.Properties[i]->ContainerPtrToValuePtr<void>(Model) : nullptr;
+            switch (Info.Kinds[i])
+            {
+            case FDojoSessionLog::Int32Value:
+            {
+                const int64 Read = Reader.VarInt();
+                if (Value) *static_cast<int32*>(Value) = static_cast<int32>(Read);
+                break;
+            }
+            case FDojoSessionLog::Int64Value:
+            {
+                const int64 Read = Reader.VarInt();
+                if (Value) *static_cast<int64*>(Value) = Read;
+                break;
+            }
+            case FDojoSessionLog::BoolValue:
+            {
+                const bool bRead = Reader.U8() != 0;
+                if (Value) CastFieldChecked<FBoolProperty>(Info.Properties[i])->SetPropertyValue(Value, bRead);
+                break;
+            }
+            default:
+            {
+                FString Read = Reader.ModelString();
+                if (Value) *static_cast<FString*>(Value) = MoveTemp(Read);
+                break;
+            }
+            }
+        }
+        if (Model)
+        {
+            OutModels.Add(Model);
+        }
+    }
+
+    if (!Reader.bOk)
+    {
+        UE_LOG(LogTemp, Error, TEXT("DojoSessionReplay: log is truncated or corrupt at offset %lld"), Offset);
+        bCorrupt = true;
+    }
+    return !bCorrupt;
+}
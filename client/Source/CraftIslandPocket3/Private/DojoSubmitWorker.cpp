@@ -0,0 +1,74 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "DojoSubmitWorker.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+
+FDojoSubmitWorker::FDojoSubmitWorker(const TCHAR* ThreadName)
+{
+    if (FPlatformProcess::SupportsMultithreading())
+    {
+        WorkEvent = FPlatformProcess::GetSynchEventFromPool(false);
+        Thread = FRunnableThread::Create(this, ThreadName, 0, TPri_Normal);
+    }
+}
+
+FDojoSubmitWorker::~FDojoSubmitWorker()
+{
+    if (Thread)
+    {
+        // Kill calls Stop and waits for Run to return
+        Thread->Kill(true);
+        delete Thread;
+        Thread = nullptr;
+    }
+    if (WorkEvent)
+    {
+        FPlatformProcess::ReturnSynchEventToPool(WorkEvent);
+        WorkEvent = nullptr;
+    }
+    Jobs.Empty();
+}
+
+void FDojoSubmitWorker::Enqueue(TUniqueFunction<void()>&& Job)
+{
+    if (!Thread)
+    {
+        // No threads on this platform: run in place, still in order
+        Job();
+        return;
+    }
+
+    PendingJobs.fetch_add(1, std::memory_order_relaxed);
+    Jobs.Enqueue(MoveTemp(Job));
+    WorkEvent->Trigger();
+}
+
+uint32 FDojoSubmitWorker::Run()
+{
+    while (!bStopping.load(std::memory_order_acquire))
+    {
+        TUniqueFunction<void()> Job;
+        if (Jobs.Dequeue(Job))
+        {
+            PendingJobs.fetch_sub(1, std::memory_order_relaxed);
+            Job();
+        }
+        else
+        {
+            WorkEvent->Wait();
+        }
+    }
+    return 0;
+}
+
+void FDojoSubmitWorker::Stop()
+{
+    bStopping.store(true, std::memory_order_release);
+    if (WorkEvent)
+    {
+        WorkEvent->Trigger();
+    }
+}
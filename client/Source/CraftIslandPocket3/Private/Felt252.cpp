@@ -0,0 +1,173 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Felt252.h"
+
+bool FFelt252::TryParseHex(const FString& Hex, FFelt252& OutFelt)
+{
+    FMemory::Memzero(OutFelt.Bytes, NumBytes);
+
+    const TCHAR* Start = *Hex;
+    int32 Len = Hex.Len();
+    if (Len >= 2 && Start[0] == TEXT('0') && (Start[1] == TEXT('x') || Start[1] == TEXT('X')))
+    {
+        Start += 2;
+        Len -= 2;
+    }
+
+    // "" and a bare "0x" carry no digits at all: not a value, unlike "0x0"
+    if (Len == 0)
+    {
+        return false;
+    }
+
+    // Skip leading zeros so long zero-padded strings still fit
+    while (Len > 0 && *Start == TEXT('0'))
+    {
+        Start++;
+        Len--;
+    }
+
+    if (Len > NumBytes * 2)
+    {
+        return false;
+    }
+
+    // Fill from the least significant nibble (end of the string) backwards
+    for (int32 i = 0; i < Len; i++)
+    {
+        const TCHAR Char = Start[Len - 1 - i];
+        if (!FChar::IsHexDigit(Char))
+        {
+            FMemory::Memzero(OutFelt.Bytes, NumBytes);
+            return false;
+        }
+        const uint8 Nibble = FParse::HexDigit(Char);
+        uint8& Byte = OutFelt.Bytes[NumBytes - 1 - (i / 2)];
+        Byte |= (i % 2 == 0) ? Nibble : (Nibble << 4);
+    }
+    return true;
+}
+
+FFelt252 FFelt252::FromHex(const FString& Hex)
+{
+    FFelt252 Result;
+    TryParseHex(Hex, Result);
+    return Result;
+}
+
+FFelt252 FFelt252::FromUint64(uint64 Value)
+{
+    FFelt252 Result;
+    for (int32 i = 0; i < 8; i++)
+    {
+        Result.Bytes[NumBytes - 1 - i] = static_cast<uint8>(Value >> (i * 8));
+    }
+    return Result;
+}
+
+FString FFelt252::ToHex() const
+{
+    static const TCHAR* HexChars = TEXT("0123456789abcdef");
+
+    TCHAR Buffer[2 + NumBytes * 2 + 1];
+    int32 Pos = 0;
+    Buffer[Pos++] = TEXT('0');
+    Buffer[Pos++] = TEXT('x');
+
+    bool bLeading = true;
+    for (int32 i = 0; i < NumBytes; i++)
+    {
+        const uint8 High = Bytes[i] >> 4;
+        const uint8 Low = Bytes[i] & 0xF;
+        if (!bLeading || High != 0)
+        {
+            Buffer[Pos++] = HexChars[High];
+            bLeading = false;
+        }
+        if (!bLeading || Low != 0)
+        {
+            Buffer[Pos++] = HexChars[Low];
+            bLeading = false;
+        }
+    }
+    if (bLeading)
+    {
+        Buffer[Pos++] = TEXT('0');
+    }
+    Buffer[Pos] = TEXT('\0');
+    return FString(Buffer);
+}
+
+bool FFelt252::IsZero() const
+{
+    for (int32 i = 0; i < NumBytes; i++)
+    {
+        if (Bytes[i] != 0) return false;
+    }
+    return true;
+}
+
+bool FFelt252::IsBelowPrime() const
+{
+    // 2^251 + 17 * 2^192 + 1, big-endian like Bytes
+    static const uint8 Prime[NumBytes] = {
+        0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01 };
+    return FMemory::Memcmp(Bytes, Prime, NumBytes) < 0;
+}
+
+uint64 FFelt252::GetLow64() const
+{
+    uint64 Value = 0;
+    for (int32 i = NumBytes - 8; i < NumBytes; i++)
+    {
+        Value = (Value << 8) | Bytes[i];
+    }
+    return Value;
+}
+
+FChunkKey FChunkKey::FromHex(const FString& Hex)
+{
+    // A u128 is the low 16 bytes of the felt
+    return FromBytes(FFelt252::FromHex(Hex).Bytes + 16);
+}
+
+FChunkKey FChunkKey::FromBytes(const uint8* Bytes)
+{
+    FChunkKey Key;
+    for (int32 i = 0; i < 8; i++)
+    {
+        Key.High = (Key.High << 8) | Bytes[i];
+        Key.Low = (Key.Low << 8) | Bytes[i + 8];
+    }
+    return Key;
+}
+
+void FChunkKey::ToBytes(uint8* OutBytes) const
+{
+    for (int32 i = 0; i < 8; i++)
+    {
+        OutBytes[7 - i] = static_cast<uint8>(High >> (i * 8));
+        OutBytes[15 - i] = static_cast<uint8>(Low >> (i * 8));
+    }
+}
+
+FChunkKey FChunkKey::FromCoordinates(const FIntVector& Coordinates)
+{
+    constexpr uint64 Mask40 = (1ull << 40) - 1;
+    const uint64 X = static_cast<uint64>(Coordinates.X + 2048) & Mask40;
+    const uint64 Y = static_cast<uint64>(Coordinates.Y + 2048) & Mask40;
+    const uint64 Z = static_cast<uint64>(Coordinates.Z + 2048) & Mask40;
+    return FChunkKey((X << 16) | (Y >> 24), (Y << 40) | Z);
+}
+
+FIntVector FChunkKey::GetCoordinates() const
+{
+    // x << 80 | y << 40 | z, 40 bits each
+    constexpr uint64 Mask40 = (1ull << 40) - 1;
+    const uint64 X = (High >> 16) & Mask40;
+    const uint64 Y = ((High & 0xFFFF) << 24) | (Low >> 40);
+    const uint64 Z = Low & Mask40;
+    return FIntVector(static_cast<int32>(X) - 2048, static_cast<int32>(Y) - 2048, static_cast<int32>(Z) - 2048);
+}
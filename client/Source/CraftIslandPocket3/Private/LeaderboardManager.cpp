@@ -1,6 +1,8 @@
 #include "LeaderboardManager.h"
 #include "DojoCraftIslandManager.h"
 #include "CraftIslandGameInst.h"
+#include "WorldSnapshot.h"
+#include "DojoModule.h"
 #include "Engine/Engine.h"
 #include "Engine/World.h"
 #include "TimerManager.h"
@@ -113,10 +115,11 @@ void ULeaderboardManager::OnPlayerDataUpdated(UDojoModelCraftIslandPocketPlayerD
 void ULeaderboardManager::UpdatePlayerInCache(const FString& PlayerAddress, int32 Coins, const FString& PlayerName)
 {
     // Find existing player in cache
+    const FFelt252 PlayerId = FFelt252::FromHex(PlayerAddress);
     bool bPlayerFound = false;
     for (FPlayerLeaderboardData& PlayerData : CachedPlayerData)
     {
-        if (PlayerData.PlayerAddress == PlayerAddress)
+        if (PlayerData.PlayerId == PlayerId)
         {
             PlayerData.Coins = Coins;
             if (!PlayerName.IsEmpty())
@@ -135,6 +138,39 @@ void ULeaderboardManager::UpdatePlayerInCache(const FString& PlayerAddress, int3
     }
 }
 
+bool ULeaderboardManager::BootstrapFromSnapshot(const FString& SnapshotDirectory)
+{
+    FWorldSnapshot Snapshot;
+    if (!Snapshot.Open(SnapshotDirectory))
+    {
+        return false;
+    }
+
+    const FWorldSnapshot::FTable* Players = Snapshot.FindTable(TEXT("PlayerData"));
+    const FWorldSnapshot::FColumn* PlayerColumn = Players ? Players->FindColumn(TEXT("player")) : nullptr;
+    const FWorldSnapshot::FColumn* CoinsColumn = Players ? Players->FindColumn(TEXT("coins")) : nullptr;
+    const FWorldSnapshot::FColumn* NameColumn = Players ? Players->FindColumn(TEXT("name")) : nullptr;
+    if (!PlayerColumn || !CoinsColumn)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Leaderboard: snapshot %s has no PlayerData player/coins columns"), *SnapshotDirectory);
+        return false;
+    }
+
+    // A snapshot holds one row per player, so the cache is rebuilt wholesale rather than merged row by row
+    CachedPlayerData.Reset(Players->Rows);
+    for (int64 Row = 0; Row < Players->Rows; Row++)
+    {
+        const FFelt252 PlayerId = Snapshot.GetOwner(static_cast<uint32>(PlayerColumn->GetUInt(Row)));
+        const FString PlayerAddress = FDojoModule::bytes_to_fstring(PlayerId.Bytes, FFelt252::NumBytes);
+        const FString PlayerName = NameColumn ? NameColumn->GetText(Row) : FString();
+        CachedPlayerData.Add(FPlayerLeaderboardData(PlayerAddress, static_cast<int32>(CoinsColumn->GetUInt(Row)), PlayerName));
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("Leaderboard: bootstrapped %d players from %s"), CachedPlayerData.Num(), *SnapshotDirectory);
+    RebuildLeaderboard();
+    return true;
+}
+
 void ULeaderboardManager::RebuildLeaderboard()
 {
     // Sort the cached data by coins (descending)
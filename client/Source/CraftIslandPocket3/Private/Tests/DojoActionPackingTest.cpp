@@ -0,0 +1,270 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "DojoActionPacking.h"
+#include "Math/RandomStream.h"
+
+using namespace DojoActionPacking;
+
+namespace
+{
+    struct FGoldenVector
+    {
+        const TCHAR* Felt;
+        EPackType Pack;
+        TArray<FPackedAction> Actions;
+    };
+
+    FPackedAction MakeAction(EActionCode Code, std::initializer_list<uint64> Fields)
+    {
+        FPackedAction Action;
+        Action.Code = Code;
+        int32 i = 0;
+        for (uint64 Field : Fields)
+        {
+            Action.Fields[i++] = Field;
+        }
+        return Action;
+    }
+
+    // Felts built by hand from the offsets execute_packed_actions reads (contracts/src/systems/actions.cairo)
+    TArray<FGoldenVector> GetGoldenVectors()
+    {
+        return {
+            // Place (8195, 8190, 8193), hit (8192, 8192, 8192)
+            { TEXT("0x40010007001bffc200"), EPackType::PlaceHit, {
+                MakeAction(EActionCode::PlaceUse, { 8190, 8195, 1 }),
+                MakeAction(EActionCode::Hit, { 8192, 8192, 0 }) } },
+            // Seven hits on (8192, 8192, 8193), as many as a PlaceHit felt takes
+            { TEXT("0x30004001c00100070004001c00100070004001c00100070004001700"), EPackType::PlaceHit, {
+                MakeAction(EActionCode::Hit, { 8192, 8192, 1 }), MakeAction(EActionCode::Hit, { 8192, 8192, 1 }),
+                MakeAction(EActionCode::Hit, { 8192, 8192, 1 }), MakeAction(EActionCode::Hit, { 8192, 8192, 1 }),
+                MakeAction(EActionCode::Hit, { 8192, 8192, 1 }), MakeAction(EActionCode::Hit, { 8192, 8192, 1 }),
+                MakeAction(EActionCode::Hit, { 8192, 8192, 1 }) } },
+            // Move 0:2 -> 1:5, 1:35 -> 3:0
+            { TEXT("0x323010005010200201"), EPackType::Moves, {
+                MakeAction(EActionCode::MoveItem, { 0, 2, 1, 5, 0 }),
+                MakeAction(EActionCode::MoveItem, { 1, 35, 3, 0, 0 }) } },
+            // Select slot 3, hit (8200, 8190, 8193), sell, visit space 7, visit new island
+            { TEXT("0xa0007090618021ffe010302502"), EPackType::Mixed, {
+                MakeAction(EActionCode::SelectHotbar, { 3 }),
+                MakeAction(EActionCode::Hit, { 8190, 8200, 1, 0 }),
+                MakeAction(EActionCode::Sell, {}),
+                MakeAction(EActionCode::Visit, { 7 }),
+                MakeAction(EActionCode::VisitNewIsland, {}) } },
+            // Craft item 60 at (8193, 8194, 8192)
+            { TEXT("0x80060020000003c0303"), EPackType::Single, {
+                MakeAction(EActionCode::Craft, { 60, 8194, 8193, 0, 0 }) } },
+            // Buy 300 of item 17
+            { TEXT("0x12c00110503"), EPackType::Single, {
+                MakeAction(EActionCode::Buy, { 17, 300 }) } },
+            // Start process 2 on 1000 items
+            { TEXT("0x3e8020703"), EPackType::Single, {
+                MakeAction(EActionCode::StartProcess, { 2, 1000 }) } },
+            // Generate island 42 at (8192, 8200, 8193)
+            { TEXT("0xa980020080b03"), EPackType::Single, {
+                MakeAction(EActionCode::GenerateIsland, { 8200, 8192, 1, 0, 42 }) } },
+        };
+    }
+
+    uint64 FieldMask(int32 Bits)
+    {
+        return Bits == 64 ? ~0ULL : ((1ULL << Bits) - 1);
+    }
+
+    // Writes as many of Actions as the pack takes and reads them back
+    bool CheckRoundTrip(FAutomationTestBase& Test, const FPackSchema& Pack, const TArray<FPackedAction>& Actions, const TCHAR* What)
+    {
+        FPackWriter Writer(Pack);
+        TArray<FPackedAction> Written;
+        for (const FPackedAction& Action : Actions)
+        {
+            if (!Writer.Add(Action)) break;
+            Written.Add(Action);
+        }
+
+        TArray<FPackedAction> Decoded;
+        const FFelt252 Felt = Writer.ToFelt();
+        if (!Felt.IsBelowPrime())
+        {
+            Test.AddError(FString::Printf(TEXT("%s round trip for pack %d built %s, not below the prime"),
+                What, static_cast<int32>(Pack.Type), *Felt.ToHex()));
+            return false;
+        }
+        if (!DecodeFelt(Felt, Decoded) || Decoded != Written)
+        {
+            Test.AddError(FString::Printf(TEXT("%s round trip failed for pack %d (%s)"),
+                What, static_cast<int32>(Pack.Type), *Felt.ToHex()));
+            return false;
+        }
+        return true;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDojoActionPackingGoldenTest, "CraftIsland.Dojo.ActionPacking.Golden",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FDojoActionPackingGoldenTest::RunTest(const FString& Parameters)
+{
+    for (const FGoldenVector& Golden : GetGoldenVectors())
+    {
+        const FFelt252 Expected = FFelt252::FromHex(Golden.Felt);
+        TestTrue(FString::Printf(TEXT("Golden %s is below the prime"), Golden.Felt), Expected.IsBelowPrime());
+
+        TArray<FPackedAction> Decoded;
+        TestTrue(FString::Printf(TEXT("Golden %s decodes"), Golden.Felt), DecodeFelt(Expected, Decoded));
+        TestTrue(FString::Printf(TEXT("Golden %s decodes to its actions"), Golden.Felt), Decoded == Golden.Actions);
+
+        FPackWriter Writer(GetPackSchema(Golden.Pack));
+        for (const FPackedAction& Action : Golden.Actions)
+        {
+            Writer.Add(Action);
+        }
+        TestEqual(FString::Printf(TEXT("Golden %s encoding"), Golden.Felt), Writer.ToFelt().ToHex(), Expected.ToHex());
+    }
+
+    // An eighth hit on layer 8193 would set bit 251 and push the felt past the prime
+    // (0xc00100070004001c...800): the writer leaves it for the next felt
+    TestFalse(TEXT("Eight-hit felt of the old layout is invalid"),
+        FFelt252::FromHex(TEXT("0xc00100070004001c00100070004001c00100070004001c00100070004001800")).IsBelowPrime());
+    FPackWriter Writer(PlaceHitPack);
+    int32 Accepted = 0;
+    for (int32 i = 0; i < 8; i++)
+    {
+        Accepted += Writer.Add(MakeAction(EActionCode::Hit, { 8192, 8192, 1 })) ? 1 : 0;
+    }
+    TestEqual(TEXT("A PlaceHit felt takes seven hits on layer 8193"), Accepted, 7);
+    TestTrue(TEXT("Seven hits stay below the prime"), Writer.ToFelt().IsBelowPrime());
+
+    // Nothing may be set from bit 251 up, even where the layout has room: the sixth move's reserved byte
+    FPackWriter Moves(MovesPack);
+    for (int32 i = 0; i < 5; i++)
+    {
+        Moves.Add(MakeAction(EActionCode::MoveItem, { 1, 2, 3, 4, 0 }));
+    }
+    TestFalse(TEXT("Reserved bits reaching bit 251 are refused"), Moves.Add(MakeAction(EActionCode::MoveItem, { 1, 2, 3, 4, 0x80 })));
+    TestTrue(TEXT("A reserved byte ending below bit 251 still fits a sixth move"), Moves.Add(MakeAction(EActionCode::MoveItem, { 1, 2, 3, 4, 0x7F })));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDojoActionPackingRoundTripTest, "CraftIsland.Dojo.ActionPacking.RoundTrip",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FDojoActionPackingRoundTripTest::RunTest(const FString& Parameters)
+{
+    // Every action of every pack, filled to capacity with all-zero, all-one and random fields
+    const EPackType Packs[] = { EPackType::PlaceHit, EPackType::Moves, EPackType::Mixed, EPackType::Single };
+    const EActionCode Codes[] = {
+        EActionCode::PlaceUse, EActionCode::Hit, EActionCode::SelectHotbar, EActionCode::Craft, EActionCode::Buy,
+        EActionCode::Sell, EActionCode::StartProcess, EActionCode::CancelProcess, EActionCode::Visit,
+        EActionCode::VisitNewIsland, EActionCode::GenerateIsland, EActionCode::MoveItem };
+
+    FRandomStream Random(0x5EED);
+    auto RandomAction = [&Random](EActionCode Code, const FActionSchema& Schema)
+    {
+        FPackedAction Action;
+        Action.Code = Code;
+        for (int32 Field = 0; Field < Schema.NumFields; Field++)
+        {
+            const uint64 Value = (static_cast<uint64>(Random.GetUnsignedInt()) << 32) | Random.GetUnsignedInt();
+            Action.Fields[Field] = Value & FieldMask(Schema.FieldBits[Field]);
+        }
+        return Action;
+    };
+
+    for (EPackType PackType : Packs)
+    {
+        const FPackSchema& Pack = GetPackSchema(PackType);
+        for (EActionCode Code : Codes)
+        {
+            const FActionSchema* Schema = FindActionSchema(PackType, Code);
+            if (!Schema) continue;
+
+            TArray<FPackedAction> Zeros, Ones, Fuzz;
+            for (int32 i = 0; i < Pack.MaxCount; i++)
+            {
+                FPackedAction Zero;
+                Zero.Code = Code;
+                Zeros.Add(Zero);
+
+                FPackedAction One;
+                One.Code = Code;
+                for (int32 Field = 0; Field < Schema->NumFields; Field++)
+                {
+                    One.Fields[Field] = FieldMask(Schema->FieldBits[Field]);
+                }
+                Ones.Add(One);
+
+                Fuzz.Add(RandomAction(Code, *Schema));
+            }
+            CheckRoundTrip(*this, Pack, Zeros, TEXT("zeros"));
+            CheckRoundTrip(*this, Pack, Ones, TEXT("ones"));
+            CheckRoundTrip(*this, Pack, Fuzz, TEXT("fuzz"));
+        }
+    }
+
+    // Random mixes of whatever a Mixed pack takes
+    for (int32 Run = 0; Run < 256; Run++)
+    {
+        TArray<FPackedAction> Mix;
+        for (int32 i = 0; i < MixedPack.MaxCount; i++)
+        {
+            const FActionSchema& Schema = MixedActions[Random.RandHelper(static_cast<int32>(UE_ARRAY_COUNT(MixedActions)))];
+            Mix.Add(RandomAction(Schema.Code, Schema));
+        }
+        CheckRoundTrip(*this, MixedPack, Mix, TEXT("mixed fuzz"));
+    }
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDojoActionPackingPlannerTest, "CraftIsland.Dojo.ActionPacking.FeltBudget",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FDojoActionPackingPlannerTest::RunTest(const FString& Parameters)
+{
+    // Seven hits a felt: ten felts take seventy, the seventy-first is refused and leaves the plan alone
+    FPackPlanner Planner;
+    const FPackedAction Hit = MakeAction(EActionCode::Hit, { 8192, 8192, 1 });
+    for (int32 i = 0; i < 70; i++)
+    {
+        if (!Planner.Add(Hit, 10))
+        {
+            AddError(FString::Printf(TEXT("Hit %d refused within ten felts"), i));
+            return false;
+        }
+    }
+    TestEqual(TEXT("Seventy hits take ten felts"), Planner.GetNumFelts(), 10);
+    TestFalse(TEXT("The seventy-first hit would take an eleventh felt"), Planner.Add(Hit, 10));
+    TestEqual(TEXT("A refused action isn't planned"), Planner.Num(), 70);
+
+    // Six moves fill a Moves felt, the select and hits after them share a Mixed one; all decode back in order
+    FPackPlanner Mixed;
+    TArray<FPackedAction> Actions;
+    for (int32 i = 0; i < 6; i++)
+    {
+        Actions.Add(MakeAction(EActionCode::MoveItem, { 0, static_cast<uint64>(i), 1, 0, 0 }));
+    }
+    Actions.Add(MakeAction(EActionCode::SelectHotbar, { 2 }));
+    Actions.Add(Hit);
+    Actions.Add(Hit);
+    for (const FPackedAction& Action : Actions)
+    {
+        Mixed.Add(Action);
+    }
+    TestEqual(TEXT("Six moves, then a select and two hits in a Mixed felt"), Mixed.GetNumFelts(), 2);
+
+    TArray<FPackedAction> Decoded;
+    for (const FFelt252& Felt : Mixed.ToFelts())
+    {
+        TestTrue(TEXT("Planned felt is below the prime"), Felt.IsBelowPrime());
+        DecodeFelt(Felt, Decoded);
+    }
+    TestTrue(TEXT("Planned felts decode to the actions"), Decoded == Actions);
+    return true;
+}
+
+#endif
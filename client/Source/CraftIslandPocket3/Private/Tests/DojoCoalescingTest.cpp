@@ -0,0 +1,88 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "DojoCraftIslandManager.h"
+#include "BaseBlock.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDojoCoalescePlaceThenShovelTest, "CraftIsland.Dojo.Coalescing.PlaceThenShovel",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FDojoCoalescePlaceThenShovelTest::RunTest(const FString& Parameters)
+{
+    UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+    FWorldContext& Context = GEngine->CreateNewWorldContext(EWorldType::Game);
+    Context.SetCurrentWorld(World);
+
+    ADojoCraftIslandManager* Manager = World->SpawnActor<ADojoCraftIslandManager>();
+    ABaseBlock* Block = World->SpawnActor<ABaseBlock>();
+    const FIntVector Position(8192, 8192, 4);
+
+    // What RequestPlaceUse then RequestHit leave behind: a tagged placement, in Actors and OptimisticActors
+    Block->Item = E_Item::Dirt;
+    Block->DojoPosition = Position;
+    Block->Tags.Add(FName("OptimisticPlacement"));
+    Block->Tags.Add(ADojoCraftIslandManager::GetPlacementTag(7));
+    Block->Tags.Add(FName("OptimisticRemoval"));
+    Manager->Actors.Add(Position, Block);
+    Manager->ActorSpawnInfo.Add(Position, FActorSpawnInfo(Block, EActorSpawnType::ChunkBlock));
+    Manager->OptimisticActors.Add(Position, Block);
+    Manager->OptimisticActorTimestamps.Add(Position, 0.0);
+
+    FTransactionQueueItem Place;
+    Place.Type = ETransactionType::PlaceUse;
+    Place.Position = Position;
+    Place.ItemType = E_Item::Dirt;
+    Place.SequenceNumber = 7;
+    FTransactionQueueItem Hit;
+    Hit.Type = ETransactionType::Hit;
+    Hit.Position = Position;
+    Hit.ItemType = static_cast<E_Item>(39);
+
+    // A buy without quantities must be left alone, not read past its end
+    FTransactionQueueItem BadBuy;
+    BadBuy.Type = ETransactionType::Buy;
+    BadBuy.ItemIds.Add(1);
+    FTransactionQueueItem Buy;
+    Buy.Type = ETransactionType::Buy;
+    Buy.ItemIds.Add(1);
+    Buy.Quantities.Add(2);
+
+    TArray<FTransactionQueueItem> Actions = { Place, Hit, BadBuy, Buy };
+    TestEqual(TEXT("Place and shovel are both dropped"), Manager->CoalescePendingActions(Actions), 2);
+    TestEqual(TEXT("Only the two buys remain"), Actions.Num(), 2);
+    TestFalse(TEXT("No optimistic entry left to roll back"), Manager->OptimisticActors.Contains(Position));
+    TestFalse(TEXT("No actor left at the cell"), Manager->Actors.Contains(Position));
+    TestFalse(TEXT("No spawn info left at the cell"), Manager->ActorSpawnInfo.Contains(Position));
+    TestTrue(TEXT("The placed block is destroyed"), !IsValid(Block));
+
+    // A block spawned by an earlier placement at the same cell is not this PlaceUse's to cancel
+    ABaseBlock* Earlier = World->SpawnActor<ABaseBlock>();
+    Earlier->Item = E_Item::Dirt;
+    Earlier->Tags.Add(FName("OptimisticPlacement"));
+    Earlier->Tags.Add(ADojoCraftIslandManager::GetPlacementTag(3));
+    Manager->Actors.Add(Position, Earlier);
+    Manager->OptimisticActors.Add(Position, Earlier);
+    TArray<FTransactionQueueItem> Replaced = { Place, Hit };
+    TestEqual(TEXT("A place whose actor carries another sequence is kept"), Manager->CoalescePendingActions(Replaced), 0);
+    TestTrue(TEXT("The earlier block survives"), IsValid(Earlier) && Manager->OptimisticActors.FindRef(Position) == Earlier);
+
+    // Buys merge only while the sum still fits the quantity field
+    TArray<FTransactionQueueItem> Buys = { Buy, Buy, Buy };
+    Buys[0].Quantities[0] = MAX_int32 - 10;
+    Buys[1].Quantities[0] = 10;
+    Buys[2].Quantities[0] = 1;
+    TestEqual(TEXT("Only the buy that still fits is merged"), Manager->CoalescePendingActions(Buys), 1);
+    TestTrue(TEXT("Merged quantity stops at the limit"), Buys.Num() == 2 && Buys[0].Quantities[0] == MAX_int32 && Buys[1].Quantities[0] == 1);
+
+    GEngine->DestroyWorldContext(World);
+    World->DestroyWorld(false);
+    return true;
+}
+
+#endif
@@ -0,0 +1,66 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "DojoCraftIslandManager.h"
+#include "DojoHelpers.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+namespace
+{
+    UDojoModelCraftIslandPocketInventory* MakeInventory(UObject* Outer, const TCHAR* Owner, int32 Id, const TCHAR* Slots1)
+    {
+        UDojoModelCraftIslandPocketInventory* Inventory = NewObject<UDojoModelCraftIslandPocketInventory>(Outer);
+        Inventory->DojoModelType = TEXT("craft_island_pocket-Inventory");
+        Inventory->Owner = Owner;
+        Inventory->Id = Id;
+        Inventory->Slots1 = Slots1;
+        return Inventory;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDojoModelUpdateCoalescingTest, "CraftIsland.Dojo.Ingest.CoalescePerEntity",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FDojoModelUpdateCoalescingTest::RunTest(const FString& Parameters)
+{
+    UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+    FWorldContext& Context = GEngine->CreateNewWorldContext(EWorldType::Game);
+    Context.SetCurrentWorld(World);
+
+    ADojoCraftIslandManager* Manager = World->SpawnActor<ADojoCraftIslandManager>();
+    Manager->DojoHelpers = World->SpawnActor<ADojoHelpers>();
+
+    // Three versions of the same inventory in one frame (the owner written with and without leading zeros),
+    // and another inventory of the same player in between
+    UDojoModelCraftIslandPocketInventory* First = MakeInventory(Manager, TEXT("0x0abc"), 1, TEXT("0x1"));
+    UDojoModelCraftIslandPocketInventory* Other = MakeInventory(Manager, TEXT("0xabc"), 2, TEXT("0x2"));
+    UDojoModelCraftIslandPocketInventory* Second = MakeInventory(Manager, TEXT("0xabc"), 1, TEXT("0x3"));
+    UDojoModelCraftIslandPocketInventory* Latest = MakeInventory(Manager, TEXT("0x000abc"), 1, TEXT("0x4"));
+    for (UDojoModel* Model : { (UDojoModel*)First, (UDojoModel*)Other, (UDojoModel*)Second, (UDojoModel*)Latest })
+    {
+        Manager->HandleDojoModel(Model);
+    }
+
+    TestEqual(TEXT("One staged update per entity"), Manager->PendingModelUpdates.Num(), 2);
+    TestEqual(TEXT("Two redundant versions collapsed"), Manager->GetCoalescedModelUpdateCount(), (int64)2);
+    if (Manager->PendingModelUpdates.Num() == 2)
+    {
+        TestTrue(TEXT("The latest version replaces the first in its slot"), Manager->PendingModelUpdates[0] == Latest);
+        TestTrue(TEXT("The other entity keeps its own slot"), Manager->PendingModelUpdates[1] == Other);
+    }
+    // With no Blueprint listener bound, the versions that lost go back to the pool reset to defaults
+    TestTrue(TEXT("Superseded versions are recycled"), First->Slots1.IsEmpty() && Second->Slots1.IsEmpty());
+
+    Manager->PendingModelUpdates.Reset();
+    Manager->PendingModelIndex.Reset();
+    GEngine->DestroyWorldContext(World);
+    World->DestroyWorld(false);
+    return true;
+}
+
+#endif
@@ -0,0 +1,49 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Felt252.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFelt252ParseHashTest, "CraftIsland.Dojo.Felt252.ParseAndHash",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FFelt252ParseHashTest::RunTest(const FString& Parameters)
+{
+    FFelt252 Felt;
+    TestFalse(TEXT("Empty string is rejected"), FFelt252::TryParseHex(TEXT(""), Felt));
+    TestFalse(TEXT("Bare prefix is rejected"), FFelt252::TryParseHex(TEXT("0x"), Felt));
+    TestTrue(TEXT("0x0 is zero"), FFelt252::TryParseHex(TEXT("0x0"), Felt) && Felt.IsZero());
+    TestEqual(TEXT("Leading zeros are canonicalised"), FFelt252::FromHex(TEXT("0x000ABC")).ToHex(), FString(TEXT("0xabc")));
+
+    // Same 64-bit words in another order, and a word repeated: an XOR of the words maps all of these to one hash
+    const FFelt252 A = FFelt252::FromHex(TEXT("0x1111111111111111222222222222222233333333333333334444444444444444"));
+    const FFelt252 B = FFelt252::FromHex(TEXT("0x2222222222222222111111111111111133333333333333334444444444444444"));
+    const FFelt252 C = FFelt252::FromHex(TEXT("0x1111111111111111111111111111111100000000000000000000000000000000"));
+    TestNotEqual(TEXT("Permuted words hash differently"), GetTypeHash(A), GetTypeHash(B));
+    TestNotEqual(TEXT("Repeated words don't hash like zero"), GetTypeHash(C), GetTypeHash(FFelt252()));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChunkKeyCoordinatesTest, "CraftIsland.Dojo.Felt252.ChunkKeyCoordinates",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FChunkKeyCoordinatesTest::RunTest(const FString& Parameters)
+{
+    // x << 80 | y << 40 | z, each relative to the 2048 origin
+    const FChunkKey Origin = FChunkKey::FromHex(TEXT("0x80000000008000000000800"));
+    TestEqual(TEXT("Origin chunk decodes to 0,0,0"), Origin.GetCoordinates(), FIntVector(0, 0, 0));
+    TestTrue(TEXT("0,0,0 encodes to the origin chunk"), FChunkKey::FromCoordinates(FIntVector(0, 0, 0)) == Origin);
+
+    const FIntVector Coordinates[] = { FIntVector(1, -1, 2), FIntVector(-2048, 2047, 0), FIntVector(300, 5, -7) };
+    for (const FIntVector& Coordinate : Coordinates)
+    {
+        TestEqual(FString::Printf(TEXT("%s round-trips"), *Coordinate.ToString()),
+            FChunkKey::FromCoordinates(Coordinate).GetCoordinates(), Coordinate);
+    }
+    return true;
+}
+
+#endif
@@ -0,0 +1,458 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "WorldAnalyticsCommandlet.h"
+#include "WorldSnapshot.h"
+#include "DojoDecoders.h"
+#include "E_Item.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+    using FColumn = FWorldSnapshot::FColumn;
+    using FTable = FWorldSnapshot::FTable;
+
+    // Rows per ParallelFor task: large enough to amortize the per-task accumulator merge
+    constexpr int64 ROWS_PER_TASK = 16384;
+
+    // item_type is 10 bits in inventory slots and u16 in gatherables / structures
+    constexpr int32 MAX_ITEM_TYPES = 1024;
+
+    /**
+     * Scans Rows in blocks, one accumulator per block, then folds them in order.
+     * TAccumulator needs a default constructor and Merge(const TAccumulator&).
+     */
+    template<typename TAccumulator, typename TRowFn>
+    TAccumulator ParallelScan(int64 Rows, TRowFn RowFn)
+    {
+        const int32 NumTasks = static_cast<int32>(FMath::DivideAndRoundUp(Rows, ROWS_PER_TASK));
+        TArray<TAccumulator> Partials;
+        Partials.SetNum(FMath::Max(NumTasks, 1));
+
+        ParallelFor(NumTasks, [&Partials, &RowFn, Rows](int32 TaskIndex)
+        {
+            const int64 First = TaskIndex * ROWS_PER_TASK;
+            const int64 Last = FMath::Min(First + ROWS_PER_TASK, Rows);
+            TAccumulator& Partial = Partials[TaskIndex];
+            for (int64 Row = First; Row < Last; Row++)
+            {
+                RowFn(Partial, Row);
+            }
+        });
+
+        for (int32 i = 1; i < Partials.Num(); i++)
+        {
+            Partials[0].Merge(Partials[i]);
+        }
+        return MoveTemp(Partials[0]);
+    }
+
+    const FColumn* RequireColumn(const FTable* Table, const TCHAR* Name)
+    {
+        const FColumn* Column = Table ? Table->FindColumn(Name) : nullptr;
+        if (Table && !Column)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("WorldAnalytics: %s has no column %s"), *Table->Model, Name);
+        }
+        return Column;
+    }
+
+    FString GetItemName(int32 ItemType)
+    {
+        const FString Name = ItemType <= MAX_uint8 ? StaticEnum<E_Item>()->GetNameStringByValue(ItemType) : FString();
+        return Name.IsEmpty() ? FString::Printf(TEXT("Item%d"), ItemType) : Name;
+    }
+
+    struct FItemCounts
+    {
+        TArray<int64> Counts;
+
+        FItemCounts() { Counts.SetNumZeroed(MAX_ITEM_TYPES); }
+
+        void Add(int32 ItemType, int64 Amount)
+        {
+            if (ItemType > 0 && ItemType < MAX_ITEM_TYPES) Counts[ItemType] += Amount;
+        }
+
+        void Merge(const FItemCounts& Other)
+        {
+            for (int32 i = 0; i < MAX_ITEM_TYPES; i++) Counts[i] += Other.Counts[i];
+        }
+
+        TSharedRef<FJsonObject> ToJson() const
+        {
+            TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+            for (int32 i = 0; i < MAX_ITEM_TYPES; i++)
+            {
+                if (Counts[i] > 0) Json->SetNumberField(GetItemName(i), static_cast<double>(Counts[i]));
+            }
+            return Json;
+        }
+    };
+
+    TSharedRef<FJsonObject> AnalyzeCoins(const FTable* Players)
+    {
+        TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+        const FColumn* CoinsColumn = RequireColumn(Players, TEXT("coins"));
+        if (!CoinsColumn || Players->Rows == 0) return Json;
+
+        // Every row writes its own slot; the sort is the only non-linear step
+        TArray<uint32> Coins;
+        Coins.SetNumUninitialized(Players->Rows);
+        ParallelFor(static_cast<int32>(FMath::DivideAndRoundUp(Players->Rows, ROWS_PER_TASK)), [&Coins, CoinsColumn, Players](int32 TaskIndex)
+        {
+            const int64 First = TaskIndex * ROWS_PER_TASK;
+            const int64 Last = FMath::Min(First + ROWS_PER_TASK, Players->Rows);
+            for (int64 Row = First; Row < Last; Row++)
+            {
+                Coins[Row] = static_cast<uint32>(CoinsColumn->GetUInt(Row));
+            }
+        });
+        Coins.Sort();
+
+        const int64 Count = Coins.Num();
+        double Total = 0.0;
+        double RankWeighted = 0.0;
+        for (int64 i = 0; i < Count; i++)
+        {
+            Total += Coins[i];
+            RankWeighted += static_cast<double>(i + 1) * Coins[i];
+        }
+        auto Percentile = [&Coins, Count](double P) { return Coins[FMath::Min<int64>(Count - 1, static_cast<int64>(P * Count))]; };
+
+        Json->SetNumberField(TEXT("players"), Count);
+        Json->SetNumberField(TEXT("total"), Total);
+        Json->SetNumberField(TEXT("mean"), Total / Count);
+        Json->SetNumberField(TEXT("median"), Percentile(0.5));
+        Json->SetNumberField(TEXT("p90"), Percentile(0.9));
+        Json->SetNumberField(TEXT("p99"), Percentile(0.99));
+        Json->SetNumberField(TEXT("max"), Coins.Last());
+        Json->SetNumberField(TEXT("gini"), Total > 0.0 ? (2.0 * RankWeighted) / (Count * Total) - (Count + 1.0) / Count : 0.0);
+
+        // Power-of-two buckets: "0", "1", "2-3", "4-7", ...
+        TArray<int64> Buckets;
+        Buckets.SetNumZeroed(33);
+        for (uint32 Value : Coins)
+        {
+            Buckets[Value == 0 ? 0 : FMath::FloorLog2(Value) + 1]++;
+        }
+        TSharedRef<FJsonObject> Histogram = MakeShared<FJsonObject>();
+        for (int32 b = 0; b < Buckets.Num(); b++)
+        {
+            if (Buckets[b] == 0) continue;
+            const FString Label = b == 0 ? TEXT("0") : FString::Printf(TEXT("%llu-%llu"), 1ull << (b - 1), (1ull << b) - 1);
+            Histogram->SetNumberField(Label, static_cast<double>(Buckets[b]));
+        }
+        Json->SetObjectField(TEXT("histogram"), Histogram);
+        return Json;
+    }
+
+    TSharedRef<FJsonObject> AnalyzeItemSupply(const FWorldSnapshot& Snapshot)
+    {
+        TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+
+        if (const FTable* Inventories = Snapshot.FindTable(TEXT("Inventory")))
+        {
+            const FColumn* Size = RequireColumn(Inventories, TEXT("inventory_size"));
+            const FColumn* Slots[4] = {
+                RequireColumn(Inventories, TEXT("slots1")), RequireColumn(Inventories, TEXT("slots2")),
+                RequireColumn(Inventories, TEXT("slots3")), RequireColumn(Inventories, TEXT("slots4")) };
+            if (Size && Slots[0] && Slots[1] && Slots[2] && Slots[3])
+            {
+                const FItemCounts Held = ParallelScan<FItemCounts>(Inventories->Rows, [Size, &Slots](FItemCounts& Acc, int64 Row)
+                {
+                    const int32 NumSlots = FMath::Min(static_cast<int32>(Size->GetUInt(Row)), DojoDecoders::MAX_INVENTORY_SLOTS);
+                    for (int32 Slot = 0; Slot < NumSlots; Slot++)
+                    {
+                        const uint8* Felt = Slots[Slot / DojoDecoders::SLOTS_PER_FELT]->Data + Row * FFelt252::NumBytes;
+                        const DojoDecoders::FInventorySlot Data = DojoDecoders::DecodeInventorySlot(Felt, Slot % DojoDecoders::SLOTS_PER_FELT);
+                        if (!Data.IsEmpty()) Acc.Add(Data.ItemType, Data.Quantity);
+                    }
+                });
+                Json->SetObjectField(TEXT("inventories"), Held.ToJson());
+            }
+        }
+
+        if (const FTable* Chunks = Snapshot.FindTable(TEXT("IslandChunk")))
+        {
+            const FColumn* Blocks1 = RequireColumn(Chunks, TEXT("blocks1"));
+            const FColumn* Blocks2 = RequireColumn(Chunks, TEXT("blocks2"));
+            if (Blocks1 && Blocks2)
+            {
+                const FItemCounts Placed = ParallelScan<FItemCounts>(Chunks->Rows, [Blocks1, Blocks2](FItemCounts& Acc, int64 Row)
+                {
+                    const uint8* High = Blocks1->Data + Row * 16;
+                    const uint8* Low = Blocks2->Data + Row * 16;
+                    for (int32 Index = 0; Index < DojoDecoders::BLOCKS_PER_CHUNK; Index++)
+                    {
+                        Acc.Add(DojoDecoders::GetChunkBlock(High, Low, Index), 1);
+                    }
+                });
+                Json->SetObjectField(TEXT("placed_blocks"), Placed.ToJson());
+            }
+        }
+
+        auto CountLiving = [&Json](const FTable* Table, const TCHAR* TypeColumnName, const TCHAR* Field)
+        {
+            const FColumn* TypeColumn = RequireColumn(Table, TypeColumnName);
+            const FColumn* Destroyed = RequireColumn(Table, TEXT("destroyed"));
+            if (!TypeColumn || !Destroyed) return;
+            const FItemCounts Living = ParallelScan<FItemCounts>(Table->Rows, [TypeColumn, Destroyed](FItemCounts& Acc, int64 Row)
+            {
+                if (!Destroyed->GetBool(Row)) Acc.Add(static_cast<int32>(TypeColumn->GetUInt(Row)), 1);
+            });
+            Json->SetObjectField(Field, Living.ToJson());
+        };
+        CountLiving(Snapshot.FindTable(TEXT("GatherableResource")), TEXT("resource_id"), TEXT("gatherables"));
+        CountLiving(Snapshot.FindTable(TEXT("WorldStructure")), TEXT("structure_type"), TEXT("structures"));
+
+        return Json;
+    }
+
+    // Island identity inside one snapshot: owner dictionary index + island id
+    uint64 MakeIslandKey(const FColumn* Owner, const FColumn* IslandId, int64 Row)
+    {
+        return (Owner->GetUInt(Row) << 16) | (IslandId->GetUInt(Row) & 0xFFFF);
+    }
+
+    struct FIslandSet
+    {
+        TSet<uint64> Islands;
+        int64 NonEmptyChunks = 0;
+
+        void Merge(const FIslandSet& Other)
+        {
+            Islands.Append(Other.Islands);
+            NonEmptyChunks += Other.NonEmptyChunks;
+        }
+    };
+
+    TSharedRef<FJsonObject> AnalyzeIslands(const FWorldSnapshot& Snapshot, int64 ActiveSince)
+    {
+        TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+        const FTable* Chunks = Snapshot.FindTable(TEXT("IslandChunk"));
+        const FColumn* ChunkOwner = RequireColumn(Chunks, TEXT("island_owner"));
+        const FColumn* ChunkIsland = RequireColumn(Chunks, TEXT("island_id"));
+        const FColumn* Blocks1 = RequireColumn(Chunks, TEXT("blocks1"));
+        const FColumn* Blocks2 = RequireColumn(Chunks, TEXT("blocks2"));
+        if (!ChunkOwner || !ChunkIsland || !Blocks1 || !Blocks2) return Json;
+
+        const FIslandSet All = ParallelScan<FIslandSet>(Chunks->Rows, [=](FIslandSet& Acc, int64 Row)
+        {
+            Acc.Islands.Add(MakeIslandKey(ChunkOwner, ChunkIsland, Row));
+            const uint8* High = Blocks1->Data + Row * 16;
+            const uint8* Low = Blocks2->Data + Row * 16;
+            bool bEmpty = true;
+            for (int32 i = 0; i < 16 && bEmpty; i++) bEmpty = High[i] == 0 && Low[i] == 0;
+            if (!bEmpty) Acc.NonEmptyChunks++;
+        });
+
+        Json->SetNumberField(TEXT("islands"), All.Islands.Num());
+        Json->SetNumberField(TEXT("chunks"), Chunks->Rows);
+        Json->SetNumberField(TEXT("non_empty_chunks"), All.NonEmptyChunks);
+        Json->SetNumberField(TEXT("chunks_per_island"), All.Islands.Num() > 0 ? static_cast<double>(Chunks->Rows) / All.Islands.Num() : 0.0);
+
+        // Active: an island where something was planted or harvested within the window
+        const FTable* Gatherables = Snapshot.FindTable(TEXT("GatherableResource"));
+        const FColumn* Owner = RequireColumn(Gatherables, TEXT("island_owner"));
+        const FColumn* IslandId = RequireColumn(Gatherables, TEXT("island_id"));
+        const FColumn* PlantedAt = RequireColumn(Gatherables, TEXT("planted_at"));
+        const FColumn* HarvestedAt = RequireColumn(Gatherables, TEXT("harvested_at"));
+        if (Owner && IslandId && PlantedAt && HarvestedAt)
+        {
+            const FIslandSet Active = ParallelScan<FIslandSet>(Gatherables->Rows, [=](FIslandSet& Acc, int64 Row)
+            {
+                if (static_cast<int64>(FMath::Max(PlantedAt->GetUInt(Row), HarvestedAt->GetUInt(Row))) >= ActiveSince)
+                {
+                    Acc.Islands.Add(MakeIslandKey(Owner, IslandId, Row));
+                }
+            });
+            Json->SetNumberField(TEXT("active_islands"), Active.Islands.Num());
+            Json->SetNumberField(TEXT("active_since"), ActiveSince);
+        }
+        return Json;
+    }
+
+    struct FReadinessCounts
+    {
+        TArray<int64> Total;
+        TArray<int64> Ready;
+        int64 Golden = 0;
+        int64 Exhausted = 0;
+
+        FReadinessCounts()
+        {
+            Total.SetNumZeroed(MAX_ITEM_TYPES);
+            Ready.SetNumZeroed(MAX_ITEM_TYPES);
+        }
+
+        void Merge(const FReadinessCounts& Other)
+        {
+            for (int32 i = 0; i < MAX_ITEM_TYPES; i++)
+            {
+                Total[i] += Other.Total[i];
+                Ready[i] += Other.Ready[i];
+            }
+            Golden += Other.Golden;
+            Exhausted += Other.Exhausted;
+        }
+    };
+
+    TSharedRef<FJsonObject> AnalyzeCrops(const FTable* Gatherables, int64 Now)
+    {
+        TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+        const FColumn* ResourceId = RequireColumn(Gatherables, TEXT("resource_id"));
+        const FColumn* NextHarvestAt = RequireColumn(Gatherables, TEXT("next_harvest_at"));
+        const FColumn* Remained = RequireColumn(Gatherables, TEXT("remained_harvest"));
+        const FColumn* Destroyed = RequireColumn(Gatherables, TEXT("destroyed"));
+        const FColumn* Tier = RequireColumn(Gatherables, TEXT("tier"));
+        if (!ResourceId || !NextHarvestAt || !Remained || !Destroyed || !Tier) return Json;
+
+        const FReadinessCounts Counts = ParallelScan<FReadinessCounts>(Gatherables->Rows, [=](FReadinessCounts& Acc, int64 Row)
+        {
+            if (Destroyed->GetBool(Row)) return;
+            const int32 Item = static_cast<int32>(ResourceId->GetUInt(Row));
+            if (Item <= 0 || Item >= MAX_ITEM_TYPES) return;
+            Acc.Total[Item]++;
+            if (static_cast<int64>(NextHarvestAt->GetUInt(Row)) <= Now) Acc.Ready[Item]++;
+            if (Tier->GetUInt(Row) == 1) Acc.Golden++;
+            if (Remained->GetUInt(Row) == 0) Acc.Exhausted++;
+        });
+
+        int64 Total = 0, Ready = 0;
+        TSharedRef<FJsonObject> PerResource = MakeShared<FJsonObject>();
+        for (int32 i = 0; i < MAX_ITEM_TYPES; i++)
+        {
+            if (Counts.Total[i] == 0) continue;
+            Total += Counts.Total[i];
+            Ready += Counts.Ready[i];
+            TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
+            Entry->SetNumberField(TEXT("total"), static_cast<double>(Counts.Total[i]));
+            Entry->SetNumberField(TEXT("ready"), static_cast<double>(Counts.Ready[i]));
+            Entry->SetNumberField(TEXT("ready_ratio"), static_cast<double>(Counts.Ready[i]) / Counts.Total[i]);
+            PerResource->SetObjectField(GetItemName(i), Entry);
+        }
+
+        Json->SetNumberField(TEXT("total"), static_cast<double>(Total));
+        Json->SetNumberField(TEXT("ready"), static_cast<double>(Ready));
+        Json->SetNumberField(TEXT("ready_ratio"), Total > 0 ? static_cast<double>(Ready) / Total : 0.0);
+        Json->SetNumberField(TEXT("golden"), static_cast<double>(Counts.Golden));
+        Json->SetNumberField(TEXT("exhausted"), static_cast<double>(Counts.Exhausted));
+        Json->SetObjectField(TEXT("per_resource"), PerResource);
+        return Json;
+    }
+
+    TSharedRef<FJsonObject> AnalyzeStructures(const FTable* Structures)
+    {
+        TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+        const FColumn* Type = RequireColumn(Structures, TEXT("structure_type"));
+        const FColumn* Completed = RequireColumn(Structures, TEXT("completed"));
+        const FColumn* Destroyed = RequireColumn(Structures, TEXT("destroyed"));
+        if (!Type || !Completed || !Destroyed) return Json;
+
+        // Same accumulator shape as crops: Total = standing structures, Ready = completed ones
+        const FReadinessCounts Counts = ParallelScan<FReadinessCounts>(Structures->Rows, [=](FReadinessCounts& Acc, int64 Row)
+        {
+            if (Destroyed->GetBool(Row))
+            {
+                Acc.Exhausted++;
+                return;
+            }
+            const int32 Item = static_cast<int32>(Type->GetUInt(Row));
+            if (Item <= 0 || Item >= MAX_ITEM_TYPES) return;
+            Acc.Total[Item]++;
+            if (Completed->GetBool(Row)) Acc.Ready[Item]++;
+        });
+
+        int64 Total = 0, Done = 0;
+        TSharedRef<FJsonObject> PerType = MakeShared<FJsonObject>();
+        for (int32 i = 0; i < MAX_ITEM_TYPES; i++)
+        {
+            if (Counts.Total[i] == 0) continue;
+            Total += Counts.Total[i];
+            Done += Counts.Ready[i];
+            TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
+            Entry->SetNumberField(TEXT("total"), static_cast<double>(Counts.Total[i]));
+            Entry->SetNumberField(TEXT("completed"), static_cast<double>(Counts.Ready[i]));
+            Entry->SetNumberField(TEXT("completion_rate"), static_cast<double>(Counts.Ready[i]) / Counts.Total[i]);
+            PerType->SetObjectField(GetItemName(i), Entry);
+        }
+
+        Json->SetNumberField(TEXT("total"), static_cast<double>(Total));
+        Json->SetNumberField(TEXT("completed"), static_cast<double>(Done));
+        Json->SetNumberField(TEXT("completion_rate"), Total > 0 ? static_cast<double>(Done) / Total : 0.0);
+        Json->SetNumberField(TEXT("destroyed"), static_cast<double>(Counts.Exhausted));
+        Json->SetObjectField(TEXT("per_type"), PerType);
+        return Json;
+    }
+}
+
+UWorldAnalyticsCommandlet::UWorldAnalyticsCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 UWorldAnalyticsCommandlet::Main(const FString& Params)
+{
+    FString SnapshotDirectory;
+    if (!FParse::Value(*Params, TEXT("Snapshot="), SnapshotDirectory))
+    {
+        UE_LOG(LogTemp, Error, TEXT("WorldAnalytics: usage -run=WorldAnalytics -Snapshot=<dir> [-Out=<report.json>] [-Now=<unix>] [-ActiveDays=7]"));
+        return 1;
+    }
+
+    FWorldSnapshot Snapshot;
+    if (!Snapshot.Open(SnapshotDirectory))
+    {
+        return 1;
+    }
+
+    // Readiness is judged at snapshot time unless told otherwise
+    int64 Now = Snapshot.GetCreatedAt();
+    FParse::Value(*Params, TEXT("Now="), Now);
+    int32 ActiveDays = 7;
+    FParse::Value(*Params, TEXT("ActiveDays="), ActiveDays);
+    FString OutPath = FPaths::Combine(SnapshotDirectory, TEXT("analytics.json"));
+    FParse::Value(*Params, TEXT("Out="), OutPath);
+
+    int64 TotalRows = 0;
+    for (const FTable& Table : Snapshot.GetTables())
+    {
+        TotalRows += Table.Rows;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+    TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+    Report->SetStringField(TEXT("world"), Snapshot.GetWorldAddress());
+    Report->SetNumberField(TEXT("snapshot_time"), Snapshot.GetCreatedAt());
+    Report->SetNumberField(TEXT("now"), Now);
+    Report->SetNumberField(TEXT("rows"), TotalRows);
+    Report->SetObjectField(TEXT("coins"), AnalyzeCoins(Snapshot.FindTable(TEXT("PlayerData"))));
+    Report->SetObjectField(TEXT("item_supply"), AnalyzeItemSupply(Snapshot));
+    Report->SetObjectField(TEXT("islands"), AnalyzeIslands(Snapshot, Now - static_cast<int64>(ActiveDays) * 86400));
+    Report->SetObjectField(TEXT("crops"), AnalyzeCrops(Snapshot.FindTable(TEXT("GatherableResource")), Now));
+    Report->SetObjectField(TEXT("structures"), AnalyzeStructures(Snapshot.FindTable(TEXT("WorldStructure"))));
+    const double Elapsed = FPlatformTime::Seconds() - StartTime;
+    Report->SetNumberField(TEXT("scan_seconds"), Elapsed);
+
+    FString Output;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+    FJsonSerializer::Serialize(Report, Writer);
+    if (!FFileHelper::SaveStringToFile(Output, *OutPath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("WorldAnalytics: failed to write %s"), *OutPath);
+        return 1;
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("WorldAnalytics: %lld rows in %.3fs (%.0f rows/s, %d workers) -> %s"),
+        TotalRows, Elapsed, Elapsed > 0.0 ? TotalRows / Elapsed : 0.0, FTaskGraphInterface::Get().GetNumWorkerThreads(), *OutPath);
+    return 0;
+}
@@ -0,0 +1,499 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "WorldSnapshot.h"
+#include "DojoModule.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+using namespace dojo_bindings;
+
+namespace
+{
+    bool IsOwnerMember(const Member& Field)
+    {
+        if (Field.ty->tag != Primitive_) return false;
+        if (Field.ty->primitive.tag == ContractAddress) return true;
+        return Field.ty->primitive.tag == Felt252 && FCStringAnsi::Strstr(Field.name, "owner") != nullptr;
+    }
+
+    bool GetColumnType(const Member& Field, ESnapshotColumnType& OutType)
+    {
+        if (Field.ty->tag == ByteArray)
+        {
+            OutType = ESnapshotColumnType::Text;
+            return true;
+        }
+        if (Field.ty->tag != Primitive_) return false;
+        if (IsOwnerMember(Field))
+        {
+            OutType = ESnapshotColumnType::Owner;
+            return true;
+        }
+
+        switch (Field.ty->primitive.tag)
+        {
+        case U8: OutType = ESnapshotColumnType::U8; return true;
+        case U16: OutType = ESnapshotColumnType::U16; return true;
+        case U32: OutType = ESnapshotColumnType::U32; return true;
+        case U64: OutType = ESnapshotColumnType::U64; return true;
+        case I8: OutType = ESnapshotColumnType::I8; return true;
+        case I16: OutType = ESnapshotColumnType::I16; return true;
+        case I32: OutType = ESnapshotColumnType::I32; return true;
+        case I64: OutType = ESnapshotColumnType::I64; return true;
+        case Bool: OutType = ESnapshotColumnType::Bool; return true;
+        case U128: OutType = ESnapshotColumnType::U128; return true;
+        case Felt252:
+        case ClassHash:
+        case ContractAddress:
+            OutType = ESnapshotColumnType::Felt;
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    void WriteString(TArray<uint8>& Out, const FString& Value)
+    {
+        const FTCHARToUTF8 Utf8(*Value);
+        const uint16 Len = static_cast<uint16>(Utf8.Length());
+        Out.Append(reinterpret_cast<const uint8*>(&Len), sizeof(Len));
+        Out.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Len);
+    }
+
+    template<typename T>
+    void WriteValue(TArray<uint8>& Out, const T& Value)
+    {
+        Out.Append(reinterpret_cast<const uint8*>(&Value), sizeof(T));
+    }
+
+    struct FManifestReader
+    {
+        const uint8* Data;
+        int64 Size;
+        int64 Offset = 0;
+        bool bOk = true;
+
+        template<typename T>
+        T Read()
+        {
+            T Value{};
+            if (Offset + static_cast<int64>(sizeof(T)) > Size) { bOk = false; return Value; }
+            FMemory::Memcpy(&Value, Data + Offset, sizeof(T));
+            Offset += sizeof(T);
+            return Value;
+        }
+
+        FString ReadString()
+        {
+            const uint16 Len = Read<uint16>();
+            if (!bOk || Offset + Len > Size) { bOk = false; return FString(); }
+            const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Data + Offset), Len);
+            Offset += Len;
+            return FString(Converted.Length(), Converted.Get());
+        }
+    };
+}
+
+int32 FWorldSnapshotFormat::GetElementSize(ESnapshotColumnType Type)
+{
+    switch (Type)
+    {
+    case ESnapshotColumnType::U8:
+    case ESnapshotColumnType::I8:
+    case ESnapshotColumnType::Bool:
+        return 1;
+    case ESnapshotColumnType::U16:
+    case ESnapshotColumnType::I16:
+        return 2;
+    case ESnapshotColumnType::U32:
+    case ESnapshotColumnType::I32:
+    case ESnapshotColumnType::Owner:
+    case ESnapshotColumnType::Text:
+        return 4;
+    case ESnapshotColumnType::U64:
+    case ESnapshotColumnType::I64:
+        return 8;
+    case ESnapshotColumnType::U128:
+        return 16;
+    case ESnapshotColumnType::Felt:
+        return 32;
+    }
+    return 0;
+}
+
+FString FWorldSnapshotFormat::GetColumnFileName(const FString& Model, const FString& Column, bool bBlob)
+{
+    FString ShortModel;
+    if (!Model.Split(TEXT("-"), nullptr, &ShortModel))
+    {
+        ShortModel = Model;
+    }
+    return FString::Printf(TEXT("%s.%s.%s"), *ShortModel, *Column, bBlob ? TEXT("blob") : TEXT("col"));
+}
+
+FString FWorldSnapshotFormat::GetDefaultDirectory(const FString& Name)
+{
+    return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("DojoSnapshots"), Name);
+}
+
+uint32 FWorldSnapshotWriter::InternOwner(const uint8* Bytes)
+{
+    FFelt252 Owner;
+    FMemory::Memcpy(Owner.Bytes, Bytes, FFelt252::NumBytes);
+    if (const uint32* Existing = OwnerIndex.Find(Owner))
+    {
+        return *Existing;
+    }
+    const uint32 Index = Owners.Add(Owner);
+    OwnerIndex.Add(Owner, Index);
+    return Index;
+}
+
+void FWorldSnapshotWriter::PadColumn(FColumnBuffer& Column, int64 Rows)
+{
+    const int32 ElementSize = FWorldSnapshotFormat::GetElementSize(Column.Type);
+    if (Column.Type == ESnapshotColumnType::Text)
+    {
+        // Offsets column holds Rows + 1 entries; a missing string repeats the previous offset
+        const uint32 BlobEnd = static_cast<uint32>(Column.Blob.Num());
+        if (Column.Data.Num() == 0) WriteValue(Column.Data, uint32(0));
+        while (Column.Data.Num() < (Rows + 1) * ElementSize) WriteValue(Column.Data, BlobEnd);
+        return;
+    }
+    const int64 Expected = Rows * ElementSize;
+    if (Column.Data.Num() < Expected)
+    {
+        Column.Data.AddZeroed(Expected - Column.Data.Num());
+    }
+}
+
+void FWorldSnapshotWriter::AppendModel(const Struct* Model)
+{
+    if (!Model || !Model->name) return;
+
+    const FString ModelName = UTF8_TO_TCHAR(Model->name);
+    int32* ExistingTable = TableIndex.Find(ModelName);
+    const int32 TableSlot = ExistingTable ? *ExistingTable : Tables.AddDefaulted();
+    if (!ExistingTable)
+    {
+        Tables[TableSlot].Model = ModelName;
+        TableIndex.Add(ModelName, TableSlot);
+    }
+    FTableBuffer& Table = Tables[TableSlot];
+    const int64 Row = Table.Rows;
+
+    for (uintptr_t m = 0; m < Model->children.data_len; m++)
+    {
+        const Member& Field = Model->children.data[m];
+        ESnapshotColumnType Type;
+        if (!Field.ty || !GetColumnType(Field, Type)) continue;
+
+        const FString ColumnName = UTF8_TO_TCHAR(Field.name);
+        int32* ExistingColumn = Table.ColumnIndex.Find(ColumnName);
+        if (!ExistingColumn)
+        {
+            FColumnBuffer NewColumn;
+            NewColumn.Name = ColumnName;
+            NewColumn.Type = Type;
+            PadColumn(NewColumn, Row);
+            ExistingColumn = &Table.ColumnIndex.Add(ColumnName, Table.Columns.Add(MoveTemp(NewColumn)));
+        }
+        FColumnBuffer& Column = Table.Columns[*ExistingColumn];
+        if (Column.Type != Type) continue; // schema changed mid-export, keep the first type
+        PadColumn(Column, Row);
+
+        const Primitive& Value = Field.ty->primitive;
+        switch (Type)
+        {
+        case ESnapshotColumnType::U8: WriteValue(Column.Data, Value.u8); break;
+        case ESnapshotColumnType::U16: WriteValue(Column.Data, Value.u16); break;
+        case ESnapshotColumnType::U32: WriteValue(Column.Data, Value.u32); break;
+        case ESnapshotColumnType::U64: WriteValue(Column.Data, Value.u64); break;
+        case ESnapshotColumnType::I8: WriteValue(Column.Data, Value.i8); break;
+        case ESnapshotColumnType::I16: WriteValue(Column.Data, Value.i16); break;
+        case ESnapshotColumnType::I32: WriteValue(Column.Data, Value.i32); break;
+        case ESnapshotColumnType::I64: WriteValue(Column.Data, Value.i64); break;
+        case ESnapshotColumnType::Bool: WriteValue(Column.Data, static_cast<uint8>(Value.bool_ ? 1 : 0)); break;
+        case ESnapshotColumnType::U128: Column.Data.Append(Value.u128, 16); break;
+        case ESnapshotColumnType::Felt: Column.Data.Append(Value.felt252.data, 32); break;
+        case ESnapshotColumnType::Owner: WriteValue(Column.Data, InternOwner(Value.felt252.data)); break;
+        case ESnapshotColumnType::Text:
+        {
+            // PadColumn wrote this row's start offset; append the bytes and the end offset
+            if (Field.ty->byte_array)
+            {
+                Column.Blob.Append(reinterpret_cast<const uint8*>(Field.ty->byte_array), FCStringAnsi::Strlen(Field.ty->byte_array));
+            }
+            WriteValue(Column.Data, static_cast<uint32>(Column.Blob.Num()));
+            break;
+        }
+        }
+    }
+
+    Table.Rows++;
+    for (FColumnBuffer& Column : Table.Columns)
+    {
+        PadColumn(Column, Table.Rows);
+    }
+}
+
+int64 FWorldSnapshotWriter::GetNumRows() const
+{
+    int64 Rows = 0;
+    for (const FTableBuffer& Table : Tables)
+    {
+        Rows += Table.Rows;
+    }
+    return Rows;
+}
+
+bool FWorldSnapshotWriter::Write(const FString& Directory, const FString& WorldAddress) const
+{
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    PlatformFile.CreateDirectoryTree(*Directory);
+
+    TArray<uint8> Manifest;
+    WriteValue(Manifest, FWorldSnapshotFormat::MAGIC);
+    WriteValue(Manifest, FWorldSnapshotFormat::FORMAT_VERSION);
+    Manifest.Append(FFelt252::FromHex(WorldAddress).Bytes, FFelt252::NumBytes);
+    WriteValue(Manifest, FDateTime::UtcNow().ToUnixTimestamp());
+    WriteValue(Manifest, static_cast<uint32>(Owners.Num()));
+    WriteValue(Manifest, static_cast<uint32>(Tables.Num()));
+
+    for (const FTableBuffer& Table : Tables)
+    {
+        WriteString(Manifest, Table.Model);
+        WriteValue(Manifest, Table.Rows);
+        WriteValue(Manifest, static_cast<uint32>(Table.Columns.Num()));
+        for (const FColumnBuffer& Column : Table.Columns)
+        {
+            WriteString(Manifest, Column.Name);
+            WriteValue(Manifest, static_cast<uint8>(Column.Type));
+
+            const FString ColumnPath = FPaths::Combine(Directory, FWorldSnapshotFormat::GetColumnFileName(Table.Model, Column.Name));
+            if (!FFileHelper::SaveArrayToFile(Column.Data, *ColumnPath)) return false;
+            if (Column.Type == ESnapshotColumnType::Text)
+            {
+                const FString BlobPath = FPaths::Combine(Directory, FWorldSnapshotFormat::GetColumnFileName(Table.Model, Column.Name, true));
+                if (!FFileHelper::SaveArrayToFile(Column.Blob, *BlobPath)) return false;
+            }
+        }
+    }
+
+    TArray<uint8> OwnerBytes;
+    OwnerBytes.Reserve(Owners.Num() * FFelt252::NumBytes);
+    for (const FFelt252& Owner : Owners)
+    {
+        OwnerBytes.Append(Owner.Bytes, FFelt252::NumBytes);
+    }
+    if (!FFileHelper::SaveArrayToFile(OwnerBytes, *FPaths::Combine(Directory, TEXT("owners.dict")))) return false;
+
+    // Manifest last: a snapshot without one is incomplete and won't open
+    return FFileHelper::SaveArrayToFile(Manifest, *FPaths::Combine(Directory, TEXT("manifest.bin")));
+}
+
+uint64 FWorldSnapshot::FColumn::GetUInt(int64 Row) const
+{
+    switch (Type)
+    {
+    case ESnapshotColumnType::U8:
+    case ESnapshotColumnType::I8:
+    case ESnapshotColumnType::Bool:
+        return Data[Row];
+    case ESnapshotColumnType::U16:
+    case ESnapshotColumnType::I16:
+    {
+        uint16 Value;
+        FMemory::Memcpy(&Value, Data + Row * 2, 2);
+        return Value;
+    }
+    case ESnapshotColumnType::U32:
+    case ESnapshotColumnType::I32:
+    case ESnapshotColumnType::Owner:
+    {
+        uint32 Value;
+        FMemory::Memcpy(&Value, Data + Row * 4, 4);
+        return Value;
+    }
+    case ESnapshotColumnType::U64:
+    case ESnapshotColumnType::I64:
+    {
+        uint64 Value;
+        FMemory::Memcpy(&Value, Data + Row * 8, 8);
+        return Value;
+    }
+    default:
+        return 0;
+    }
+}
+
+int64 FWorldSnapshot::FColumn::GetInt(int64 Row) const
+{
+    const uint64 Value = GetUInt(Row);
+    switch (Type)
+    {
+    case ESnapshotColumnType::I8: return static_cast<int8>(Value);
+    case ESnapshotColumnType::I16: return static_cast<int16>(Value);
+    case ESnapshotColumnType::I32: return static_cast<int32>(Value);
+    default: return static_cast<int64>(Value);
+    }
+}
+
+FFelt252 FWorldSnapshot::FColumn::GetFelt(int64 Row) const
+{
+    FFelt252 Felt;
+    if (Type == ESnapshotColumnType::Felt)
+    {
+        FMemory::Memcpy(Felt.Bytes, Data + Row * 32, 32);
+    }
+    else if (Type == ESnapshotColumnType::U128)
+    {
+        FMemory::Memcpy(Felt.Bytes + 16, Data + Row * 16, 16);
+    }
+    return Felt;
+}
+
+FString FWorldSnapshot::FColumn::GetText(int64 Row) const
+{
+    if (Type != ESnapshotColumnType::Text || !Blob) return FString();
+    uint32 Begin, End;
+    FMemory::Memcpy(&Begin, Data + Row * 4, 4);
+    FMemory::Memcpy(&End, Data + (Row + 1) * 4, 4);
+    if (End < Begin || End > BlobSize) return FString();
+    const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Blob + Begin), End - Begin);
+    return FString(Converted.Length(), Converted.Get());
+}
+
+const FWorldSnapshot::FColumn* FWorldSnapshot::FTable::FindColumn(const FString& Name) const
+{
+    return Columns.FindByPredicate([&Name](const FColumn& Column) { return Column.Name == Name; });
+}
+
+FWorldSnapshot::FWorldSnapshot() = default;
+FWorldSnapshot::~FWorldSnapshot() = default;
+
+const FWorldSnapshot::FMappedFile* FWorldSnapshot::MapFile(const FString& Path)
+{
+    TUniquePtr<FMappedFile> File = MakeUnique<FMappedFile>();
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+    // Prefer mapping the file; fall back to a plain read on platforms without mapping support
+    FOpenMappedResult MappedResult = PlatformFile.OpenMappedEx(*Path);
+    if (MappedResult.HasValue())
+    {
+        File->Handle = MappedResult.StealValue();
+        if (File->Handle->GetFileSize() == 0)
+        {
+            return Files.Add_GetRef(MoveTemp(File)).Get();
+        }
+        File->Region.Reset(File->Handle->MapRegion(0, File->Handle->GetFileSize()));
+        if (File->Region)
+        {
+            File->Data = File->Region->GetMappedPtr();
+            File->Size = File->Region->GetMappedSize();
+            return Files.Add_GetRef(MoveTemp(File)).Get();
+        }
+    }
+
+    if (!FFileHelper::LoadFileToArray(File->Fallback, *Path))
+    {
+        return nullptr;
+    }
+    File->Data = File->Fallback.GetData();
+    File->Size = File->Fallback.Num();
+    return Files.Add_GetRef(MoveTemp(File)).Get();
+}
+
+bool FWorldSnapshot::Open(const FString& Directory)
+{
+    Files.Empty();
+    Tables.Empty();
+
+    TArray<uint8> ManifestBytes;
+    if (!FFileHelper::LoadFileToArray(ManifestBytes, *FPaths::Combine(Directory, TEXT("manifest.bin"))))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("WorldSnapshot: no manifest in %s"), *Directory);
+        return false;
+    }
+
+    FManifestReader Reader{ManifestBytes.GetData(), ManifestBytes.Num()};
+    const uint32 Magic = Reader.Read<uint32>();
+    const uint16 Version = Reader.Read<uint16>();
+    uint8 World[FFelt252::NumBytes];
+    for (uint8& Byte : World) Byte = Reader.Read<uint8>();
+    CreatedAt = Reader.Read<int64>();
+    NumOwners = static_cast<int32>(Reader.Read<uint32>());
+    const uint32 NumTables = Reader.Read<uint32>();
+    if (!Reader.bOk || Magic != FWorldSnapshotFormat::MAGIC || Version != FWorldSnapshotFormat::FORMAT_VERSION)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("WorldSnapshot: %s is not a snapshot (or an older format)"), *Directory);
+        return false;
+    }
+    WorldAddress = FDojoModule::bytes_to_fstring(World, FFelt252::NumBytes);
+
+    const FMappedFile* OwnersFile = MapFile(FPaths::Combine(Directory, TEXT("owners.dict")));
+    if (!OwnersFile || OwnersFile->Size < static_cast<int64>(NumOwners) * FFelt252::NumBytes) return false;
+    OwnerData = OwnersFile->Data;
+
+    for (uint32 t = 0; t < NumTables && Reader.bOk; t++)
+    {
+        FTable& Table = Tables.AddDefaulted_GetRef();
+        Table.Model = Reader.ReadString();
+        Table.Rows = Reader.Read<int64>();
+        const uint32 NumColumns = Reader.Read<uint32>();
+
+        for (uint32 c = 0; c < NumColumns && Reader.bOk; c++)
+        {
+            FColumn& Column = Table.Columns.AddDefaulted_GetRef();
+            Column.Name = Reader.ReadString();
+            Column.Type = static_cast<ESnapshotColumnType>(Reader.Read<uint8>());
+
+            const FMappedFile* ColumnFile = MapFile(FPaths::Combine(Directory, FWorldSnapshotFormat::GetColumnFileName(Table.Model, Column.Name)));
+            const int64 Rows = Column.Type == ESnapshotColumnType::Text ? Table.Rows + 1 : Table.Rows;
+            if (!ColumnFile || ColumnFile->Size < Rows * FWorldSnapshotFormat::GetElementSize(Column.Type))
+            {
+                UE_LOG(LogTemp, Warning, TEXT("WorldSnapshot: column %s.%s is missing or truncated"), *Table.Model, *Column.Name);
+                return false;
+            }
+            Column.Data = ColumnFile->Data;
+
+            if (Column.Type == ESnapshotColumnType::Text)
+            {
+                const FMappedFile* BlobFile = MapFile(FPaths::Combine(Directory, FWorldSnapshotFormat::GetColumnFileName(Table.Model, Column.Name, true)));
+                if (!BlobFile) return false;
+                Column.Blob = BlobFile->Data;
+                Column.BlobSize = BlobFile->Size;
+            }
+        }
+    }
+
+    if (!Reader.bOk)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("WorldSnapshot: manifest in %s is truncated"), *Directory);
+        return false;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("WorldSnapshot: opened %s (%d tables, %d owners)"), *Directory, Tables.Num(), NumOwners);
+    return true;
+}
+
+const FWorldSnapshot::FTable* FWorldSnapshot::FindTable(const FString& Model) const
+{
+    return Tables.FindByPredicate([&Model](const FTable& Table)
+    {
+        return Table.Model == Model || Table.Model.EndsWith(TEXT("-") + Model);
+    });
+}
+
+FFelt252 FWorldSnapshot::GetOwner(uint32 Index) const
+{
+    FFelt252 Owner;
+    if (OwnerData && Index < static_cast<uint32>(NumOwners))
+    {
+        FMemory::Memcpy(Owner.Bytes, OwnerData + static_cast<int64>(Index) * FFelt252::NumBytes, FFelt252::NumBytes);
+    }
+    return Owner;
+}
@@ -0,0 +1,82 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Felt252.h"
+#include "CraftIslandChunks.h"
+
+/**
+ * On-disk cache of one space's chunks, gatherables and structures, so the home island
+ * can be rendered at startup before Torii answers.
+ *
+ * One file per (world address, space) under Saved/DojoCache. Layout: fixed header
+ * followed by three arrays of packed fixed-size records. Files are memory-mapped on load.
+ */
+class CRAFTISLANDPOCKET3_API FChunkDiskCache
+{
+public:
+    static constexpr uint32 MAGIC = 0x43434943; // "CICC"
+    static constexpr uint16 FORMAT_VERSION = 1;
+
+#pragma pack(push, 1)
+    struct FHeader
+    {
+        uint32 Magic;
+        uint16 FormatVersion;
+        uint16 Reserved;
+        uint8 WorldAddress[32];
+        uint8 Owner[32];
+        int32 SpaceId;
+        uint32 NumChunks;
+        uint32 NumGatherables;
+        uint32 NumStructures;
+    };
+
+    struct FChunkRecord
+    {
+        uint8 ChunkId[16];
+        uint8 Version;
+        uint8 Blocks1[16];
+        uint8 Blocks2[16];
+    };
+
+    struct FGatherableRecord
+    {
+        uint8 ChunkId[16];
+        uint8 Position;
+        uint16 ResourceId;
+        int64 PlantedAt;
+        int64 NextHarvestAt;
+        int64 HarvestedAt;
+        uint8 MaxHarvest;
+        uint8 RemainedHarvest;
+        uint8 Destroyed;
+        uint8 Tier;
+    };
+
+    struct FStructureRecord
+    {
+        uint8 ChunkId[16];
+        uint8 Position;
+        uint16 StructureType;
+        uint16 BuildInventoryId;
+        uint8 Completed;
+        uint8 LinkedSpaceOwner[32];
+        uint16 LinkedSpaceId;
+        uint8 Destroyed;
+    };
+#pragma pack(pop)
+
+    static FString GetCachePath(const FString& WorldAddress, const FSpaceKey& Space);
+
+    // Writes the space to disk (temp file + move). Returns false on I/O failure.
+    static bool Save(const FString& WorldAddress, const FSpaceKey& Space, const FSpaceChunks& Data);
+
+    // Game thread: maps the file, adds chunks straight into OutSpace and rebuilds gatherable / structure
+    // model objects into OutModels. Returns false if there is no valid cache.
+    static bool Load(const FString& WorldAddress, const FSpaceKey& Space, FSpaceChunks& OutSpace, TArray<UDojoModel*>& OutModels);
+
+private:
+    static bool Decode(const uint8* Data, int64 Size, const FString& WorldAddress, const FSpaceKey& Space, FSpaceChunks& OutSpace, TArray<UDojoModel*>& OutModels);
+};
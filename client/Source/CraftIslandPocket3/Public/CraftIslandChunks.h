@@ -5,21 +5,104 @@
 #include "CoreMinimal.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "../DojoHelpers.h"
+#include "Felt252.h"
+#include "DojoDecoders.h"
 #include "CraftIslandChunks.generated.h"
 
+/**
+ * IslandChunk as kept in ChunkCache: the raw blocks1 / blocks2 u128s and the version, 33 bytes
+ * instead of a model object with four hex strings. The chunk coordinate is the FChunkKey it is stored under.
+ */
+struct FCompactChunk
+{
+    uint8 Blocks[32]; // blocks1 then blocks2, big-endian
+    uint8 Version = 0;
+
+    FCompactChunk()
+    {
+        FMemory::Memzero(Blocks, sizeof(Blocks));
+    }
+
+    static FCompactChunk FromModel(const UDojoModelCraftIslandPocketIslandChunk* Chunk);
+
+    // Cell Index as an E_Item value (see DojoDecoders::GetChunkBlock)
+    uint8 GetBlock(int32 Index) const
+    {
+        return DojoDecoders::GetChunkBlock(Blocks, Blocks + 16, Index);
+    }
+
+    bool IsEmpty() const;
+
+    bool operator==(const FCompactChunk& Other) const
+    {
+        return Version == Other.Version && FMemory::Memcmp(Blocks, Other.Blocks, sizeof(Blocks)) == 0;
+    }
+};
+
+USTRUCT(BlueprintType)
+struct FChunkCacheStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly)
+    int32 Spaces = 0;
+
+    UPROPERTY(BlueprintReadOnly)
+    int32 Chunks = 0;
+
+    UPROPERTY(BlueprintReadOnly)
+    int32 Gatherables = 0;
+
+    UPROPERTY(BlueprintReadOnly)
+    int32 Structures = 0;
+
+    // Containers plus the gatherable / structure model objects they hold
+    UPROPERTY(BlueprintReadOnly)
+    int64 Bytes = 0;
+
+    // Spaces dropped by the memory budget since the session started
+    UPROPERTY(BlueprintReadOnly)
+    int32 SpacesEvicted = 0;
+};
+
+// Cells of one chunk that hold a gatherable / structure, for per-chunk loads and removals
+struct FChunkContents
+{
+    TArray<uint8, TInlineAllocator<8>> GatherablePositions;
+    TArray<uint8, TInlineAllocator<4>> StructurePositions;
+};
+
 USTRUCT(BlueprintType)
 struct FSpaceChunks
 {
     GENERATED_BODY()
 
-    UPROPERTY(BlueprintReadWrite)
-    TMap<FString, UDojoModelCraftIslandPocketIslandChunk*> Chunks;
+    TMap<FChunkKey, FCompactChunk> Chunks;
 
     UPROPERTY(BlueprintReadWrite)
-    TMap<FString, UDojoModelCraftIslandPocketGatherableResource*> Gatherables;
+    TMap<FChunkItemKey, UDojoModelCraftIslandPocketGatherableResource*> Gatherables;
 
     UPROPERTY(BlueprintReadWrite)
-    TMap<FString, UDojoModelCraftIslandPocketWorldStructure*> Structures;
+    TMap<FChunkItemKey, UDojoModelCraftIslandPocketWorldStructure*> Structures;
+
+    // Secondary index: what each chunk holds, kept in sync by the Add / Remove functions below
+    TMap<FChunkKey, FChunkContents> ChunkContents;
+
+    void AddChunk(UDojoModelCraftIslandPocketIslandChunk* Chunk);
+    void AddChunk(const FChunkKey& Key, const FCompactChunk& Chunk) { Chunks.Add(Key, Chunk); }
+    void AddGatherable(UDojoModelCraftIslandPocketGatherableResource* Gatherable);
+    void AddStructure(UDojoModelCraftIslandPocketWorldStructure* Structure);
+
+    bool RemoveGatherable(const FChunkItemKey& Key);
+    bool RemoveStructure(const FChunkItemKey& Key);
+
+    // Drops the chunk and everything in it, O(items in the chunk)
+    void RemoveChunk(const FChunkKey& Chunk);
+
+    const FChunkContents* FindContents(const FChunkKey& Chunk) const { return ChunkContents.Find(Chunk); }
+
+    // Approximate resident size of this space in the cache
+    int64 GetAllocatedSize() const;
 };
 
 /**
@@ -33,5 +116,5 @@ class CRAFTISLANDPOCKET3_API UCraftIslandChunks : public UBlueprintFunctionLibra
 public:
 
     UFUNCTION(BlueprintCallable)
-    static void HandleCraftIslandModel(UDojoModel* model, UPARAM(ref) TMap<FString, FSpaceChunks>& RawSpaces);
+    static void HandleCraftIslandModel(UDojoModel* model, UPARAM(ref) TMap<FSpaceKey, FSpaceChunks>& RawSpaces);
 };
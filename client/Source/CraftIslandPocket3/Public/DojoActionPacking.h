@@ -0,0 +1,338 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Felt252.h"
+
+/**
+ * Felt layouts read by execute_packed_actions (contracts/src/systems/actions.cairo), declared once.
+ * Fields are written from the felt's least significant bit up, in declaration order.
+ *
+ *   Counted packs (PlaceHit, Moves, Mixed): [8 bits: pack type][4 bits: count][actions...]
+ *   Single pack:                            [8 bits: pack type = 3][8 bits: action code][fields...]
+ *
+ * Each action starts with its code, CodeBits wide: 8 in Mixed and Single packs (for Single it is the
+ * header's second byte), 1 in PlaceHit packs (0 place, 1 hit), none in Moves packs.
+ */
+namespace DojoActionPacking
+{
+    enum class EPackType : uint8
+    {
+        PlaceHit = 0,
+        Moves = 1,
+        Mixed = 2,
+        Single = 3
+    };
+
+    // Action codes dispatched on by the contract
+    enum class EActionCode : uint8
+    {
+        PlaceUse = 0,
+        Hit = 1,
+        SelectHotbar = 2,
+        Craft = 3,
+        Buy = 5,
+        Sell = 6,
+        StartProcess = 7,
+        CancelProcess = 8,
+        Visit = 9,
+        VisitNewIsland = 10,
+        GenerateIsland = 11,
+
+        // Not on chain: Moves packs hold nothing but moves
+        MoveItem = 0xFF
+    };
+
+    static constexpr int32 FELT_BITS = 252;
+    // The Stark prime is 2^251 + 17 * 2^192 + 1: a felt with nothing set from bit 251 up is always below it
+    static constexpr int32 FELT_VALUE_BITS = 251;
+    static constexpr int32 PACK_TYPE_BITS = 8;
+    static constexpr int32 COUNT_BITS = 4;
+    static constexpr int32 CODE_BITS = 8;
+    static constexpr int32 MAX_FIELDS = 6;
+
+    // Cells sit on the island layers 8192 and 8193, sent as one bit
+    static constexpr int32 BASE_Z = 8192;
+
+    struct FActionSchema
+    {
+        EActionCode Code;
+        int32 NumFields;
+        uint8 FieldBits[MAX_FIELDS];
+
+        constexpr int32 GetFieldBits() const
+        {
+            int32 Bits = 0;
+            for (int32 i = 0; i < NumFields; i++) Bits += FieldBits[i];
+            return Bits;
+        }
+    };
+
+    struct FPackSchema
+    {
+        EPackType Type;
+        int32 HeaderBits;
+        // 4-bit count for counted packs, 1 for Single
+        int32 MaxCount;
+        // Last bit an action may end at. Past FELT_VALUE_BITS only zero bits may be written (see FPackWriter::Add).
+        int32 MaxBits;
+        int32 CodeBits;
+    };
+
+    inline constexpr FPackSchema PlaceHitPack = { EPackType::PlaceHit, PACK_TYPE_BITS + COUNT_BITS, 7, FELT_VALUE_BITS, 1 };
+    inline constexpr FPackSchema MovesPack = { EPackType::Moves, PACK_TYPE_BITS + COUNT_BITS, 6, FELT_BITS, 0 };
+    inline constexpr FPackSchema MixedPack = { EPackType::Mixed, PACK_TYPE_BITS + COUNT_BITS, 15, 250, CODE_BITS };
+    inline constexpr FPackSchema SinglePack = { EPackType::Single, PACK_TYPE_BITS, 1, FELT_BITS, CODE_BITS };
+
+    // PlaceHit, after the kind bit: [14 bits: y][14 bits: x][1 bit: z]
+    inline constexpr FActionSchema PlaceHitAction = { EActionCode::PlaceUse, 3, { 14, 14, 1 } };
+
+    // Moves: [8 bits: from_inv][8 bits: from_slot][8 bits: to_inv][8 bits: to_slot][8 bits: reserved]
+    inline constexpr FActionSchema MoveAction = { EActionCode::MoveItem, 5, { 8, 8, 8, 8, 8 } };
+
+    // Mixed positions: [14 bits: y][14 bits: x][1 bit: z][3 bits: padding]
+    inline constexpr FActionSchema MixedActions[] = {
+        { EActionCode::PlaceUse, 4, { 14, 14, 1, 3 } },
+        { EActionCode::Hit, 4, { 14, 14, 1, 3 } },
+        { EActionCode::SelectHotbar, 1, { 8 } },           // slot
+        { EActionCode::Sell, 0, {} },
+        { EActionCode::CancelProcess, 0, {} },
+        { EActionCode::Visit, 1, { 16 } },                 // space id
+        { EActionCode::VisitNewIsland, 0, {} },
+    };
+
+    // Single positions: [14 bits: y][14 bits: x][1 bit: z][1 bit: reserved]
+    inline constexpr FActionSchema SingleActions[] = {
+        { EActionCode::Craft, 5, { 32, 14, 14, 1, 1 } },   // item, position
+        { EActionCode::Buy, 2, { 16, 32 } },               // item, quantity
+        { EActionCode::StartProcess, 2, { 8, 32 } },       // process type, amount
+        { EActionCode::GenerateIsland, 5, { 14, 14, 1, 1, 16 } }, // position, island id
+    };
+
+    static_assert(PlaceHitPack.HeaderBits + PlaceHitPack.MaxCount * (1 + PlaceHitAction.GetFieldBits()) <= PlaceHitPack.MaxBits,
+        "PlaceHit pack overflows its felt");
+    // A sixth move ends on bit 251 with its reserved byte, which stays zero
+    static_assert(MovesPack.HeaderBits + MovesPack.MaxCount * MoveAction.GetFieldBits() <= MovesPack.MaxBits,
+        "Moves pack overflows its felt");
+    static_assert(MixedActions[0].GetFieldBits() == 32 && SingleActions[0].GetFieldBits() == 62,
+        "Position layouts must match actions.cairo");
+
+    // Schema of an action inside Pack, nullptr if that pack can't hold it
+    inline const FActionSchema* FindActionSchema(EPackType Pack, EActionCode Code)
+    {
+        if (Pack == EPackType::PlaceHit)
+        {
+            return (Code == EActionCode::PlaceUse || Code == EActionCode::Hit) ? &PlaceHitAction : nullptr;
+        }
+        if (Pack == EPackType::Moves)
+        {
+            return Code == EActionCode::MoveItem ? &MoveAction : nullptr;
+        }
+        const TArrayView<const FActionSchema> Schemas = Pack == EPackType::Mixed
+            ? TArrayView<const FActionSchema>(MixedActions) : TArrayView<const FActionSchema>(SingleActions);
+        for (const FActionSchema& Schema : Schemas)
+        {
+            if (Schema.Code == Code) return &Schema;
+        }
+        return nullptr;
+    }
+
+    inline const FPackSchema& GetPackSchema(EPackType Pack)
+    {
+        switch (Pack)
+        {
+            case EPackType::PlaceHit: return PlaceHitPack;
+            case EPackType::Moves: return MovesPack;
+            case EPackType::Mixed: return MixedPack;
+            default: return SinglePack;
+        }
+    }
+
+    // Bits one action takes in Pack, code included
+    inline int32 GetActionBits(const FPackSchema& Pack, const FActionSchema& Action)
+    {
+        return Pack.CodeBits + Action.GetFieldBits();
+    }
+
+    /**
+     * An action as it travels in a pack: its code and field values in schema order.
+     * Positions are always { y, x, z, padding }, so the same value fits PlaceHit and Mixed packs.
+     */
+    struct FPackedAction
+    {
+        EActionCode Code = EActionCode::PlaceUse;
+        uint64 Fields[MAX_FIELDS] = {};
+
+        bool operator==(const FPackedAction& Other) const
+        {
+            return Code == Other.Code && FMemory::Memcmp(Fields, Other.Fields, sizeof(Fields)) == 0;
+        }
+    };
+
+    /** Writes fields into four 64-bit little-endian words, a whole field at a time. */
+    class FPackWriter
+    {
+    public:
+        explicit FPackWriter(const FPackSchema& InPack) : Pack(InPack)
+        {
+            Write(static_cast<uint8>(Pack.Type), PACK_TYPE_BITS);
+            BitOffset = Pack.HeaderBits;
+        }
+
+        // False (nothing written) when the pack is full, can't hold this action or the felt would reach the prime
+        bool Add(const FPackedAction& Action)
+        {
+            const FActionSchema* Schema = FindActionSchema(Pack.Type, Action.Code);
+            if (!Schema || Count >= Pack.MaxCount || BitOffset + GetActionBits(Pack, *Schema) > Pack.MaxBits)
+            {
+                return false;
+            }
+            int32 Offset = BitOffset;
+            if (!FitsBelowPrime(static_cast<uint8>(Action.Code), Offset, Pack.CodeBits))
+            {
+                return false;
+            }
+            Offset += Pack.CodeBits;
+            for (int32 i = 0; i < Schema->NumFields; i++)
+            {
+                if (!FitsBelowPrime(Action.Fields[i], Offset, Schema->FieldBits[i]))
+                {
+                    return false;
+                }
+                Offset += Schema->FieldBits[i];
+            }
+
+            Write(static_cast<uint8>(Action.Code), Pack.CodeBits);
+            for (int32 i = 0; i < Schema->NumFields; i++)
+            {
+                Write(Action.Fields[i], Schema->FieldBits[i]);
+            }
+            Count++;
+            return true;
+        }
+
+        int32 Num() const { return Count; }
+        int32 GetBitsUsed() const { return BitOffset; }
+
+        FFelt252 ToFelt() const
+        {
+            uint64 Final[4] = { Words[0], Words[1], Words[2], Words[3] };
+            if (Pack.Type != EPackType::Single)
+            {
+                Final[0] |= static_cast<uint64>(Count & 0xF) << PACK_TYPE_BITS;
+            }
+
+            // Felt bytes are big-endian: word 0 holds bytes 31..24
+            FFelt252 Felt;
+            for (int32 i = 0; i < FFelt252::NumBytes; i++)
+            {
+                Felt.Bytes[FFelt252::NumBytes - 1 - i] = static_cast<uint8>(Final[i / 8] >> ((i % 8) * 8));
+            }
+            return Felt;
+        }
+
+    private:
+        // Nothing of Value (Bits wide, written at Offset) may land on bit FELT_VALUE_BITS or above
+        static bool FitsBelowPrime(uint64 Value, int32 Offset, int32 Bits)
+        {
+            if (Bits == 0 || Offset + Bits <= FELT_VALUE_BITS) return true;
+            Value &= Bits == 64 ? ~0ULL : ((1ULL << Bits) - 1);
+            const int32 Room = FMath::Max(FELT_VALUE_BITS - Offset, 0);
+            return (Value >> Room) == 0;
+        }
+
+        void Write(uint64 Value, int32 Bits)
+        {
+            if (Bits == 0) return;
+            Value &= Bits == 64 ? ~0ULL : ((1ULL << Bits) - 1);
+            const int32 Word = BitOffset >> 6;
+            const int32 Shift = BitOffset & 63;
+            Words[Word] |= Value << Shift;
+            if (Shift + Bits > 64 && Word < 3)
+            {
+                Words[Word + 1] |= Value >> (64 - Shift);
+            }
+            BitOffset += Bits;
+        }
+
+        const FPackSchema& Pack;
+        uint64 Words[4] = {};
+        int32 BitOffset = 0;
+        int32 Count = 0;
+    };
+
+    /**
+     * Splits actions, in order, into the fewest felts any mix of packs allows, one action at a time, so a
+     * batch can stop at the felt budget while it is collected. A pack that takes [i, j) also takes every
+     * shorter prefix: each start keeps one writer per pack open until that writer refuses an action.
+     */
+    class CRAFTISLANDPOCKET3_API FPackPlanner
+    {
+    public:
+        // False (nothing added) when the actions so far would then take more than MaxFelts felts
+        bool Add(const FPackedAction& Action, int32 MaxFelts = MAX_int32);
+        // An action no pack holds: sent as an empty felt of its own, so the rest still goes out
+        void AddUnpackable();
+
+        int32 Num() const { return Felts.Num() - 1; }
+        int32 GetNumFelts() const { return Felts.Last(); }
+
+        // The felts of the plan, in order; OutBitsUsed sums the bits the writers filled
+        TArray<FFelt252> ToFelts(int32* OutBitsUsed = nullptr) const;
+
+    private:
+        struct FOpenWriter
+        {
+            int32 Start;
+            const FPackSchema* Pack;
+            FPackWriter Writer;
+        };
+
+        TArray<FPackedAction> Actions;
+        // Felts[j]: fewest felts holding the first j actions; the last of them holds [SegmentStart[j], j) as SegmentPack[j]
+        TArray<int32> Felts = { 0 };
+        TArray<int32> SegmentStart = { 0 };
+        TArray<const FPackSchema*> SegmentPack = { nullptr };
+        TArray<FOpenWriter> Open;
+    };
+
+    /** Reads a felt field by field, the same way the writer filled it. */
+    class FPackReader
+    {
+    public:
+        explicit FPackReader(const FFelt252& Felt)
+        {
+            for (int32 i = 0; i < FFelt252::NumBytes; i++)
+            {
+                Words[i / 8] |= static_cast<uint64>(Felt.Bytes[FFelt252::NumBytes - 1 - i]) << ((i % 8) * 8);
+            }
+        }
+
+        uint64 Read(int32 Bits)
+        {
+            if (Bits == 0 || BitOffset >= 256) return 0;
+            const int32 Word = BitOffset >> 6;
+            const int32 Shift = BitOffset & 63;
+            uint64 Value = Words[Word] >> Shift;
+            if (Shift + Bits > 64 && Word < 3)
+            {
+                Value |= Words[Word + 1] << (64 - Shift);
+            }
+            BitOffset += Bits;
+            return Value & (Bits == 64 ? ~0ULL : ((1ULL << Bits) - 1));
+        }
+
+        int32 GetBitOffset() const { return BitOffset; }
+
+    private:
+        uint64 Words[4] = {};
+        int32 BitOffset = 0;
+    };
+
+    /**
+     * Decodes one felt the way execute_packed_actions does. Returns false on an unknown pack type or
+     * action code (the contract then records a failed action and the rest of the felt is meaningless).
+     */
+    CRAFTISLANDPOCKET3_API bool DecodeFelt(const FFelt252& Felt, TArray<FPackedAction>& OutActions);
+}
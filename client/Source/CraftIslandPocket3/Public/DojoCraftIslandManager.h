@@ -3,7 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "Containers/Queue.h"
+#include "Containers/Deque.h"
 #include "GameFramework/Actor.h"
 #include "Blueprint/UserWidget.h"
 #include "Kismet/GameplayStatics.h"
@@ -17,6 +17,11 @@
 #include "E_Item.h"
 #include "PaperSprite.h"
 #include "CraftIslandChunks.h"
+#include "Felt252.h"
+#include "DojoActionPacking.h"
+#include "DojoModelKey.h"
+#include "DojoEntityTable.h"
+#include "ChunkDiskCache.h"
 
 #include "DojoCraftIslandManager.generated.h"
 
@@ -128,6 +133,7 @@ enum class ETransactionType : uint8
     Visit,
     VisitNewIsland,
     GenerateIsland,
+    SetName,
     Other
 };
 
@@ -162,10 +168,16 @@ struct FTransactionQueueItem
     
     UPROPERTY()
     TArray<int32> Quantities;
+
+    UPROPERTY()
+    FString StringParam;
     
     // Sequence number for tracking order (especially for hotbar selections)
     UPROPERTY()
     int32 SequenceNumber;
+
+    // World time it was queued, for the batching window
+    double QueuedAt;
     
     FTransactionQueueItem()
     {
@@ -177,6 +189,7 @@ struct FTransactionQueueItem
         IntParam3 = 0;
         IntParam4 = 0;
         SequenceNumber = 0;
+        QueuedAt = 0.0;
     }
 };
 
@@ -278,6 +291,9 @@ class CRAFTISLANDPOCKET3_API ADojoCraftIslandManager : public AActor
 {
 	GENERATED_BODY()
 
+    friend class FDojoCoalescePlaceThenShovelTest;
+    friend class FDojoModelUpdateCoalescingTest;
+
 private:
     // Constants for spawn positions
     static const FVector DEFAULT_OUTDOOR_SPAWN_POS;
@@ -360,6 +376,8 @@ protected:
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
 
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
     UFUNCTION()
     void ContinueAfterDelay();
 
@@ -369,6 +387,10 @@ protected:
     UPROPERTY()
     FAccount Account;
 
+    // Binary form of Account.Address, used for every owner/player comparison
+    UPROPERTY()
+    FFelt252 AccountAddress;
+
 public:
     // Event delegates for optimistic updates
     UPROPERTY(BlueprintAssignable, Category = "Events")
@@ -458,12 +480,37 @@ public:
     UPROPERTY(EditAnywhere, Category = "Config")
     TMap<FString, FString> ContractsAddresses;
 
+    // Bound to DojoHelpers->OnDojoModelIngested: stages the model, applied in Tick
     UFUNCTION()
     void HandleDojoModel(UDojoModel* Model);
 
+    // Applies one model to the cache and the world (the actual update handling)
+    void ApplyDojoModel(UDojoModel* Model);
+
+    // Number of updates dropped because a newer version of the same entity arrived in the same frame
+    UFUNCTION(BlueprintCallable, Category = "Dojo")
+    int64 GetCoalescedModelUpdateCount() const { return CoalescedModelUpdates; }
+
+    // Number of queued actions the pre-submit optimiser removed (collapsed, composed or cancelled)
+    UFUNCTION(BlueprintCallable, Category = "Dojo")
+    int64 GetCoalescedActionCount() const { return CoalescedActions; }
+
+    // Feeds a session log (ADojoHelpers::StartSessionRecording) into HandleDojoModel instead of Torii.
+    // Speed 1 = real time, > 1 accelerated, <= 0 as fast as IngestFrameBudgetMs allows.
+    UFUNCTION(BlueprintCallable, Category = "Dojo Debug")
+    bool StartReplay(const FString& Path, float Speed);
+
+    // Entry counts and approximate resident bytes of the chunk cache, across all spaces
+    UFUNCTION(BlueprintCallable, Category = "Dojo Debug")
+    FChunkCacheStats GetChunkCacheStats() const;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dojo")
     ADojoHelpers* DojoHelpers;
 
+    // One model object per entity; every update is merged into it in place
+    UPROPERTY(BlueprintReadOnly, Category = "Dojo")
+    UDojoEntityTable* EntityTable;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dojo")
     FString RpcUrl;
 
@@ -505,9 +552,58 @@ public:
     void ConnectGameInstanceEvents();
     int32 CurrentItemId;
 
+    // Time budget per frame for draining the Torii ingest ring
+    UPROPERTY(EditAnywhere, Category = "Dojo")
+    float IngestFrameBudgetMs = 4.0f;
+
+    // Transactions submitted but not confirmed yet; the queue keeps sending until this many are in flight
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dojo")
+    int32 MaxTransactionsInFlight = 4;
+
+    // Upper bound on how long an action may wait for others to share its transaction.
+    // The actual window adapts to input rate and confirmation latency (see GetBatchWindow).
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dojo")
+    float MaxBatchWindowSeconds = 0.5f;
+
+    // Memory budget for ChunkCache; past it the least recently visited spaces are evicted
+    // (never the home island or the current space) and refetched when visited again. <= 0 disables eviction.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dojo")
+    int64 ChunkCacheBudgetBytes = 16 * 1024 * 1024;
+
+    // Per-frame update coalescing: only the latest version of each entity is applied
+    UPROPERTY()
+    TArray<UDojoModel*> PendingModelUpdates;
+    TMap<FDojoModelKey, int32> PendingModelIndex;
+    int64 TotalModelUpdates = 0;
+    int64 CoalescedModelUpdates = 0;
+    void FlushPendingModelUpdates();
+
+    // Session replay (no Torii, no chain)
+    TUniquePtr<FDojoSessionReplay> Replay;
+    bool bReplayMode = false;
+    bool bExitWhenReplayDone = false;
+    float ReplaySpeed = 1.0f;
+    double ReplayClock = 0.0;
+    double ReplayStartWallTime = 0.0;
+    int64 ReplayedBatches = 0;
+    int64 ReplayedModels = 0;
+    void AdvanceReplay(float DeltaTime);
+
     // Chunk caching system
     UPROPERTY()
-    TMap<FString, FSpaceChunks> ChunkCache;
+    TMap<FSpaceKey, FSpaceChunks> ChunkCache;
+
+    // LRU bookkeeping for ChunkCache: last visit stamp per space, and spaces evicted since their last visit
+    TMap<FSpaceKey, uint64> SpaceVisitStamps;
+    uint64 SpaceVisitCounter = 0;
+    TSet<FSpaceKey> EvictedSpaces;
+    int32 SpacesEvicted = 0;
+    float ChunkCacheBudgetTimer = 0.0f;
+    static constexpr float CHUNK_CACHE_BUDGET_CHECK_INTERVAL = 5.0f;
+
+    void TouchSpace(const FSpaceKey& Space);
+    void EnforceChunkCacheBudget();
+    void EvictSpace(const FSpaceKey& Space);
 
     // Helper functions to reduce code duplication
     void QueueSpawnWithOverflowProtection(const FSpawnQueueData& SpawnData);
@@ -516,10 +612,23 @@ public:
     void ProcessChunkBlock(uint8 Byte, const FIntVector& DojoPosition, E_Item Item, TArray<FSpawnQueueData>& ChunkSpawnData);
     void ProcessGatherableResource(UDojoModelCraftIslandPocketGatherableResource* Gatherable);
     void ProcessWorldStructure(UDojoModelCraftIslandPocketWorldStructure* Structure);
-    void ProcessIslandChunk(UDojoModelCraftIslandPocketIslandChunk* Chunk);
+    void ProcessIslandChunk(const FSpaceKey& Space, const FChunkKey& Key, const FCompactChunk& Chunk);
 
     // Get current player's island key for chunk cache
-    FString GetCurrentIslandKey() const;
+    FSpaceKey GetCurrentIslandKey() const;
+
+    // True if the given owner/id pair is the space currently displayed
+    bool IsInCurrentSpace(const FString& Owner, int32 Id) const;
+
+    // Tell DojoHelpers which keys to refetch after a reconnect (our player + the current space)
+    void UpdateGapFillInterest();
+
+    // Persistent chunk cache (Saved/DojoCache)
+    bool RestoreSpaceFromDisk(const FSpaceKey& Space);
+    void SaveSpaceToDisk(const FSpaceKey& Space);
+
+    // Updates that matched the entity table exactly (e.g. already restored from disk), so needed no re-render
+    int32 UnchangedFromCacheCount = 0;
 
     // Load all chunks from cache
     void LoadAllChunksFromCache();
@@ -533,7 +642,7 @@ public:
 
     // Current space tracking
     UPROPERTY()
-    FString CurrentSpaceOwner;
+    FFelt252 CurrentSpaceOwner;
 
     UPROPERTY()
     int32 CurrentSpaceId;
@@ -554,7 +663,7 @@ public:
 
     // Store player positions for each space
     UPROPERTY()
-    TMap<FString, FVector> SpacePlayerPositions;
+    TMap<FSpaceKey, FVector> SpacePlayerPositions;
 
     // Current player inventory
     UPROPERTY()
@@ -616,6 +725,11 @@ public:
     FTimerHandle OptimisticCleanupTimerHandle;
     static constexpr float OPTIMISTIC_TIMEOUT_SECONDS = 30.0f; // Rollback after 30 seconds
 
+    // Each optimistic placement carries the SequenceNumber of its PlaceUse as a tag (GetPlacementTag),
+    // so the coalescer only ever cancels the actor the queued action itself spawned
+    int32 NextPlacementSequence = 1;
+    static FName GetPlacementTag(int32 Sequence) { return FName(TEXT("OptimisticPlaceUse"), Sequence); }
+
     // Optimistic inventory changes
     UPROPERTY()
     TMap<int32, int32> OptimisticInventoryChanges; // ItemId -> QuantityChange
@@ -632,46 +746,94 @@ public:
     bool bHotbarSelectionPending; // True when local selection differs from server
     static constexpr float HOTBAR_TIMEOUT_SECONDS = 2.0f; // Reset after 2 seconds
 
-    // Transaction queue for blockchain calls (thread-safe)
-    TQueue<FTransactionQueueItem> TransactionQueue;
+    // Actions waiting to be batched (thread-safe). Double-ended so a batch we decide to hold back
+    // goes back to the front in order.
+    TDeque<FTransactionQueueItem> TransactionQueue;
     mutable FCriticalSection TransactionQueueMutex; // Protect queue access
-    bool bIsProcessingTransaction;
     FTimerHandle TransactionTimeoutHandle;
-    int32 TransactionQueueCount;
     static constexpr int32 MAX_QUEUE_SIZE = 1000; // Prevent unbounded growth
 
+    // Batching window inputs, smoothed (EMA): time between queued actions and from submit to execution
+    double LastActionQueuedAt = -1.0;
+    double InputIntervalEma = 0.0;       // 0 until two actions were queued
+    double ConfirmationLatencyEma = 2.0; // seconds, a guess until the first confirmation
+    static constexpr double BATCH_EMA_WEIGHT = 0.2;
+    static constexpr double INPUT_IDLE_SECONDS = 2.0;  // longer gaps count as this: input resumed after a pause
+    static constexpr double BATCH_WINDOW_LATENCY_FRACTION = 0.25;
+    bool bFlushRequested = false;
+
+    // Pre-submit optimiser over the queued actions, see CoalescePendingActions
+    bool bPendingActionsDirty = false;
+    int64 CoalescedActions = 0;
+
+    // Batches handed to the account and not confirmed yet, oldest first (at most MaxTransactionsInFlight)
+    struct FInFlightTransaction
+    {
+        int32 Id = 0;
+        bool bSubmitted = false; // accepted by the account, Nonce and Hash are valid
+        bool bExecuted = false;  // in a block (indexed or receipt), no longer holds a pipeline slot
+        bool bConfirmed = false; // receipt says it executed, only the PackedActionsResult may still be pending
+        uint64 Nonce = 0;
+        FFelt252 Hash;
+        double SentAt = 0.0;
+        // Actions[0, NumPacked) went through execute_packed_actions (one result each), the rest as their own calls
+        TArray<FTransactionQueueItem> Actions;
+        int32 NumPacked = 0;
+    };
+    TArray<FInFlightTransaction> InFlightTransactions;
+    int32 NextTransactionId = 1;
+    static constexpr float TRANSACTION_TIMEOUT_SECONDS = 15.0f;
+
     private:
     // Transaction queue methods
     void QueueTransaction(const FTransactionQueueItem& Item);
     void ProcessNextTransaction();
-    void ProcessSingleAction(const FTransactionQueueItem& Action);
-    void OnTransactionComplete();
-    
-    // Universal action encoder functions
-    TArray<FString> EncodePackedActions(const TArray<FTransactionQueueItem>& Actions);
-    FString PackType0Actions(const TArray<FTransactionQueueItem>& Actions, int32& Index);
-    FString PackType1Actions(const TArray<FTransactionQueueItem>& Actions, int32& Index);
-    FString PackType2Actions(const TArray<FTransactionQueueItem>& Actions, int32& Index);
-    FString PackType3Action(const FTransactionQueueItem& Action);
-    bool CanBatchAction(ETransactionType Type);
-    int32 GetActionSize(ETransactionType Type);
-    
-    // Bit manipulation helpers
-    void WriteBits(TArray<uint8>& Bytes, int32& BitOffset, uint64 Value, int32 NumBits);
-    FString BytesToHexString(const TArray<uint8>& Bytes);
+    void OnTransactionSubmitted(const FDojoSubmitResult& Result, int32 TransactionId);
+    void HandleTransactionStatus(const FFelt252& TransactionHash, EDojoTransactionStatus Status);
+    void HandlePackedActionsResult(const FFelt252& TransactionHash, const TArray<bool>& Results);
+    int32 FindSubmittedTransaction(const FFelt252& TransactionHash) const;
+    // Removes the transaction; Results has one flag per action (empty: every action gets bSucceeded)
+    void FinishTransaction(int32 Index, bool bSucceeded, const TArray<bool>& Results = TArray<bool>());
+    void CheckTransactionTimeouts();
+    void RollbackTransactionActions(const TArray<FTransactionQueueItem>& Actions);
+    void RollbackTransactionAction(const FTransactionQueueItem& Action);
+    void ConfirmTransactionAction(const FTransactionQueueItem& Action);
+    // Executed transactions only wait for their results, they don't hold a pipeline slot
+    bool CanSubmitTransaction() const;
+    // Rewrites queued (not yet sent) actions into fewer with the same outcome; returns how many it removed
+    int32 CoalescePendingActions(TArray<FTransactionQueueItem>& Actions);
+    bool IsInventorySlotEmpty(int32 InventoryId, int32 Slot) const;
+    bool HitUndoesPendingPlacement(const FTransactionQueueItem& Place, const FTransactionQueueItem& Hit) const;
+    void RemovePendingInventoryMove(const FTransactionQueueItem& Move);
+
+    // Seconds the oldest pending action may wait for more, given BatchedCount already collected filling Fill
+    // of the batch's room (0 = send now)
+    double GetBatchWindow(int32 BatchedCount, double Fill) const;
+    void RecordConfirmationLatency(double SentAt);
+    
+    // Universal action encoder: the felts execute_packed_actions takes, as they are sent.
+    // Splits the actions, in order, into the fewest felts any mix of pack types allows.
+    TArray<FFelt252> EncodePackedActions(TConstArrayView<FTransactionQueueItem> Actions);
+    // Code and field values of the action as DojoActionPacking schemas lay them out; false if it can't be packed
+    static bool ToPackedAction(const FTransactionQueueItem& Action, DojoActionPacking::FPackedAction& OutAction);
+    // Selector and calldata of the action as its own call next to execute_packed_actions; false if it has none
+    static bool ToActionCall(const FTransactionQueueItem& Action, FDojoCall& OutCall);
     // Optimistic rendering methods
     void AddOptimisticPlacement(const FIntVector& Position, E_Item Item);
     void AddOptimisticRemoval(const FIntVector& Position);
     void ConfirmOptimisticAction(const FIntVector& Position);
+    // True only when the last state Torii sent for the current space has nothing of Type at Position
+    bool IsConfirmedEmpty(const FIntVector& Position, EActorSpawnType Type) const;
+    void RestoreOptimisticRemoval(AActor* Actor);
     void RollbackOptimisticAction(const FIntVector& Position);
     void ApplyPendingVisual(AActor* Actor);
     void RemovePendingVisual(AActor* Actor);
 
     // Helper methods for space transitions
-    FString MakeSpaceKey(const FString& Owner, int32 Id) const;
+    FSpaceKey MakeSpaceKey(const FFelt252& Owner, int32 Id) const;
     void SaveCurrentPlayerPosition();
     void HandleSpaceTransition(UDojoModelCraftIslandPocketPlayerData* PlayerData);
-    FVector GetSpawnPositionForSpace(const FString& SpaceKey, bool bHasBlockChunks);
+    FVector GetSpawnPositionForSpace(const FSpaceKey& SpaceKey, bool bHasBlockChunks);
     void TeleportPlayer(const FVector& NewLocation, bool bImmediate = false);
 
     // Camera utility methods
@@ -693,10 +855,11 @@ public:
     // Lazy hotbar update - queues hotbar selection if pending
     void QueuePendingHotbarSelection();
     
-    // Batch timing configuration
-    static constexpr float BATCH_WAIT_TIME = 0.5f;
-    static constexpr int32 MAX_BATCH_SIZE = 10;
-    static constexpr int32 FORCE_SEND_SIZE = 8;
+    // Felts execute_packed_actions takes in one transaction
+    static constexpr int32 MAX_PACKED_FELTS = 10;
+
+    // Calldata felts the calls besides execute_packed_actions may add to one transaction (keeps its fee bounded)
+    static constexpr int32 MAX_CALLS_CALLDATA = 64;
     
     // Timer for batching
     FTimerHandle BatchTimerHandle;
@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Bit-level decoders for packed on-chain fields, shared by the game and the offline analytics.
+ * All inputs are big-endian byte arrays, as Torii delivers felts and u128s.
+ */
+namespace DojoDecoders
+{
+    // IslandChunk: blocks1 and blocks2 are two u128s holding 64 4-bit cells
+    static constexpr int32 BLOCKS_PER_CHUNK = 64;
+
+    // Inventory: four felts of nine 28-bit slots each, packed from the LSB
+    static constexpr int32 SLOTS_PER_FELT = 9;
+    static constexpr int32 MAX_INVENTORY_SLOTS = 36;
+
+    struct FInventorySlot
+    {
+        uint16 ItemType = 0;  // bits 18-27
+        uint8 Quantity = 0;   // bits 10-17
+        uint16 Extra = 0;     // bits 0-9
+
+        bool IsEmpty() const { return ItemType == 0 || Quantity == 0; }
+    };
+
+    /**
+     * Cell Index (x = i % 4, y = i / 4 % 4, z = i / 16) of a chunk:
+     * cell 0 is the lowest nibble of blocks2, cell 63 the highest nibble of blocks1.
+     */
+    inline uint8 GetChunkBlock(const uint8* Blocks1, const uint8* Blocks2, int32 Index)
+    {
+        const int32 ByteFromEnd = Index / 2;
+        const uint8 Byte = ByteFromEnd < 16 ? Blocks2[15 - ByteFromEnd] : Blocks1[31 - ByteFromEnd];
+        return (Index & 1) ? (Byte >> 4) : (Byte & 0xF);
+    }
+
+    // Raw 28-bit slot SlotInFelt (0-8) of a 32-byte felt
+    inline uint32 GetInventorySlotBits(const uint8* FeltBytes, int32 SlotInFelt)
+    {
+        const int32 BitOffset = SlotInFelt * 28;
+        uint64 Value = 0;
+        for (int32 i = 0; i < 5; i++)
+        {
+            const int32 ByteIndex = 31 - BitOffset / 8 - i;
+            if (ByteIndex >= 0)
+            {
+                Value |= static_cast<uint64>(FeltBytes[ByteIndex]) << (i * 8);
+            }
+        }
+        return static_cast<uint32>(Value >> (BitOffset % 8)) & 0x0FFFFFFF;
+    }
+
+    inline FInventorySlot DecodeInventorySlot(const uint8* FeltBytes, int32 SlotInFelt)
+    {
+        const uint32 Bits = GetInventorySlotBits(FeltBytes, SlotInFelt);
+        FInventorySlot Slot;
+        Slot.ItemType = static_cast<uint16>((Bits >> 18) & 0x3FF);
+        Slot.Quantity = static_cast<uint8>((Bits >> 10) & 0xFF);
+        Slot.Extra = static_cast<uint16>(Bits & 0x3FF);
+        return Slot;
+    }
+}
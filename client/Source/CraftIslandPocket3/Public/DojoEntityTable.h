@@ -0,0 +1,63 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "DojoModelKey.h"
+#include "DojoEntityTable.generated.h"
+
+class UDojoModel;
+class FProperty;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnDojoEntityFieldChanged, UDojoModel*, Entity, FName, Field);
+
+/**
+ * One model object per on-chain entity. The first version of an entity becomes its canonical object;
+ * later versions are copied into it field by field, so anything holding the pointer (actors, the chunk
+ * cache, the current inventory) always sees the latest state. Game thread only.
+ */
+UCLASS()
+class CRAFTISLANDPOCKET3_API UDojoEntityTable : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    DECLARE_MULTICAST_DELEGATE_TwoParams(FOnFieldChangedNative, UDojoModel* /*Entity*/, FName /*Field*/);
+
+    /**
+     * Merges Incoming into the table and returns the canonical object for its entity.
+     * OutChangedFields lists the properties that differed (empty when nothing changed);
+     * bOutCreated is true when Incoming itself became the canonical object.
+     * Models we can't key (unknown types) are returned as-is and reported as created.
+     */
+    UDojoModel* Upsert(UDojoModel* Incoming, TArray<FName>& OutChangedFields, bool& bOutCreated);
+
+    UDojoModel* Find(const FDojoModelKey& Key) const;
+
+    void Remove(const FDojoModelKey& Key);
+    void Reset();
+
+    int32 Num() const { return Entities.Num(); }
+    int64 GetUpdatesInPlace() const { return UpdatesInPlace; }
+    int64 GetUnchangedUpdates() const { return UnchangedUpdates; }
+
+    // Fires for every changed field of every entity of ModelClass whose property is named Field
+    FOnFieldChangedNative& OnFieldChanged(UClass* ModelClass, FName Field);
+
+    // Blueprint-facing: fires once per changed field of any entity
+    UPROPERTY(BlueprintAssignable, Category = "Dojo")
+    FOnDojoEntityFieldChanged OnEntityFieldChanged;
+
+    static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
+
+private:
+    const TArray<FProperty*>& GetProperties(UClass* Class);
+
+    TMap<FDojoModelKey, UDojoModel*> Entities;
+    TMap<UClass*, TArray<FProperty*>> PropertiesByClass;
+    TMap<TPair<UClass*, FName>, FOnFieldChangedNative> FieldListeners;
+
+    int64 UpdatesInPlace = 0;
+    int64 UnchangedUpdates = 0;
+};
@@ -0,0 +1,146 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+struct FDojoIngestStats
+{
+    uint64 Pushed = 0;
+    uint64 Popped = 0;
+    uint64 Dropped = 0;
+    uint64 HighWaterMark = 0;
+    uint64 Capacity = 0;
+};
+
+/**
+ * Bounded lock-free multi-producer / single-consumer ring (Vyukov sequence-per-cell design).
+ * Torii callback threads push parsed models, the game thread pops them once per frame.
+ * Producers never wait: a push into a full ring fails at once and the caller takes the overflow path.
+ */
+template<typename T>
+class TDojoMpscRing
+{
+public:
+    explicit TDojoMpscRing(uint32 InCapacity)
+    {
+        const uint32 Capacity = FMath::RoundUpToPowerOfTwo(FMath::Max<uint32>(InCapacity, 2));
+        Mask = Capacity - 1;
+        Cells = MakeUnique<FCell[]>(Capacity);
+        for (uint32 i = 0; i < Capacity; i++)
+        {
+            Cells[i].Sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    TDojoMpscRing(const TDojoMpscRing&) = delete;
+    TDojoMpscRing& operator=(const TDojoMpscRing&) = delete;
+
+    // Any thread. Never waits; returns false, counted as dropped, when the ring is full.
+    bool Push(T Value)
+    {
+        if (TryPush(Value))
+        {
+            return true;
+        }
+        Dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Any thread. Never waits.
+    bool TryPush(T& Value)
+    {
+        uint64 Pos = EnqueuePos.load(std::memory_order_relaxed);
+        FCell* Cell;
+        for (;;)
+        {
+            Cell = &Cells[Pos & Mask];
+            const uint64 Seq = Cell->Sequence.load(std::memory_order_acquire);
+            const int64 Diff = static_cast<int64>(Seq) - static_cast<int64>(Pos);
+            if (Diff == 0)
+            {
+                if (EnqueuePos.compare_exchange_weak(Pos, Pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (Diff < 0)
+            {
+                return false; // full
+            }
+            else
+            {
+                Pos = EnqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        Cell->Value = MoveTemp(Value);
+        Cell->Sequence.store(Pos + 1, std::memory_order_release);
+
+        Pushed.fetch_add(1, std::memory_order_relaxed);
+        const uint64 Depth = Pos + 1 - DequeuePos.load(std::memory_order_relaxed);
+        uint64 PrevHigh = HighWaterMark.load(std::memory_order_relaxed);
+        while (Depth > PrevHigh && !HighWaterMark.compare_exchange_weak(PrevHigh, Depth, std::memory_order_relaxed))
+        {
+        }
+        return true;
+    }
+
+    // Consumer thread only.
+    bool Pop(T& OutValue)
+    {
+        const uint64 Pos = DequeuePos.load(std::memory_order_relaxed);
+        FCell& Cell = Cells[Pos & Mask];
+        const uint64 Seq = Cell.Sequence.load(std::memory_order_acquire);
+        if (static_cast<int64>(Seq) - static_cast<int64>(Pos + 1) < 0)
+        {
+            return false; // empty (or producer still writing this cell)
+        }
+
+        OutValue = MoveTemp(Cell.Value);
+        Cell.Sequence.store(Pos + Mask + 1, std::memory_order_release);
+        DequeuePos.store(Pos + 1, std::memory_order_relaxed);
+        Popped.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Approximate, safe from any thread
+    uint32 Num() const
+    {
+        const uint64 Enq = EnqueuePos.load(std::memory_order_relaxed);
+        const uint64 Deq = DequeuePos.load(std::memory_order_relaxed);
+        return Enq > Deq ? static_cast<uint32>(Enq - Deq) : 0;
+    }
+
+    uint32 Capacity() const { return static_cast<uint32>(Mask + 1); }
+
+    FDojoIngestStats GetStats() const
+    {
+        FDojoIngestStats Stats;
+        Stats.Pushed = Pushed.load(std::memory_order_relaxed);
+        Stats.Popped = Popped.load(std::memory_order_relaxed);
+        Stats.Dropped = Dropped.load(std::memory_order_relaxed);
+        Stats.HighWaterMark = HighWaterMark.load(std::memory_order_relaxed);
+        Stats.Capacity = Capacity();
+        return Stats;
+    }
+
+private:
+    struct FCell
+    {
+        std::atomic<uint64> Sequence;
+        T Value;
+    };
+
+    TUniquePtr<FCell[]> Cells;
+    uint64 Mask = 0;
+
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> EnqueuePos{0};
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> DequeuePos{0};
+
+    std::atomic<uint64> Pushed{0};
+    std::atomic<uint64> Popped{0};
+    std::atomic<uint64> Dropped{0};
+    std::atomic<uint64> HighWaterMark{0};
+};
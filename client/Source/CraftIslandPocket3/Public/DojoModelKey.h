@@ -0,0 +1,60 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Felt252.h"
+
+class UDojoModel;
+
+enum class EDojoModelKind : uint8
+{
+    Unknown,
+    GatherableResource,
+    Inventory,
+    IslandChunk,
+    PlayerData,
+    PlayerStats,
+    WorldStructure,
+    ProcessingLock
+};
+
+/**
+ * Identity of an on-chain entity: model kind + the model's key fields.
+ * Two updates with the same key describe successive versions of the same entity.
+ */
+struct CRAFTISLANDPOCKET3_API FDojoModelKey
+{
+    EDojoModelKind Kind = EDojoModelKind::Unknown;
+
+    // Owner / player address
+    FFelt252 Owner;
+
+    // Chunk id for chunk-scoped models, zero otherwise
+    FFelt252 Chunk;
+
+    // Space id or inventory id
+    int32 Id = 0;
+
+    // Position inside the chunk for gatherables and structures
+    int32 Position = 0;
+
+    static EDojoModelKind KindFromTypeName(const FString& DojoModelType);
+
+    // Returns false for models we can't key (unknown type)
+    static bool FromModel(const UDojoModel* Model, FDojoModelKey& OutKey);
+
+    bool operator==(const FDojoModelKey& Other) const
+    {
+        return Kind == Other.Kind && Id == Other.Id && Position == Other.Position
+            && Owner == Other.Owner && Chunk == Other.Chunk;
+    }
+
+    friend uint32 GetTypeHash(const FDojoModelKey& Key)
+    {
+        uint32 Hash = HashCombine(GetTypeHash(Key.Owner), GetTypeHash(Key.Chunk));
+        Hash = HashCombine(Hash, ::GetTypeHash(Key.Id));
+        Hash = HashCombine(Hash, ::GetTypeHash(Key.Position));
+        return HashCombine(Hash, ::GetTypeHash(static_cast<uint8>(Key.Kind)));
+    }
+};
@@ -0,0 +1,127 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include <atomic>
+
+class UDojoModel;
+class UClass;
+class FProperty;
+class IFileHandle;
+
+// Which path delivered a recorded batch
+enum class EDojoSessionLane : uint8
+{
+    Bulk = 0,
+    Player = 1,
+    Fetch = 2
+};
+
+/**
+ * Binary log of the model batches Torii delivered during a session, for offline replay.
+ *
+ * Layout: header, then a stream of records. A type record describes a model class once
+ * (class name + reflected property names/kinds); batch records carry a timestamp, the lane
+ * and the models' property values. Integers are zigzag varints, hex strings are stored as raw bytes.
+ */
+struct FDojoSessionLog
+{
+    static constexpr uint32 MAGIC = 0x4C524943; // "CIRL"
+    static constexpr uint16 FORMAT_VERSION = 1;
+
+    enum ERecordTag : uint8
+    {
+        TypeRecord = 1,
+        BatchRecord = 2
+    };
+
+    enum EValueKind : uint8
+    {
+        Int32Value = 0,
+        Int64Value = 1,
+        BoolValue = 2,
+        StringValue = 3
+    };
+
+    enum EStringEncoding : uint8
+    {
+        Utf8String = 0,
+        HexString = 1
+    };
+};
+
+/**
+ * Appends batches to a session log. Record() is safe from any thread; ADojoHelpers calls it
+ * from Torii callback threads and the fetch workers.
+ */
+class CRAFTISLANDPOCKET3_API FDojoSessionRecorder
+{
+public:
+    ~FDojoSessionRecorder();
+
+    bool Start(const FString& Path, const FString& WorldAddress, const FString& PlayerAddress);
+    void Stop();
+    bool IsRecording() const { return bRecording.load(std::memory_order_relaxed); }
+
+    void Record(EDojoSessionLane Lane, const TArray<UDojoModel*>& Models);
+
+    int64 GetBytesWritten() const { return BytesWritten; }
+    int64 GetBatchesWritten() const { return BatchesWritten; }
+
+private:
+    struct FTypeInfo
+    {
+        uint32 Index = 0;
+        TArray<FProperty*> Properties;
+        TArray<uint8> Kinds;
+    };
+
+    const FTypeInfo& FindOrWriteType(UClass* Class, TArray<uint8>& Out);
+
+    std::atomic<bool> bRecording{false};
+    FCriticalSection Mutex;
+    IFileHandle* File = nullptr;
+    double StartTime = 0.0;
+    TMap<UClass*, FTypeInfo> Types;
+    int64 BytesWritten = 0;
+    int64 BatchesWritten = 0;
+};
+
+/**
+ * Reads a session log back. Game thread only: batches are rebuilt as new model objects.
+ */
+class CRAFTISLANDPOCKET3_API FDojoSessionReplay
+{
+public:
+    bool Open(const FString& Path);
+
+    const FString& GetWorldAddress() const { return WorldAddress; }
+    const FString& GetPlayerAddress() const { return PlayerAddress; }
+
+    // Timestamp of the next batch (seconds since recording start), false at end of log
+    bool PeekTimestamp(double& OutTimestamp);
+
+    bool NextBatch(TArray<UDojoModel*>& OutModels, EDojoSessionLane& OutLane, double& OutTimestamp);
+
+    bool IsFinished();
+
+private:
+    struct FTypeInfo
+    {
+        UClass* Class = nullptr;
+        TArray<FProperty*> Properties; // nullptr where the class no longer has the property
+        TArray<uint8> Kinds;
+    };
+
+    // Consumes type records until the next batch record; false at end or on corruption
+    bool SkipToBatch();
+
+    TArray<uint8> Data;
+    int64 Offset = 0;
+    bool bCorrupt = false;
+    FString WorldAddress;
+    FString PlayerAddress;
+    TArray<FTypeInfo> Types;
+};
@@ -0,0 +1,45 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "Containers/Queue.h"
+#include "Templates/Function.h"
+#include <atomic>
+
+class FRunnableThread;
+class FEvent;
+
+/**
+ * One long-lived thread running its jobs one at a time, in the order they were enqueued.
+ * ADojoHelpers keeps a few per account (signing, receipts) instead of starting a thread per transaction.
+ * Enqueue() is safe from any thread.
+ */
+class CRAFTISLANDPOCKET3_API FDojoSubmitWorker : public FRunnable
+{
+public:
+    explicit FDojoSubmitWorker(const TCHAR* ThreadName);
+
+    // Drops the jobs not started yet and waits for the running one
+    virtual ~FDojoSubmitWorker() override;
+
+    void Enqueue(TUniqueFunction<void()>&& Job);
+
+    int32 GetPendingJobs() const { return PendingJobs.load(std::memory_order_relaxed); }
+
+    // For long jobs: true once the worker is being torn down, they should return early
+    bool IsStopping() const { return bStopping.load(std::memory_order_acquire); }
+
+    // FRunnable
+    virtual uint32 Run() override;
+    virtual void Stop() override;
+
+private:
+    TQueue<TUniqueFunction<void()>, EQueueMode::Mpsc> Jobs;
+    std::atomic<int32> PendingJobs{0};
+    std::atomic<bool> bStopping{false};
+
+    FEvent* WorkEvent = nullptr;
+    FRunnableThread* Thread = nullptr;
+};
@@ -0,0 +1,217 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Hash/CityHash.h"
+#include "Felt252.generated.h"
+
+/**
+ * 32-byte big-endian felt252 value.
+ * Torii hands us addresses and keys as hex strings with or without leading zeros,
+ * so we parse them once into a canonical binary form and compare/hash the bytes.
+ */
+USTRUCT(BlueprintType)
+struct CRAFTISLANDPOCKET3_API FFelt252
+{
+    GENERATED_BODY()
+
+    static constexpr int32 NumBytes = 32;
+
+    uint8 Bytes[NumBytes];
+
+    FFelt252()
+    {
+        FMemory::Memzero(Bytes, NumBytes);
+    }
+
+    // Parses "0x..." / "..." hex (any case, any number of leading zeros). Returns false on invalid or empty input.
+    static bool TryParseHex(const FString& Hex, FFelt252& OutFelt);
+
+    // Same as TryParseHex but returns zero on invalid input.
+    static FFelt252 FromHex(const FString& Hex);
+
+    static FFelt252 FromUint64(uint64 Value);
+
+    // Canonical representation: lowercase, "0x" prefix, no leading zeros ("0x0" for zero).
+    FString ToHex() const;
+
+    bool IsZero() const;
+
+    // A valid field element: below the Stark prime 2^251 + 17 * 2^192 + 1
+    bool IsBelowPrime() const;
+
+    // Low 64 bits, handy for small keys like chunk ids and positions
+    uint64 GetLow64() const;
+
+    bool operator==(const FFelt252& Other) const
+    {
+        return FMemory::Memcmp(Bytes, Other.Bytes, NumBytes) == 0;
+    }
+
+    bool operator!=(const FFelt252& Other) const
+    {
+        return !(*this == Other);
+    }
+
+    // Over every byte in order: an XOR of the words made permuted or repeated words collide
+    friend uint32 GetTypeHash(const FFelt252& Felt)
+    {
+        return ::GetTypeHash(CityHash64(reinterpret_cast<const char*>(Felt.Bytes), NumBytes));
+    }
+};
+
+/**
+ * Identity of a space (island or building interior): owner address + space id.
+ * Used as the ChunkCache key instead of the old Owner + FromInt(Id) string.
+ */
+USTRUCT(BlueprintType)
+struct CRAFTISLANDPOCKET3_API FSpaceKey
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    FFelt252 Owner;
+
+    UPROPERTY(BlueprintReadOnly)
+    int32 Id = 0;
+
+    FSpaceKey() {}
+    FSpaceKey(const FFelt252& InOwner, int32 InId) : Owner(InOwner), Id(InId) {}
+    FSpaceKey(const FString& InOwner, int32 InId) : Owner(FFelt252::FromHex(InOwner)), Id(InId) {}
+
+    FString ToString() const
+    {
+        return FString::Printf(TEXT("%s:%d"), *Owner.ToHex(), Id);
+    }
+
+    bool operator==(const FSpaceKey& Other) const
+    {
+        return Id == Other.Id && Owner == Other.Owner;
+    }
+
+    bool operator!=(const FSpaceKey& Other) const
+    {
+        return !(*this == Other);
+    }
+
+    friend uint32 GetTypeHash(const FSpaceKey& Key)
+    {
+        return HashCombine(GetTypeHash(Key.Owner), ::GetTypeHash(Key.Id));
+    }
+};
+
+/**
+ * u128 chunk id (x << 80 | y << 40 | z) in binary form.
+ * Replaces the hex ChunkId string as the key of per-space chunk stores.
+ */
+USTRUCT()
+struct CRAFTISLANDPOCKET3_API FChunkKey
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    uint64 High = 0;
+
+    UPROPERTY()
+    uint64 Low = 0;
+
+    FChunkKey() {}
+    FChunkKey(uint64 InHigh, uint64 InLow) : High(InHigh), Low(InLow) {}
+
+    static FChunkKey FromHex(const FString& Hex);
+    static FChunkKey FromBytes(const uint8* Bytes);
+
+    // Inverse of GetCoordinates
+    static FChunkKey FromCoordinates(const FIntVector& Coordinates);
+
+    // 16 big-endian bytes, as Torii and the disk cache store a u128
+    void ToBytes(uint8* OutBytes) const;
+
+    // Chunk coordinates relative to the 2048 origin
+    FIntVector GetCoordinates() const;
+
+    FString ToString() const
+    {
+        return FString::Printf(TEXT("0x%016llx%016llx"), High, Low);
+    }
+
+    bool operator==(const FChunkKey& Other) const
+    {
+        return High == Other.High && Low == Other.Low;
+    }
+
+    bool operator!=(const FChunkKey& Other) const
+    {
+        return !(*this == Other);
+    }
+
+    friend uint32 GetTypeHash(const FChunkKey& Key)
+    {
+        return HashCombine(::GetTypeHash(Key.High), ::GetTypeHash(Key.Low));
+    }
+};
+
+/**
+ * A cell inside a chunk: where gatherables and structures live.
+ */
+USTRUCT()
+struct CRAFTISLANDPOCKET3_API FChunkItemKey
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    FChunkKey Chunk;
+
+    UPROPERTY()
+    uint8 Position = 0;
+
+    FChunkItemKey() {}
+    FChunkItemKey(const FChunkKey& InChunk, uint8 InPosition) : Chunk(InChunk), Position(InPosition) {}
+
+    bool operator==(const FChunkItemKey& Other) const
+    {
+        return Position == Other.Position && Chunk == Other.Chunk;
+    }
+
+    friend uint32 GetTypeHash(const FChunkItemKey& Key)
+    {
+        return HashCombine(GetTypeHash(Key.Chunk), ::GetTypeHash(Key.Position));
+    }
+};
+
+template<>
+struct TStructOpsTypeTraits<FFelt252> : public TStructOpsTypeTraitsBase2<FFelt252>
+{
+    enum
+    {
+        WithIdenticalViaEquality = true,
+    };
+};
+
+template<>
+struct TStructOpsTypeTraits<FSpaceKey> : public TStructOpsTypeTraitsBase2<FSpaceKey>
+{
+    enum
+    {
+        WithIdenticalViaEquality = true,
+    };
+};
+
+template<>
+struct TStructOpsTypeTraits<FChunkKey> : public TStructOpsTypeTraitsBase2<FChunkKey>
+{
+    enum
+    {
+        WithIdenticalViaEquality = true,
+    };
+};
+
+template<>
+struct TStructOpsTypeTraits<FChunkItemKey> : public TStructOpsTypeTraitsBase2<FChunkItemKey>
+{
+    enum
+    {
+        WithIdenticalViaEquality = true,
+    };
+};
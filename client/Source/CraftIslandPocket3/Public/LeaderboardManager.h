@@ -3,6 +3,7 @@
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
 #include "Engine/World.h"
+#include "Felt252.h"
 #include "LeaderboardManager.generated.h"
 
 // Forward declarations
@@ -41,6 +42,7 @@ struct FPlayerLeaderboardData
     GENERATED_BODY()
 
     FString PlayerAddress;
+    FFelt252 PlayerId;
     FString PlayerName;
     int32 Coins = 0;
 
@@ -52,7 +54,7 @@ struct FPlayerLeaderboardData
     }
 
     FPlayerLeaderboardData(const FString& InPlayerAddress, int32 InCoins, const FString& InPlayerName = "")
-        : PlayerAddress(InPlayerAddress), PlayerName(InPlayerName), Coins(InCoins)
+        : PlayerAddress(InPlayerAddress), PlayerId(FFelt252::FromHex(InPlayerAddress)), PlayerName(InPlayerName), Coins(InCoins)
     {
     }
 };
@@ -97,6 +99,10 @@ public:
     UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Leaderboard")
     int32 GetPlayerRank(const FString& PlayerAddress) const;
 
+    // Seeds the cache from a world snapshot's PlayerData columns instead of waiting for every player to stream in
+    UFUNCTION(BlueprintCallable, Category = "Leaderboard")
+    bool BootstrapFromSnapshot(const FString& SnapshotDirectory);
+
     // Test function to add sample data for debugging
     UFUNCTION(BlueprintCallable, Category = "Leaderboard")
     void AddTestData();
@@ -0,0 +1,26 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "WorldAnalyticsCommandlet.generated.h"
+
+/**
+ * Headless economy and world report over a world snapshot (see WorldSnapshot.h):
+ * coin distribution, item supply per E_Item, active islands, crop readiness and structure completion.
+ *
+ *   UnrealEditor-Cmd CraftIslandPocket3 -run=WorldAnalytics -Snapshot=<dir> [-Out=<report.json>] [-Now=<unix>] [-ActiveDays=7]
+ *
+ * Every table is scanned in fixed-size row blocks with ParallelFor, so run time scales with rows / cores.
+ */
+UCLASS()
+class CRAFTISLANDPOCKET3_API UWorldAnalyticsCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UWorldAnalyticsCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
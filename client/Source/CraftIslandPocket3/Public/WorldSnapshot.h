@@ -0,0 +1,154 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Felt252.h"
+
+namespace dojo_bindings { struct Struct; }
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+enum class ESnapshotColumnType : uint8
+{
+    U8, U16, U32, U64,
+    I8, I16, I32, I64,
+    Bool,
+    U128,   // 16 bytes, big-endian
+    Felt,   // 32 bytes, big-endian
+    Owner,  // uint32 index into owners.dict
+    Text    // uint32 offsets (rows + 1) into <column>.blob
+};
+
+/**
+ * Columnar snapshot of a whole world, one directory per snapshot:
+ *   manifest.bin                 tables, row counts, column names and types
+ *   owners.dict                  32-byte addresses, referenced by Owner columns
+ *   <Model>.<member>.col         one fixed-width value per row
+ *   <Model>.<member>.blob        string bytes for Text columns
+ *
+ * Columns are built straight from Torii's member list, so new model fields show up without code changes.
+ * Addresses (ContractAddress members and *_owner felts) are dictionary-encoded.
+ */
+struct FWorldSnapshotFormat
+{
+    static constexpr uint32 MAGIC = 0x53574943; // "CIWS"
+    static constexpr uint16 FORMAT_VERSION = 1;
+
+    static int32 GetElementSize(ESnapshotColumnType Type);
+    static FString GetColumnFileName(const FString& Model, const FString& Column, bool bBlob = false);
+
+    // Saved/DojoSnapshots/<Name>
+    static FString GetDefaultDirectory(const FString& Name);
+};
+
+/**
+ * Accumulates Torii models into columns. Single-threaded: the exporter feeds it from one worker.
+ */
+class CRAFTISLANDPOCKET3_API FWorldSnapshotWriter
+{
+public:
+    void AppendModel(const dojo_bindings::Struct* Model);
+
+    bool Write(const FString& Directory, const FString& WorldAddress) const;
+
+    int64 GetNumRows() const;
+
+private:
+    struct FColumnBuffer
+    {
+        FString Name;
+        ESnapshotColumnType Type;
+        TArray<uint8> Data;
+        TArray<uint8> Blob;
+    };
+
+    struct FTableBuffer
+    {
+        FString Model;
+        int64 Rows = 0;
+        TArray<FColumnBuffer> Columns;
+        TMap<FString, int32> ColumnIndex;
+    };
+
+    uint32 InternOwner(const uint8* Bytes);
+
+    // Keeps every column exactly Rows long when a member is missing from some rows
+    static void PadColumn(FColumnBuffer& Column, int64 Rows);
+
+    TArray<FTableBuffer> Tables;
+    TMap<FString, int32> TableIndex;
+    TArray<FFelt252> Owners;
+    TMap<FFelt252, uint32> OwnerIndex;
+};
+
+/**
+ * Read-only, memory-mapped view of a snapshot. Any thread once opened.
+ */
+class CRAFTISLANDPOCKET3_API FWorldSnapshot
+{
+public:
+    struct FColumn
+    {
+        FString Name;
+        ESnapshotColumnType Type = ESnapshotColumnType::U8;
+        const uint8* Data = nullptr;
+        const uint8* Blob = nullptr;
+        int64 BlobSize = 0;
+
+        // Integer / bool / owner-index columns
+        uint64 GetUInt(int64 Row) const;
+        int64 GetInt(int64 Row) const;
+        bool GetBool(int64 Row) const { return GetUInt(Row) != 0; }
+
+        // Felt and U128 columns (U128 is widened)
+        FFelt252 GetFelt(int64 Row) const;
+
+        FString GetText(int64 Row) const;
+    };
+
+    struct FTable
+    {
+        FString Model;
+        int64 Rows = 0;
+        TArray<FColumn> Columns;
+
+        const FColumn* FindColumn(const FString& Name) const;
+    };
+
+    FWorldSnapshot();
+    ~FWorldSnapshot();
+
+    bool Open(const FString& Directory);
+
+    // Accepts "craft_island_pocket-IslandChunk" or just "IslandChunk"
+    const FTable* FindTable(const FString& Model) const;
+    const TArray<FTable>& GetTables() const { return Tables; }
+
+    int32 GetNumOwners() const { return NumOwners; }
+    FFelt252 GetOwner(uint32 Index) const;
+
+    const FString& GetWorldAddress() const { return WorldAddress; }
+
+    // Unix time the exporter wrote the snapshot
+    int64 GetCreatedAt() const { return CreatedAt; }
+
+private:
+    struct FMappedFile
+    {
+        TUniquePtr<IMappedFileHandle> Handle;
+        TUniquePtr<IMappedFileRegion> Region;
+        TArray<uint8> Fallback;
+        const uint8* Data = nullptr;
+        int64 Size = 0;
+    };
+
+    const FMappedFile* MapFile(const FString& Path);
+
+    TArray<TUniquePtr<FMappedFile>> Files;
+    TArray<FTable> Tables;
+    const uint8* OwnerData = nullptr;
+    int32 NumOwners = 0;
+    FString WorldAddress;
+    int64 CreatedAt = 0;
+};
@@ -27,3 +27,15 @@ pub struct PlayerStats {
     pub lumberjack_xp: u32,
     pub farmer_xp: u32,
 }
+
+// Outcome of each action of one execute_packed_actions call, in packing order.
+// Keyed by the transaction hash so the client can match it to the batch it sent.
+#[derive(Drop, Serde)]
+#[dojo::event]
+pub struct PackedActionsResult {
+    #[key]
+    pub player: ContractAddress,
+    #[key]
+    pub transaction_hash: felt252,
+    pub results: Array<bool>,
+}
@@ -25,7 +25,7 @@ mod actions {
     use super::{IActions};
     use starknet::{get_caller_address, ContractAddress};
     use craft_island_pocket::models::common::{
-        PlayerData
+        PlayerData, PackedActionsResult
     };
     use craft_island_pocket::models::gatherableresource::{
         GatherableResource, GatherableResourceImpl, GatherableResourceTrait
@@ -53,6 +53,7 @@ mod actions {
     };
 
     use dojo::model::{ModelStorage};
+    use dojo::event::EventStorage;
 
     // Import our action modules
     use craft_island_pocket::systems::{
@@ -547,6 +548,9 @@ mod actions {
                 felt_idx += 1;
             };
 
+            // Return values aren't part of the receipt: publish them for the client
+            let transaction_hash = starknet::get_tx_info().unbox().transaction_hash;
+            world.emit_event(@PackedActionsResult { player, transaction_hash, results: results.clone() });
 
             results
         }
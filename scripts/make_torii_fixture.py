@@ -0,0 +1,152 @@
+# USAGE
+# python ./scripts/make_torii_fixture.py --player 0x1234 --chunks 64 --out fixture.json
+#
+# Then connect the client to the in-process Torii stand-in instead of a live Torii:
+#   standin:///abs/path/fixture.json?entities=50000&rate=500&batch=16&latency_ms=30&jitter_ms=10
+
+#!/usr/bin/env python3
+import argparse
+import json
+import random
+
+NS = "craft_island_pocket"
+
+MODELS = {
+    "PlayerData": [
+        ("player", "ContractAddress", True),
+        ("last_inventory_created_id", "u16", False),
+        ("last_space_created_id", "u16", False),
+        ("current_space_owner", "felt252", False),
+        ("current_space_id", "u16", False),
+        ("coins", "u32", False),
+        ("random_nonce", "u32", False),
+        ("name", "ByteArray", False),
+    ],
+    "PlayerStats": [
+        ("player", "ContractAddress", True),
+        ("miner_level", "u8", False),
+        ("lumberjack_level", "u8", False),
+        ("farmer_level", "u8", False),
+        ("miner_xp", "u32", False),
+        ("lumberjack_xp", "u32", False),
+        ("farmer_xp", "u32", False),
+    ],
+    "Inventory": [
+        ("owner", "ContractAddress", True),
+        ("id", "u16", True),
+        ("inventory_type", "u8", False),
+        ("inventory_size", "u8", False),
+        ("slots1", "felt252", False),
+        ("slots2", "felt252", False),
+        ("slots3", "felt252", False),
+        ("slots4", "felt252", False),
+        ("hotbar_selected_slot", "u8", False),
+        ("readonly", "bool", False),
+    ],
+    "ProcessingLock": [
+        ("player", "ContractAddress", True),
+        ("unlock_time", "u64", False),
+        ("process_type", "u8", False),
+        ("batches_processed", "u32", False),
+    ],
+    "IslandChunk": [
+        ("island_owner", "felt252", True),
+        ("island_id", "u16", True),
+        ("chunk_id", "u128", True),
+        ("version", "u8", False),
+        ("blocks1", "u128", False),
+        ("blocks2", "u128", False),
+    ],
+    "GatherableResource": [
+        ("island_owner", "felt252", True),
+        ("island_id", "u16", True),
+        ("chunk_id", "u128", True),
+        ("position", "u8", True),
+        ("resource_id", "u16", False),
+        ("planted_at", "u64", False),
+        ("next_harvest_at", "u64", False),
+        ("harvested_at", "u64", False),
+        ("max_harvest", "u8", False),
+        ("remained_harvest", "u8", False),
+        ("destroyed", "bool", False),
+        ("tier", "u8", False),
+    ],
+    "WorldStructure": [
+        ("island_owner", "felt252", True),
+        ("island_id", "u16", True),
+        ("chunk_id", "u128", True),
+        ("position", "u8", True),
+        ("structure_type", "u16", False),
+        ("build_inventory_id", "u16", False),
+        ("completed", "bool", False),
+        ("linked_space_owner", "felt252", False),
+        ("linked_space_id", "u16", False),
+        ("destroyed", "bool", False),
+    ],
+}
+
+
+def chunk_id(x, y, z):
+    """Same layout as get_position_id in contracts/src/helpers/utils.cairo, 2048 = origin."""
+    return hex(((2048 + x) << 80) | ((2048 + y) << 40) | (2048 + z))
+
+
+def random_blocks(rng):
+    """16 nibbles per u128, mostly dirt/grass (1, 2) with some empty cells."""
+    value = 0
+    for _ in range(32):
+        value = (value << 4) | rng.choice([0, 1, 1, 2, 2, 2])
+    return hex(value)
+
+
+def entity(model, **values):
+    return {"model": f"{NS}-{model}", "values": values}
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate a fixture for the in-process Torii stand-in")
+    parser.add_argument("--player", default="0x1234", help="player address (ContractAddress)")
+    parser.add_argument("--chunks", type=int, default=16, help="island chunks for the player's home island")
+    parser.add_argument("--gatherables", type=int, default=4, help="gatherables per chunk")
+    parser.add_argument("--seed", type=int, default=1)
+    parser.add_argument("--out", default="torii_fixture.json")
+    args = parser.parse_args()
+
+    rng = random.Random(args.seed)
+    player = args.player
+
+    entities = [
+        entity("PlayerData", player=player, last_inventory_created_id=1, last_space_created_id=1,
+               current_space_owner=player, current_space_id=1, coins=100, random_nonce=0, name="standin"),
+        entity("PlayerStats", player=player, miner_level=1, lumberjack_level=1, farmer_level=1,
+               miner_xp=0, lumberjack_xp=0, farmer_xp=0),
+        entity("Inventory", owner=player, id=0, inventory_type=0, inventory_size=9, slots1="0x0",
+               slots2="0x0", slots3="0x0", slots4="0x0", hotbar_selected_slot=0, readonly=False),
+        entity("Inventory", owner=player, id=1, inventory_type=1, inventory_size=27, slots1="0x0",
+               slots2="0x0", slots3="0x0", slots4="0x0", hotbar_selected_slot=0, readonly=False),
+        entity("ProcessingLock", player=player, unlock_time=0, process_type=0, batches_processed=0),
+    ]
+
+    side = max(1, int(args.chunks ** 0.5))
+    for i in range(args.chunks):
+        cid = chunk_id(i % side, i // side, 0)
+        entities.append(entity("IslandChunk", island_owner=player, island_id=1, chunk_id=cid, version=0,
+                               blocks1=random_blocks(rng), blocks2=random_blocks(rng)))
+        for position in rng.sample(range(64), min(args.gatherables, 64)):
+            entities.append(entity("GatherableResource", island_owner=player, island_id=1, chunk_id=cid,
+                                   position=position, resource_id=rng.choice([47, 49, 50]), planted_at=0,
+                                   next_harvest_at=0, harvested_at=0, max_harvest=3, remained_harvest=3,
+                                   destroyed=False, tier=1))
+
+    fixture = {
+        "models": {f"{NS}-{name}": [{"name": n, "type": t, "key": k} for n, t, k in members]
+                   for name, members in MODELS.items()},
+        "entities": entities,
+    }
+    with open(args.out, "w") as f:
+        json.dump(fixture, f, indent=1)
+    print(f"Wrote {len(entities)} entities to {args.out}")
+
+
+if __name__ == "__main__":
+    main()